@@ -1,22 +1,24 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/test/tools/detail/print_helper.hpp>
-#include "hash_table.hpp"
+#include <memory>
+#include <string>
+#include <hash_table/hash_table.hpp>
 
 namespace boost::test_tools::tt_detail
 {
   template< class Key, class Value, class Hash, class Equal >
-  struct print_log_value< abramov::Iterator< Key, Value, Hash, Equal  > >
+  struct print_log_value< abramov::HashIterator< Key, Value, Hash, Equal  > >
   {
-    void operator()(std::ostream &os, const abramov::Iterator< Key, Value, Hash, Equal > &iter)
+    void operator()(std::ostream &os, const abramov::HashIterator< Key, Value, Hash, Equal > &iter)
     {
       os << "iter";
     }
   };
 
   template< class Key, class Value, class Hash, class Equal >
-  struct print_log_value< abramov::ConstIterator< Key, Value, Hash, Equal > >
+  struct print_log_value< abramov::ConstHashIterator< Key, Value, Hash, Equal > >
   {
-    void operator()(std::ostream &os, const abramov::ConstIterator< Key, Value, Hash, Equal > &iter)
+    void operator()(std::ostream &os, const abramov::ConstHashIterator< Key, Value, Hash, Equal > &iter)
     {
       os << "cIter";
     }
@@ -117,3 +119,134 @@ BOOST_AUTO_TEST_CASE(empty)
   table.insert(8, "b");
   BOOST_TEST(!table.empty());
 }
+
+namespace
+{
+  struct Counted
+  {
+    static int alive;
+    int value;
+
+    Counted():
+      Counted(0)
+    {}
+    Counted(int v):
+      value(v)
+    {
+      ++alive;
+    }
+    Counted(const Counted &other):
+      value(other.value)
+    {
+      ++alive;
+    }
+    ~Counted()
+    {
+      --alive;
+    }
+    Counted &operator=(const Counted &other) = default;
+  };
+
+  int Counted::alive = 0;
+}
+
+BOOST_AUTO_TEST_CASE(rehash_keeps_nodes)
+{
+  abramov::HashTable< int, std::string > table;
+  for (int i = 0; i < 100; ++i)
+  {
+    table.insert(i, std::to_string(i));
+  }
+  auto it = table.find(42);
+  std::string *value = std::addressof(it->second);
+  table.rehash(1009);
+  BOOST_TEST(it->second == "42");
+  BOOST_TEST(std::addressof(table.find(42)->second) == value);
+  size_t count = 0;
+  for (auto curr = table.begin(); curr != table.end(); ++curr)
+  {
+    BOOST_TEST(curr->second == std::to_string(curr->first));
+    ++count;
+  }
+  BOOST_TEST(count == 100);
+}
+
+BOOST_AUTO_TEST_CASE(erase_reuses_pooled_node)
+{
+  abramov::HashTable< int, std::string > table;
+  table.insert(1, "a");
+  table.insert(2, "b");
+  std::string *erased = std::addressof(table.find(1)->second);
+  BOOST_TEST(table.erase(1) == 1);
+  table.insert(3, "c");
+  BOOST_TEST(std::addressof(table.find(3)->second) == erased);
+  BOOST_TEST(table.find(3)->second == "c");
+  BOOST_TEST(table.find(2)->second == "b");
+  BOOST_TEST((table.find(1) == table.end()));
+  BOOST_TEST(table.size() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(copy_pooled_table)
+{
+  abramov::HashTable< int, std::string > table;
+  for (int i = 0; i < 50; ++i)
+  {
+    table.insert(i, std::to_string(i));
+  }
+  table.erase(10);
+  abramov::HashTable< int, std::string > copy(table);
+  BOOST_TEST(copy.size() == 49);
+  BOOST_TEST(std::addressof(copy.find(20)->second) != std::addressof(table.find(20)->second));
+  copy[20] = "changed";
+  copy.insert(10, "ten");
+  BOOST_TEST(table.find(20)->second == "20");
+  BOOST_TEST((table.find(10) == table.end()));
+  abramov::HashTable< int, std::string > assigned;
+  assigned.insert(100, "x");
+  assigned = copy;
+  BOOST_TEST(assigned.size() == 50);
+  BOOST_TEST(assigned.find(20)->second == "changed");
+  BOOST_TEST((assigned.find(100) == assigned.end()));
+}
+
+BOOST_AUTO_TEST_CASE(move_pooled_table)
+{
+  abramov::HashTable< int, std::string > table;
+  for (int i = 0; i < 50; ++i)
+  {
+    table.insert(i, std::to_string(i));
+  }
+  std::string *value = std::addressof(table.find(7)->second);
+  abramov::HashTable< int, std::string > moved(std::move(table));
+  BOOST_TEST(moved.size() == 50);
+  BOOST_TEST(std::addressof(moved.find(7)->second) == value);
+  BOOST_TEST(table.empty());
+  table.insert(1, "one");
+  BOOST_TEST(table.find(1)->second == "one");
+  abramov::HashTable< int, std::string > assigned;
+  assigned = std::move(moved);
+  BOOST_TEST(assigned.size() == 50);
+  BOOST_TEST(std::addressof(assigned.find(7)->second) == value);
+}
+
+BOOST_AUTO_TEST_CASE(pooled_nodes_destroyed)
+{
+  {
+    abramov::HashTable< int, Counted > table;
+    for (int i = 0; i < 200; ++i)
+    {
+      table.insert(i, Counted(i));
+    }
+    for (int i = 0; i < 200; i += 2)
+    {
+      table.erase(i);
+    }
+    BOOST_TEST(Counted::alive == 100);
+    abramov::HashTable< int, Counted > copy(table);
+    abramov::HashTable< int, Counted > moved(std::move(copy));
+    BOOST_TEST(Counted::alive == 200);
+    table.rehash(401);
+    BOOST_TEST(Counted::alive == 200);
+  }
+  BOOST_TEST(Counted::alive == 0);
+}
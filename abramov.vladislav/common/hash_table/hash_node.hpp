@@ -1,5 +1,6 @@
 #ifndef HASH_NODE_HPP
 #define HASH_NODE_HPP
+#include <cstddef>
 #include <utility>
 
 namespace abramov
@@ -9,16 +10,18 @@ namespace abramov
   {
     std::pair< Key, Value > data_;
     HashNode< Key, Value > *next_;
+    size_t hash_;
     bool active_;
 
-    HashNode(const Key &k, const Value &v);
+    HashNode(const Key &k, const Value &v, size_t h);
   };
 }
 
 template< class Key, class Value >
-abramov::HashNode< Key, Value >::HashNode(const Key &k, const Value &v):
+abramov::HashNode< Key, Value >::HashNode(const Key &k, const Value &v, size_t h):
   data_(std::make_pair(k, v)),
   next_(nullptr),
+  hash_(h),
   active_(true)
 {}
 #endif
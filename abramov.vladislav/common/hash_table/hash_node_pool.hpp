@@ -0,0 +1,117 @@
+#ifndef HASH_NODE_POOL_HPP
+#define HASH_NODE_POOL_HPP
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "hash_node.hpp"
+
+namespace abramov
+{
+  template< class Key, class Value >
+  struct HashNodePool
+  {
+    HashNodePool();
+    HashNodePool(const HashNodePool< Key, Value > &other) = delete;
+    ~HashNodePool();
+    HashNodePool< Key, Value > &operator=(const HashNodePool< Key, Value > &other) = delete;
+    HashNode< Key, Value > *create(const Key &k, const Value &v, size_t h);
+    void destroy(HashNode< Key, Value > *node) noexcept;
+    void swap(HashNodePool< Key, Value > &other) noexcept;
+
+  private:
+    union Slot
+    {
+      Slot *next_;
+      alignas(HashNode< Key, Value >) unsigned char node_[sizeof(HashNode< Key, Value >)];
+    };
+
+    static constexpr size_t min_slab_ = 16;
+    static constexpr size_t max_slab_ = 4096;
+
+    Slot *slabs_;
+    size_t slab_size_;
+    size_t used_;
+    Slot *free_;
+
+    Slot *allocate();
+  };
+}
+
+template< class Key, class Value >
+abramov::HashNodePool< Key, Value >::HashNodePool():
+  slabs_(nullptr),
+  slab_size_(0),
+  used_(0),
+  free_(nullptr)
+{}
+
+template< class Key, class Value >
+abramov::HashNodePool< Key, Value >::~HashNodePool()
+{
+  while (slabs_)
+  {
+    Slot *next = slabs_->next_;
+    delete[] slabs_;
+    slabs_ = next;
+  }
+}
+
+template< class Key, class Value >
+abramov::HashNode< Key, Value > *abramov::HashNodePool< Key, Value >::create(const Key &k, const Value &v, size_t h)
+{
+  Slot *slot = allocate();
+  try
+  {
+    return new (slot->node_) HashNode< Key, Value >(k, v, h);
+  }
+  catch (...)
+  {
+    slot->next_ = free_;
+    free_ = slot;
+    throw;
+  }
+}
+
+template< class Key, class Value >
+void abramov::HashNodePool< Key, Value >::destroy(HashNode< Key, Value > *node) noexcept
+{
+  node->~HashNode();
+  Slot *slot = reinterpret_cast< Slot * >(node);
+  slot->next_ = free_;
+  free_ = slot;
+}
+
+template< class Key, class Value >
+void abramov::HashNodePool< Key, Value >::swap(HashNodePool< Key, Value > &other) noexcept
+{
+  std::swap(slabs_, other.slabs_);
+  std::swap(slab_size_, other.slab_size_);
+  std::swap(used_, other.used_);
+  std::swap(free_, other.free_);
+}
+
+template< class Key, class Value >
+typename abramov::HashNodePool< Key, Value >::Slot *abramov::HashNodePool< Key, Value >::allocate()
+{
+  if (free_)
+  {
+    Slot *slot = free_;
+    free_ = free_->next_;
+    return slot;
+  }
+  if (!slabs_ || used_ == slab_size_)
+  {
+    size_t size = slabs_ ? slab_size_ * 2 : min_slab_;
+    if (size > max_slab_)
+    {
+      size = max_slab_;
+    }
+    Slot *slab = new Slot[size];
+    slab[0].next_ = slabs_;
+    slabs_ = slab;
+    slab_size_ = size;
+    used_ = 1;
+  }
+  return slabs_ + used_++;
+}
+#endif
@@ -6,6 +6,7 @@
 #include <functional>
 #include "decls.hpp"
 #include "hash_node.hpp"
+#include "hash_node_pool.hpp"
 #include "hash_iterator.hpp"
 #include "hash_cIterator.hpp"
 
@@ -21,8 +22,10 @@ namespace abramov
 
     HashTable();
     HashTable(const HashTable< Key, Value, Hash, Equal > &other);
+    HashTable(HashTable< Key, Value, Hash, Equal > &&other);
     ~HashTable();
     HashTable< Key, Value, Hash, Equal > &operator=(const HashTable< Key, Value, Hash, Equal > &other);
+    HashTable< Key, Value, Hash, Equal > &operator=(HashTable< Key, Value, Hash, Equal > &&other) noexcept;
     void insert(const Key &k, const Value &v);
     double loadFactor() const noexcept;
     void rehash(size_t k);
@@ -44,13 +47,16 @@ namespace abramov
     size_t size_;
     Hash hash_;
     Equal equal_;
+    HashNodePool< Key, Value > pool_;
     friend struct HashIterator< Key, Value, Hash, Equal >;
     friend struct ConstHashIterator< Key, Value, Hash, Equal >;
 
     void initTable();
     void resizeIfNeed();
     void swap(HashTable< Key, Value, Hash, Equal > &other) noexcept;
-    size_t findInsertPosition(const Key &k) const;
+    void link(HashNode< Key, Value > *node);
+    void clearNodes() noexcept;
+    size_t findInsertPosition(const Key &k, size_t h) const;
     bool isPrime(size_t k) const noexcept;
     size_t getLargerPrimeCapacity(size_t k) const noexcept;
   };
@@ -83,18 +89,36 @@ abramov::HashTable< Key, Value, Hash, Equal >::HashTable(cHash &other):
   capacity_(other.capacity_),
   size_(0),
   hash_(other.hash_),
-  equal_(other.equal_)
+  equal_(other.equal_),
+  pool_()
 {
   initTable();
-  for (size_t i = 0; i < other.capacity_; ++i)
+  try
   {
-    HashNode< Key, Value > *curr = other.table_[i];
-    while (curr)
+    for (size_t i = 0; i < other.capacity_; ++i)
     {
-      insert(curr->data_.first, curr->data_.second);
-      curr = curr->next_;
+      HashNode< Key, Value > *curr = other.table_[i];
+      while (curr)
+      {
+        link(pool_.create(curr->data_.first, curr->data_.second, curr->hash_));
+        ++size_;
+        curr = curr->next_;
+      }
     }
   }
+  catch (...)
+  {
+    clearNodes();
+    delete[] table_;
+    throw;
+  }
+}
+
+template< class Key, class Value, class Hash, class Equal >
+abramov::HashTable< Key, Value, Hash, Equal >::HashTable(Hash_t &&other):
+  HashTable()
+{
+  swap(other);
 }
 
 template< class Key, class Value, class Hash, class Equal >
@@ -105,6 +129,7 @@ void abramov::HashTable< Key, Value, Hash, Equal >::swap(Hash_t &other) noexcept
   std::swap(size_, other.size_);
   std::swap(hash_, other.hash_);
   std::swap(equal_, other.equal_);
+  pool_.swap(other.pool_);
 }
 
 template< class Key, class Value, class Hash, class Equal >
@@ -119,8 +144,26 @@ abramov::HashTable< Key, Value, Hash, Equal >::operator=(cHash &other)
   return *this;
 }
 
+template< class Key, class Value, class Hash, class Equal >
+typename abramov::HashTable< Key, Value, Hash, Equal >::Hash_t&
+abramov::HashTable< Key, Value, Hash, Equal >::operator=(Hash_t &&other) noexcept
+{
+  if (this != std::addressof(other))
+  {
+    swap(other);
+  }
+  return *this;
+}
+
 template< class Key, class Value, class Hash, class Equal >
 abramov::HashTable< Key, Value, Hash, Equal >::~HashTable()
+{
+  clearNodes();
+  delete[] table_;
+}
+
+template< class Key, class Value, class Hash, class Equal >
+void abramov::HashTable< Key, Value, Hash, Equal >::clearNodes() noexcept
 {
   for (size_t i = 0; i < capacity_; ++i)
   {
@@ -128,31 +171,38 @@ abramov::HashTable< Key, Value, Hash, Equal >::~HashTable()
     while (curr)
     {
       HashNode< Key, Value > *next = curr->next_;
-      delete curr;
+      pool_.destroy(curr);
       curr = next;
     }
+    table_[i] = nullptr;
   }
-  delete[] table_;
 }
 
 template< class Key, class Value, class Hash, class Equal >
 void abramov::HashTable< Key, Value, Hash, Equal >::insert(const Key &k, const Value &v)
 {
   resizeIfNeed();
-  size_t pos = findInsertPosition(k);
-  if (!table_[pos])
+  HashNode< Key, Value > *new_node = pool_.create(k, v, hash_(k));
+  try
   {
-    table_[pos] = new HashNode< Key, Value >(k, v);
+    link(new_node);
   }
-  else
+  catch (...)
   {
-    HashNode< Key, Value > *new_node = new HashNode< Key, Value >(k, v);
-    new_node->next_ = table_[pos];
-    table_[pos] = new_node;
+    pool_.destroy(new_node);
+    throw;
   }
   ++size_;
 }
 
+template< class Key, class Value, class Hash, class Equal >
+void abramov::HashTable< Key, Value, Hash, Equal >::link(HashNode< Key, Value > *node)
+{
+  size_t pos = findInsertPosition(node->data_.first, node->hash_);
+  node->next_ = table_[pos];
+  table_[pos] = node;
+}
+
 template< class Key, class Value, class Hash, class Equal >
 void abramov::HashTable< Key, Value, Hash, Equal >::resizeIfNeed()
 {
@@ -174,17 +224,15 @@ void abramov::HashTable< Key, Value, Hash, Equal >::rehash(size_t k)
 {
   HashNode< Key, Value > **old_table = table_;
   size_t old_capacity = capacity_;
+  table_ = new HashNode< Key, Value >*[k]();
   capacity_ = k;
-  size_ = 0;
-  initTable();
   for (size_t i = 0; i < old_capacity; ++i)
   {
     HashNode< Key, Value > *curr = old_table[i];
     while (curr)
     {
-      insert(curr->data_.first, curr->data_.second);
       HashNode< Key, Value > *next = curr->next_;
-      delete curr;
+      link(curr);
       curr = next;
     }
   }
@@ -192,14 +240,15 @@ void abramov::HashTable< Key, Value, Hash, Equal >::rehash(size_t k)
 }
 
 template< class Key, class Value, class Hash, class Equal >
-size_t abramov::HashTable< Key, Value, Hash, Equal >::findInsertPosition(const Key &k) const
+size_t abramov::HashTable< Key, Value, Hash, Equal >::findInsertPosition(const Key &k, size_t h) const
 {
-  size_t pos = hash_(k) % capacity_;
+  size_t orig_pos = h % capacity_;
+  size_t pos = orig_pos;
   size_t att = 0;
-  while (table_[pos] && !equal_(table_[pos]->data_.first, k))
+  while (table_[pos] && (table_[pos]->hash_ != h || !equal_(table_[pos]->data_.first, k)))
   {
-    pos = (pos + att * att) % capacity_;
     ++att;
+    pos = (orig_pos + att * att) % capacity_;
   }
   return pos;
 }
@@ -229,7 +278,7 @@ size_t abramov::HashTable< Key, Value, Hash, Equal >::erase(const Key &k)
           table_[pos] = curr->next_;
         }
         curr = curr->next_;
-        delete del;
+        pool_.destroy(del);
         ++removed;
         --size_;
       }
@@ -286,7 +335,8 @@ abramov::HashTable< Key, Value, Hash, Equal >::find(const Key & k)
   {
     return end();
   }
-  size_t pos = hash_(k) % capacity_;
+  size_t h = hash_(k);
+  size_t pos = h % capacity_;
   size_t att = 0;
   size_t orig_pos = pos;
   do
@@ -294,7 +344,7 @@ abramov::HashTable< Key, Value, Hash, Equal >::find(const Key & k)
     HashNode< Key, Value > *curr = table_[pos];
     while (curr)
     {
-      if (equal_(curr->data_.first, k))
+      if (curr->hash_ == h && equal_(curr->data_.first, k))
       {
         return HashIterator< Key, Value, Hash, Equal >(this, pos, curr);
       }
@@ -335,7 +385,8 @@ abramov::HashTable< Key, Value, Hash, Equal >::cfind(const Key & k) const
   {
     return cend();
   }
-  size_t pos = hash_(k) % capacity_;
+  size_t h = hash_(k);
+  size_t pos = h % capacity_;
   size_t att = 0;
   size_t orig_pos = pos;
   do
@@ -343,7 +394,7 @@ abramov::HashTable< Key, Value, Hash, Equal >::cfind(const Key & k) const
     HashNode< Key, Value > *curr = table_[pos];
     while (curr)
     {
-      if (equal_(curr->data_.first, k))
+      if (curr->hash_ == h && equal_(curr->data_.first, k))
       {
         return ConstHashIterator< Key, Value, Hash, Equal >(this, pos, curr);
       }
@@ -4,6 +4,44 @@
 #include <iostream>
 #include <limits>
 
+namespace
+{
+  using ValueIt = aleksandrov::ConstIterator< unsigned long long >;
+  using Cursor = std::pair< ValueIt, ValueIt >;
+
+  bool canSum(unsigned long long a, unsigned long long b) noexcept
+  {
+    return std::numeric_limits< unsigned long long >::max() - a > b;
+  }
+
+  aleksandrov::List< Cursor > makeCursors(const aleksandrov::PairsList& list)
+  {
+    aleksandrov::List< Cursor > cursors;
+    for (auto it = list.cbegin(); it != list.cend(); ++it)
+    {
+      if (!it->second.empty())
+      {
+        cursors.pushBack(std::make_pair(it->second.cbegin(), it->second.cend()));
+      }
+    }
+    return cursors;
+  }
+
+  template< class F >
+  void advanceColumn(aleksandrov::List< Cursor >& cursors, F f)
+  {
+    for (auto it = cursors.begin(); it != cursors.end(); ++it)
+    {
+      f(*it->first);
+      ++it->first;
+    }
+    cursors.removeIf([](const Cursor& cursor)
+    {
+      return cursor.first == cursor.second;
+    });
+  }
+}
+
 namespace aleksandrov
 {
   unsigned long long calcSum(const List< unsigned long long >& list)
@@ -19,8 +57,7 @@ namespace aleksandrov
 
   unsigned long long calcSum(unsigned long long a, unsigned long long b)
   {
-    const unsigned long long maxValue = std::numeric_limits< unsigned long long >::max();
-    if (maxValue - a > b)
+    if (canSum(a, b))
     {
       return a + b;
     }
@@ -51,7 +88,7 @@ namespace aleksandrov
         numList.emplaceBack(num);
       }
       in.clear();
-      list.emplaceBack(std::make_pair(listName, numList));
+      list.pushBack(std::make_pair(listName, std::move(numList)));
     }
   }
 
@@ -71,26 +108,41 @@ namespace aleksandrov
 
   void getTransposedList(const PairsList& list, List< List< unsigned long long > >& toTranspose)
   {
-    size_t shift = 0;
-    size_t maxSubListSize = calcMaxSubListSize(list);
-    while (shift != maxSubListSize)
+    List< Cursor > cursors = makeCursors(list);
+    while (!cursors.empty())
     {
       List< unsigned long long > numList;
-      for (auto it = list.begin(); it != list.end(); ++it)
+      advanceColumn(cursors, [&numList](unsigned long long value)
       {
-        auto shiftedIt = it->second.begin();
-        for (size_t i = 0; i < shift && shiftedIt != it->second.end(); ++i)
-        {
-          ++shiftedIt;
-        }
-        if (shiftedIt != it->second.end())
-        {
-          numList.emplaceBack(*shiftedIt);
-        }
-      }
-      ++shift;
-      toTranspose.emplaceBack(numList);
+        numList.emplaceBack(value);
+      });
+      toTranspose.pushBack(std::move(numList));
     }
   }
-}
 
+  List< unsigned long long > outputTransposedList(const PairsList& list, std::ostream& out)
+  {
+    List< Cursor > cursors = makeCursors(list);
+    List< unsigned long long > sumList;
+    bool overflow = false;
+    while (!cursors.empty())
+    {
+      unsigned long long sum = 0;
+      const char* separator = "";
+      advanceColumn(cursors, [&](unsigned long long value)
+      {
+        out << separator << value;
+        separator = " ";
+        overflow = overflow || !canSum(sum, value);
+        sum += overflow ? 0 : value;
+      });
+      out << '\n';
+      sumList.pushBack(sum);
+    }
+    if (overflow)
+    {
+      throw std::overflow_error("There was an overflow error!");
+    }
+    return sumList;
+  }
+}
@@ -15,6 +15,7 @@ namespace aleksandrov
   void getPairsList(std::istream&, PairsList&);
   size_t calcMaxSubListSize(const PairsList&);
   void getTransposedList(const PairsList&, List< List< unsigned long long > >&);
+  List< unsigned long long > outputTransposedList(const PairsList&, std::ostream&);
 
   template< class InputIt1, class InputIt2 >
   bool lexicographicalCompare(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2)
@@ -34,47 +34,26 @@ int main()
   }
   std::cout << '\n';
 
-  List< List< unsigned long long > > transposedList;
+  List< unsigned long long > sumList;
   try
   {
-    getTransposedList(list, transposedList);
+    sumList = outputTransposedList(list, std::cout);
   }
-  catch (const std::bad_alloc& e)
+  catch (const std::bad_alloc&)
   {
     std::cerr << "ERROR: Out of memory!" << '\n';
     return 1;
   }
-  if (transposedList.empty())
+  catch (const std::exception& e)
   {
-    std::cout << '0' << '\n';
-    return 0;
-  }
-  for (auto it = transposedList.cbegin(); it != transposedList.cend(); ++it)
-  {
-    outputList(*it, std::cout);
-    std::cout << '\n';
+    std::cerr << e.what() << '\n';
+    return 1;
   }
-
-  List< unsigned long long > sumList;
-  for (auto it = transposedList.begin(); it != transposedList.end(); ++it)
+  if (sumList.empty())
   {
-    try
-    {
-      unsigned long long sum = calcSum(*it);
-      sumList.emplaceBack(sum);
-    }
-    catch (const std::bad_alloc&)
-    {
-      std::cerr << "ERROR: Out of memory!" << '\n';
-      return 1;
-    }
-    catch (const std::exception& e)
-    {
-      std::cerr << e.what() << '\n';
-      return 1;
-    }
+    std::cout << '0' << '\n';
+    return 0;
   }
   outputList(sumList, std::cout);
   std::cout << '\n';
 }
-
@@ -1,6 +1,8 @@
 #ifndef NODE_HPP
 #define NODE_HPP
 
+#include <utility>
+
 namespace aleksandrov
 {
   namespace detail
@@ -15,6 +17,11 @@ namespace aleksandrov
         data(data),
         next(nullptr)
       {}
+
+      Node(T&& data):
+        data(std::move(data)),
+        next(nullptr)
+      {}
     };
   }
 }
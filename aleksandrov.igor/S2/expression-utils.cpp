@@ -1,6 +1,11 @@
 #include "expression-utils.hpp"
+#include <exception>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <thread>
 #include "expression-part.hpp"
+#include "ring-queue.hpp"
 #include "safe-math.hpp"
 #include "stack.hpp"
 
@@ -18,6 +23,197 @@ namespace
   {
     return !isComplexOperation(a) ? isComplexOperation(b) : false;
   }
+
+  constexpr size_t queueCapacity = 1024;
+
+  struct Postfix
+  {
+    Expression expr;
+    std::exception_ptr error;
+  };
+
+  struct Outcome
+  {
+    OperandType value;
+    std::exception_ptr postfixError;
+    std::exception_ptr evalError;
+  };
+
+  using Lines = RingQueue< Expression, queueCapacity >;
+  using Postfixes = RingQueue< Postfix, queueCapacity >;
+  using Outcomes = RingQueue< Outcome, queueCapacity >;
+
+  void readStage(std::istream& in, Lines& out, std::exception_ptr& error)
+  {
+    try
+    {
+      Expression expr;
+      while (getExpression(expr, in) && out.push(std::move(expr)))
+      {
+        expr = Expression();
+      }
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+    out.close();
+  }
+
+  void postfixStage(Lines& in, Postfixes* outs, size_t workers, std::exception_ptr& error)
+  {
+    try
+    {
+      Expression expr;
+      for (size_t i = 0; in.pop(expr); ++i)
+      {
+        Postfix postfix{ Expression(), nullptr };
+        try
+        {
+          postfix.expr = getPostfixForm(expr);
+        }
+        catch (...)
+        {
+          postfix.error = std::current_exception();
+        }
+        if (!outs[i % workers].push(std::move(postfix)))
+        {
+          break;
+        }
+      }
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+    in.close();
+    for (size_t i = 0; i < workers; ++i)
+    {
+      outs[i].close();
+    }
+  }
+
+  void evalStage(Postfixes& in, Outcomes& out, std::exception_ptr& error)
+  {
+    try
+    {
+      Postfix postfix{ Expression(), nullptr };
+      while (in.pop(postfix))
+      {
+        Outcome outcome{ 0, postfix.error, nullptr };
+        if (!outcome.postfixError)
+        {
+          try
+          {
+            outcome.value = evalPostfixExpression(postfix.expr);
+          }
+          catch (...)
+          {
+            outcome.evalError = std::current_exception();
+          }
+        }
+        if (!out.push(std::move(outcome)))
+        {
+          break;
+        }
+      }
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+    in.close();
+    out.close();
+  }
+
+  class Pipeline
+  {
+  public:
+    Pipeline(std::istream& in, size_t workers):
+      workers_(workers),
+      postfixes_(new Postfixes[workers]),
+      outcomes_(new Outcomes[workers]),
+      evaluators_(new std::thread[workers]),
+      errors_(new std::exception_ptr[workers + 2])
+    {
+      try
+      {
+        reader_ = std::thread(readStage, std::ref(in), std::ref(lines_), std::ref(errors_[0]));
+        converter_ = std::thread(postfixStage, std::ref(lines_), postfixes_.get(), workers_, std::ref(errors_[1]));
+        for (size_t i = 0; i < workers_; ++i)
+        {
+          evaluators_[i] = std::thread(evalStage, std::ref(postfixes_[i]), std::ref(outcomes_[i]), std::ref(errors_[i + 2]));
+        }
+      }
+      catch (...)
+      {
+        stop();
+        throw;
+      }
+    }
+
+    ~Pipeline()
+    {
+      stop();
+    }
+
+    bool next(size_t i, Outcome& outcome)
+    {
+      return outcomes_[i % workers_].pop(outcome);
+    }
+
+    void finish()
+    {
+      join();
+      for (size_t i = 0; i < workers_ + 2; ++i)
+      {
+        if (errors_[i])
+        {
+          std::rethrow_exception(errors_[i]);
+        }
+      }
+    }
+
+  private:
+    size_t workers_;
+    Lines lines_;
+    std::unique_ptr< Postfixes[] > postfixes_;
+    std::unique_ptr< Outcomes[] > outcomes_;
+    std::thread reader_;
+    std::thread converter_;
+    std::unique_ptr< std::thread[] > evaluators_;
+    std::unique_ptr< std::exception_ptr[] > errors_;
+
+    void stop() noexcept
+    {
+      lines_.close();
+      for (size_t i = 0; i < workers_; ++i)
+      {
+        postfixes_[i].close();
+        outcomes_[i].close();
+      }
+      join();
+    }
+
+    void join() noexcept
+    {
+      if (reader_.joinable())
+      {
+        reader_.join();
+      }
+      if (converter_.joinable())
+      {
+        converter_.join();
+      }
+      for (size_t i = 0; i < workers_; ++i)
+      {
+        if (evaluators_[i].joinable())
+        {
+          evaluators_[i].join();
+        }
+      }
+    }
+  };
 }
 
 std::istream& aleksandrov::operator>>(std::istream& in, ExpressionPart& token)
@@ -56,28 +252,35 @@ std::istream& aleksandrov::operator>>(std::istream& in, ExpressionPart& token)
   return in;
 }
 
-void aleksandrov::getExpressions(Expressions& exprs, std::istream& in)
+bool aleksandrov::getExpression(Expression& expr, std::istream& in)
 {
-  while ((in >> std::ws) && in.peek() != EOF)
+  if (!(in >> std::ws) || in.peek() == EOF)
   {
-    Expression expr;
-    while (in.peek() != '\n' && in.peek() != EOF)
-    {
-      ExpressionPart token('+');
-      if (!(in >> token))
-      {
-        throw std::logic_error("Incorrect expression part!");
-      }
-      expr.push(token);
-    }
-    if (!expr.empty())
-    {
-      exprs.push(expr);
-    }
-    if (in.peek() == '\n')
+    return false;
+  }
+  while (in.peek() != '\n' && in.peek() != EOF)
+  {
+    ExpressionPart token('+');
+    if (!(in >> token))
     {
-      in.get();
+      throw std::logic_error("Incorrect expression part!");
     }
+    expr.push(token);
+  }
+  if (in.peek() == '\n')
+  {
+    in.get();
+  }
+  return true;
+}
+
+void aleksandrov::getExpressions(Expressions& exprs, std::istream& in)
+{
+  Expression expr;
+  while (getExpression(expr, in))
+  {
+    exprs.push(std::move(expr));
+    expr.clear();
   }
 }
 
@@ -191,3 +394,37 @@ aleksandrov::OperandType aleksandrov::evalPostfixExpression(Expression& expr)
   return stack.top();
 }
 
+void aleksandrov::evalExpressions(std::istream& in, Stack< OperandType >& results, size_t workers)
+{
+  workers = workers == 0 ? 1 : workers;
+  Pipeline pipeline(in, workers);
+  std::exception_ptr postfixError = nullptr;
+  std::exception_ptr evalError = nullptr;
+
+  Outcome outcome{ 0, nullptr, nullptr };
+  for (size_t i = 0; pipeline.next(i, outcome); ++i)
+  {
+    if (outcome.postfixError && !postfixError)
+    {
+      postfixError = outcome.postfixError;
+    }
+    else if (outcome.evalError && !evalError)
+    {
+      evalError = outcome.evalError;
+    }
+    else if (!postfixError && !evalError)
+    {
+      results.push(outcome.value);
+    }
+  }
+  pipeline.finish();
+
+  if (postfixError)
+  {
+    std::rethrow_exception(postfixError);
+  }
+  if (evalError)
+  {
+    std::rethrow_exception(evalError);
+  }
+}
@@ -3,6 +3,7 @@
 
 #include <ios>
 #include "queue.hpp"
+#include "stack.hpp"
 #include "expression-part.hpp"
 
 namespace aleksandrov
@@ -12,10 +13,12 @@ namespace aleksandrov
 
   std::istream& operator>>(std::istream&, ExpressionPart&);
 
+  bool getExpression(Expression&, std::istream&);
   void getExpressions(Expressions&, std::istream&);
   Expression getPostfixForm(Expression&);
   OperandType performOperation(OperationType, OperandType, OperandType);
   OperandType evalPostfixExpression(Expression&);
+  void evalExpressions(std::istream&, Stack< OperandType >&, size_t workers);
 }
 
 #endif
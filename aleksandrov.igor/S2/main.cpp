@@ -1,30 +1,12 @@
 #include <iostream>
 #include <fstream>
+#include <thread>
 #include "stack.hpp"
 #include "expression-utils.hpp"
 
 namespace
 {
   using StackOfResults = aleksandrov::Stack< long long int >;
-  using aleksandrov::Expressions;
-
-  void getPostfixForms(Expressions& postfixExprs, Expressions& exprs)
-  {
-    while (!exprs.empty())
-    {
-      postfixExprs.push(getPostfixForm(exprs.front()));
-      exprs.pop();
-    }
-  }
-
-  void evalPostfixExpressions(Expressions& postfixExprs, StackOfResults& results)
-  {
-    while (!postfixExprs.empty())
-    {
-      results.push(evalPostfixExpression(postfixExprs.front()));
-      postfixExprs.pop();
-    }
-  }
 
   void printStackOfResults(StackOfResults& results, std::ostream& out)
   {
@@ -66,13 +48,7 @@ int main(int argc, char* argv[])
   Stack< long long int > results;
   try
   {
-    Queue< Queue< ExpressionPart > > exprs;
-    getExpressions(exprs, in);
-
-    Queue< Queue< ExpressionPart > > postfixExprs;
-    getPostfixForms(postfixExprs, exprs);
-
-    evalPostfixExpressions(postfixExprs, results);
+    evalExpressions(in, results, std::thread::hardware_concurrency());
   }
   catch (const std::bad_alloc&)
   {
@@ -0,0 +1,101 @@
+#ifndef RING_QUEUE_HPP
+#define RING_QUEUE_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+namespace aleksandrov
+{
+  template< class T, size_t N >
+  class RingQueue
+  {
+    static_assert(N > 0, "Ring queue capacity must be positive!");
+
+  public:
+    RingQueue();
+    RingQueue(const RingQueue&) = delete;
+    RingQueue& operator=(const RingQueue&) = delete;
+
+    size_t capacity() const noexcept;
+    bool push(T&&);
+    bool pop(T&);
+    void close();
+
+  private:
+    T buffer_[N];
+    size_t head_;
+    size_t size_;
+    bool closed_;
+    std::mutex mutex_;
+    std::condition_variable notFull_;
+    std::condition_variable notEmpty_;
+  };
+
+  template< class T, size_t N >
+  RingQueue< T, N >::RingQueue():
+    buffer_(),
+    head_(0),
+    size_(0),
+    closed_(false)
+  {}
+
+  template< class T, size_t N >
+  size_t RingQueue< T, N >::capacity() const noexcept
+  {
+    return N;
+  }
+
+  template< class T, size_t N >
+  bool RingQueue< T, N >::push(T&& value)
+  {
+    std::unique_lock< std::mutex > lock(mutex_);
+    while (!closed_ && size_ == N)
+    {
+      notFull_.wait(lock);
+    }
+    if (closed_)
+    {
+      return false;
+    }
+    buffer_[(head_ + size_) % N] = std::move(value);
+    ++size_;
+    lock.unlock();
+    notEmpty_.notify_one();
+    return true;
+  }
+
+  template< class T, size_t N >
+  bool RingQueue< T, N >::pop(T& value)
+  {
+    std::unique_lock< std::mutex > lock(mutex_);
+    while (!closed_ && size_ == 0)
+    {
+      notEmpty_.wait(lock);
+    }
+    if (size_ == 0)
+    {
+      return false;
+    }
+    value = std::move(buffer_[head_]);
+    head_ = (head_ + 1) % N;
+    --size_;
+    lock.unlock();
+    notFull_.notify_one();
+    return true;
+  }
+
+  template< class T, size_t N >
+  void RingQueue< T, N >::close()
+  {
+    {
+      std::lock_guard< std::mutex > lock(mutex_);
+      closed_ = true;
+    }
+    notFull_.notify_all();
+    notEmpty_.notify_all();
+  }
+}
+
+#endif
@@ -42,7 +42,19 @@ aleksandrov::IntegralType aleksandrov::safeSub(IntegralType a, IntegralType b)
 
 aleksandrov::IntegralType aleksandrov::safeMul(IntegralType a, IntegralType b)
 {
-  if ((a == min && b == -1) || (b == min && a == -1) || abs(a) > max / abs(b))
+  if (!a || !b)
+  {
+    return 0;
+  }
+  if (a == min || b == min)
+  {
+    if (a != 1 && b != 1)
+    {
+      throw std::overflow_error("Multiplication overflow!");
+    }
+    return a * b;
+  }
+  if (abs(a) > max / abs(b))
   {
     throw std::overflow_error("Multiplication overflow!");
   }
@@ -0,0 +1,77 @@
+#include <boost/test/unit_test.hpp>
+#include <string>
+#include <thread>
+#include "ring-queue.hpp"
+
+using aleksandrov::RingQueue;
+
+BOOST_AUTO_TEST_CASE(ring_queue_fifo_order)
+{
+  RingQueue< std::string, 4 > q;
+  BOOST_TEST(q.capacity() == 4);
+  BOOST_TEST(q.push("A"));
+  BOOST_TEST(q.push("B"));
+  std::string value;
+  BOOST_TEST(q.pop(value));
+  BOOST_TEST(value == "A");
+  BOOST_TEST(q.push("C"));
+  BOOST_TEST(q.push("D"));
+  BOOST_TEST(q.push("E"));
+  for (const char* expected: { "B", "C", "D", "E" })
+  {
+    BOOST_TEST(q.pop(value));
+    BOOST_TEST(value == expected);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ring_queue_close_drains)
+{
+  RingQueue< int, 4 > q;
+  BOOST_TEST(q.push(1));
+  BOOST_TEST(q.push(2));
+  q.close();
+  BOOST_TEST(!q.push(3));
+  int value = 0;
+  BOOST_TEST(q.pop(value));
+  BOOST_TEST(value == 1);
+  BOOST_TEST(q.pop(value));
+  BOOST_TEST(value == 2);
+  BOOST_TEST(!q.pop(value));
+}
+
+BOOST_AUTO_TEST_CASE(ring_queue_backpressure)
+{
+  RingQueue< int, 2 > q;
+  const int count = 10000;
+  std::thread producer([&q]()
+  {
+    for (int i = 0; i < count; ++i)
+    {
+      q.push(int(i));
+    }
+    q.close();
+  });
+  int expected = 0;
+  int value = 0;
+  while (q.pop(value))
+  {
+    BOOST_TEST(value == expected);
+    ++expected;
+  }
+  producer.join();
+  BOOST_TEST(expected == count);
+}
+
+BOOST_AUTO_TEST_CASE(ring_queue_close_wakes_blocked_push)
+{
+  RingQueue< int, 1 > q;
+  BOOST_TEST(q.push(1));
+  bool pushed = true;
+  std::thread producer([&q, &pushed]()
+  {
+    pushed = q.push(2);
+  });
+  q.close();
+  producer.join();
+  BOOST_TEST(!pushed);
+}
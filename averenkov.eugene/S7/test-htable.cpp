@@ -1,10 +1,47 @@
 #include <boost/test/unit_test.hpp>
+#include <memory>
+#include <string>
 #include <hashTable.hpp>
 
 using namespace averenkov;
 using IntStringTable = HashTable< int, std::string >;
 using StringIntTable = HashTable< std::string, int >;
 
+namespace
+{
+  struct ConstantHash
+  {
+    size_t operator()(int) const
+    {
+      return 7;
+    }
+  };
+
+  struct Counted
+  {
+    static int alive;
+    int value;
+
+    Counted(int v = 0):
+      value(v)
+    {
+      ++alive;
+    }
+    Counted(const Counted& other):
+      value(other.value)
+    {
+      ++alive;
+    }
+    ~Counted()
+    {
+      --alive;
+    }
+    Counted& operator=(const Counted& other) = default;
+  };
+
+  int Counted::alive = 0;
+}
+
 BOOST_AUTO_TEST_SUITE(HashTableTests)
 
 BOOST_AUTO_TEST_CASE(DefaultConstructor)
@@ -169,4 +206,101 @@ BOOST_AUTO_TEST_CASE(MoveOperations)
   BOOST_TEST(original.empty());
 }
 
+BOOST_AUTO_TEST_CASE(TombstoneReuse)
+{
+  HashTable< int, std::string, ConstantHash > table;
+  for (int i = 0; i < 5; ++i)
+  {
+    table.insert({ i, std::to_string(i) });
+  }
+  auto erased = std::addressof(*table.find(2));
+  BOOST_TEST(table.erase(2) == 1);
+  BOOST_TEST((table.find(2) == table.end()));
+  table.insert({ 10, "ten" });
+  BOOST_TEST((std::addressof(*table.find(10)) == erased));
+  BOOST_TEST(table.size() == 5);
+  for (int i : { 0, 1, 3, 4 })
+  {
+    BOOST_TEST(table.at(i) == std::to_string(i));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TombstoneChurn)
+{
+  IntStringTable table;
+  for (int i = 0; i < 10000; ++i)
+  {
+    table.insert({ i, std::to_string(i) });
+    if (i >= 8)
+    {
+      BOOST_TEST(table.erase(i - 8) == 1);
+    }
+  }
+  BOOST_TEST(table.size() == 8);
+  BOOST_TEST(table.load_factor() <= table.max_load_factor());
+  for (int i = 9992; i < 10000; ++i)
+  {
+    BOOST_TEST(table.at(i) == std::to_string(i));
+  }
+  BOOST_TEST(table.count(9991) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(RehashStringValues)
+{
+  HashTable< std::string, std::string > table;
+  const std::string tail(40, 'x');
+  for (int i = 0; i < 500; ++i)
+  {
+    table.insert({ std::to_string(i) + tail, std::to_string(i) + tail });
+  }
+  for (int i = 0; i < 500; i += 2)
+  {
+    table.erase(std::to_string(i) + tail);
+  }
+  table.rehash(2000);
+  BOOST_TEST(table.size() == 250);
+  table.reserve(10);
+  BOOST_TEST(table.size() == 250);
+  for (int i = 0; i < 500; ++i)
+  {
+    auto it = table.find(std::to_string(i) + tail);
+    BOOST_TEST((it == table.end()) == (i % 2 == 0));
+    if (it != table.end())
+    {
+      BOOST_TEST(it->value == std::to_string(i) + tail);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CopyMoveClearDoNotLeak)
+{
+  {
+    HashTable< int, Counted > table;
+    for (int i = 0; i < 100; ++i)
+    {
+      table.insert({ i, Counted(i) });
+    }
+    for (int i = 0; i < 100; i += 4)
+    {
+      table.erase(i);
+    }
+    BOOST_TEST(Counted::alive == 75);
+    HashTable< int, Counted > copy(table);
+    BOOST_TEST(Counted::alive == 150);
+    HashTable< int, Counted > moved(std::move(copy));
+    BOOST_TEST(Counted::alive == 150);
+    HashTable< int, Counted > assigned;
+    assigned.insert({ 1000, Counted(1000) });
+    assigned = moved;
+    BOOST_TEST(Counted::alive == 225);
+    assigned = std::move(table);
+    BOOST_TEST(assigned.size() == 75);
+    moved.clear();
+    BOOST_TEST(moved.empty());
+    moved.insert({ 1, Counted(1) });
+    BOOST_TEST(moved.at(1).value == 1);
+  }
+  BOOST_TEST(Counted::alive == 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -10,19 +10,17 @@ namespace averenkov::detail
   {
     Key key;
     Value value;
-    bool occupied = false;
-    bool deleted = false;
 
-    Bucket();
+    template< class K, class V >
+    Bucket(K&& k, V&& v);
   };
 }
 
 template< class Key, class Value >
-averenkov::detail::Bucket< Key, Value >::Bucket():
-  key(Key{}),
-  value(Value{}),
-  occupied(false),
-  deleted(false)
+template< class K, class V >
+averenkov::detail::Bucket< Key, Value >::Bucket(K&& k, V&& v):
+  key(std::forward< K >(k)),
+  value(std::forward< V >(v))
 {}
 
 
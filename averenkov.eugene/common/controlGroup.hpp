@@ -0,0 +1,97 @@
+#ifndef CONTROLGROUP_HPP
+#define CONTROLGROUP_HPP
+
+#include <cstddef>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace averenkov::detail
+{
+  constexpr signed char CTRL_EMPTY = -128;
+  constexpr signed char CTRL_DELETED = -2;
+  constexpr size_t GROUP_WIDTH = 16;
+
+  inline bool is_full(signed char ctrl) noexcept
+  {
+    return ctrl >= 0;
+  }
+
+  inline size_t lowest_bit(unsigned mask) noexcept
+  {
+    return static_cast< size_t >(__builtin_ctz(mask));
+  }
+
+  class Group
+  {
+  public:
+    explicit Group(const signed char* pos) noexcept;
+
+    unsigned match(signed char fragment) const noexcept;
+    unsigned match_empty() const noexcept;
+    unsigned match_free() const noexcept;
+
+  private:
+#ifdef __SSE2__
+    __m128i ctrl_;
+#else
+    const signed char* ctrl_;
+#endif
+  };
+}
+
+#ifdef __SSE2__
+
+inline averenkov::detail::Group::Group(const signed char* pos) noexcept:
+  ctrl_(_mm_loadu_si128(reinterpret_cast< const __m128i* >(pos)))
+{}
+
+inline unsigned averenkov::detail::Group::match(signed char fragment) const noexcept
+{
+  return static_cast< unsigned >(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(fragment), ctrl_)));
+}
+
+inline unsigned averenkov::detail::Group::match_empty() const noexcept
+{
+  return match(CTRL_EMPTY);
+}
+
+inline unsigned averenkov::detail::Group::match_free() const noexcept
+{
+  return static_cast< unsigned >(_mm_movemask_epi8(ctrl_));
+}
+
+#else
+
+inline averenkov::detail::Group::Group(const signed char* pos) noexcept:
+  ctrl_(pos)
+{}
+
+inline unsigned averenkov::detail::Group::match(signed char fragment) const noexcept
+{
+  unsigned mask = 0;
+  for (size_t i = 0; i < GROUP_WIDTH; ++i)
+  {
+    mask |= static_cast< unsigned >(ctrl_[i] == fragment) << i;
+  }
+  return mask;
+}
+
+inline unsigned averenkov::detail::Group::match_empty() const noexcept
+{
+  return match(CTRL_EMPTY);
+}
+
+inline unsigned averenkov::detail::Group::match_free() const noexcept
+{
+  unsigned mask = 0;
+  for (size_t i = 0; i < GROUP_WIDTH; ++i)
+  {
+    mask |= static_cast< unsigned >(!is_full(ctrl_[i])) << i;
+  }
+  return mask;
+}
+
+#endif
+
+#endif
@@ -4,6 +4,7 @@
 #include <iterator>
 #include <type_traits>
 #include "bucket.hpp"
+#include "controlGroup.hpp"
 
 namespace averenkov
 {
@@ -38,42 +39,32 @@ namespace averenkov
   private:
     using BucketPtr = std::conditional_t< isConst, const detail::Bucket< Key, Value >*, detail::Bucket< Key, Value >* >;
 
+    const signed char* ctrl_;
     BucketPtr current_;
     BucketPtr end_;
-    Equal key_equal_;
 
-    IteratorHash(BucketPtr ptr, BucketPtr end_ptr) noexcept;
-    IteratorHash(BucketPtr ptr, BucketPtr end_ptr, Equal key_equal) noexcept;
-    void skip_empty();
-    bool is_valid_data(BucketPtr bucket);
+    IteratorHash(const signed char* ctrl, BucketPtr ptr, BucketPtr end_ptr) noexcept;
+    void skip_empty() noexcept;
   };
 }
 
 template < class Key, class Value, class Hash, class Equal, bool isConst >
 averenkov::IteratorHash< Key, Value, Hash, Equal, isConst >::IteratorHash() noexcept:
+  ctrl_(nullptr),
   current_(nullptr),
-  end_(nullptr),
-  key_equal_(Equal())
+  end_(nullptr)
 {}
 
 
 template < class Key, class Value, class Hash, class Equal, bool isConst >
-averenkov::IteratorHash< Key, Value, Hash, Equal, isConst >::IteratorHash(BucketPtr ptr, BucketPtr end_ptr) noexcept:
+averenkov::IteratorHash< Key, Value, Hash, Equal, isConst >::IteratorHash(const signed char* ctrl, BucketPtr ptr, BucketPtr end_ptr) noexcept:
+  ctrl_(ctrl),
   current_(ptr),
   end_(end_ptr)
 {
   skip_empty();
 }
 
-template < class Key, class Value, class Hash, class Equal, bool isConst >
-averenkov::IteratorHash< Key, Value, Hash, Equal, isConst >::IteratorHash(BucketPtr ptr, BucketPtr end_ptr, Equal key_equal) noexcept:
-  current_(ptr),
-  end_(end_ptr),
-  key_equal_(key_equal)
-{
-  skip_empty();
-}
-
 template < class Key, class Value, class Hash, class Equal, bool isConst >
 typename averenkov::IteratorHash< Key, Value, Hash, Equal, isConst >::reference
 averenkov::IteratorHash< Key, Value, Hash, Equal, isConst >::operator*() const noexcept
@@ -92,6 +83,7 @@ template < class Key, class Value, class Hash, class Equal, bool isConst >
 averenkov::IteratorHash< Key, Value, Hash, Equal, isConst >&
 averenkov::IteratorHash< Key, Value, Hash, Equal, isConst >::operator++() noexcept
 {
+  ++ctrl_;
   ++current_;
   skip_empty();
   return *this;
@@ -119,27 +111,13 @@ bool averenkov::IteratorHash< Key, Value, Hash, Equal, isConst >::operator!=(con
 }
 
 template < class Key, class Value, class Hash, class Equal, bool isConst >
-void averenkov::IteratorHash< Key, Value, Hash, Equal, isConst >::skip_empty()
+void averenkov::IteratorHash< Key, Value, Hash, Equal, isConst >::skip_empty() noexcept
 {
-  while (current_ != end_ && (!current_->occupied || current_->deleted || !is_valid_data(current_)))
+  while (current_ != end_ && !detail::is_full(*ctrl_))
   {
+    ++ctrl_;
     ++current_;
   }
 }
 
-template < class Key, class Value, class Hash, class Equal, bool isConst >
-bool averenkov::IteratorHash< Key, Value, Hash, Equal, isConst >::is_valid_data(BucketPtr bucket)
-{
-  try
-  {
-    static Key dummy;
-    key_equal_(bucket->key, dummy);
-    return true;
-  }
-  catch (...)
-  {
-    return false;
-  }
-}
-
 #endif
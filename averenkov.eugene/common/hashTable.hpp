@@ -1,13 +1,15 @@
 #ifndef HASHTABLE_HPP
 #define HASHTABLE_HPP
 
+#include <cstddef>
 #include <functional>
+#include <new>
 #include <stdexcept>
 #include <utility>
 #include <iterator>
 #include <algorithm>
 #include <bucket.hpp>
-#include <array.hpp>
+#include <controlGroup.hpp>
 #include <hashTIterator.hpp>
 #include <prime.hpp>
 
@@ -29,6 +31,7 @@ namespace averenkov
     HashTable(std::initializer_list< std::pair< Key, Value > > init);
     template< typename InputIt >
     HashTable(InputIt first, InputIt last);
+    ~HashTable();
 
     HashTable& operator=(const HashTable& other);
     HashTable& operator=(HashTable&& other) noexcept;
@@ -76,8 +79,15 @@ namespace averenkov
     size_t probe(size_t hash, size_t i) const noexcept;
 
   private:
-    Array< detail::Bucket< Key, Value > > table_;
+    using bucket_type = detail::Bucket< Key, Value >;
+
+    static_assert(alignof(bucket_type) <= alignof(std::max_align_t), "Over-aligned bucket");
+
+    signed char* ctrl_ = nullptr;
+    bucket_type* slots_ = nullptr;
+    size_t capacity_ = 0;
     size_t size_ = 0;
+    size_t deleted_ = 0;
     Hash hasher_;
     Equal key_equal_;
     float max_load_factor_ = 0.75;
@@ -85,46 +95,66 @@ namespace averenkov
     explicit HashTable(size_t bucket_count, const Hash& hash = Hash(), const Equal& equal = Equal());
     size_t hash_to_index(const Key& key) const;
     void rehash_if_needed();
+
+    signed char fragment(size_t hash) const noexcept;
+    void set_ctrl(size_t index, signed char ctrl) noexcept;
+    size_t find_index(const Key& key, size_t hash) const;
+    size_t free_index(size_t hash) const noexcept;
+    void grow();
+    void destroy_all() noexcept;
+    void allocate(size_t count);
   };
 
   template < class Key, class Value, class Hash, class Equal >
   size_t HashTable< Key, Value, Hash, Equal >::probe(size_t hash, size_t i) const noexcept
   {
-    return (hash + i * i) % table_.size();
+    return (hash + i * detail::GROUP_WIDTH) % capacity_;
   }
 
   template < class Key, class Value, class Hash, class Equal >
   HashTable< Key, Value, Hash, Equal >::HashTable(size_t bucket_count, const Hash& hash, const Equal& equal):
-    table_(next_prime(bucket_count)),
     hasher_(hash),
     key_equal_(equal)
-  {}
+  {
+    if (bucket_count != 0)
+    {
+      allocate(next_prime(bucket_count));
+    }
+  }
 
 
   template < class Key, class Value, class Hash, class Equal >
   HashTable< Key, Value, Hash, Equal >::HashTable():
-    HashTable(11)
+    HashTable(0)
   {}
 
   template < class Key, class Value, class Hash, class Equal >
   HashTable< Key, Value, Hash, Equal >::HashTable(const HashTable& other):
-    table_(other.table_),
-    size_(other.size_),
-    hasher_(other.hasher_),
-    key_equal_(other.key_equal_),
-    max_load_factor_(other.max_load_factor_)
-  {}
+    HashTable(other.capacity_, other.hasher_, other.key_equal_)
+  {
+    max_load_factor_ = other.max_load_factor_;
+    for (size_t i = 0; i < capacity_; ++i)
+    {
+      if (detail::is_full(other.ctrl_[i]))
+      {
+        new (slots_ + i) bucket_type(other.slots_[i]);
+        set_ctrl(i, other.ctrl_[i]);
+        ++size_;
+      }
+    }
+  }
 
   template < class Key, class Value, class Hash, class Equal >
   HashTable< Key, Value, Hash, Equal >::HashTable(HashTable&& other) noexcept:
-    table_(std::move(other.table_)),
-    size_(other.size_),
+    ctrl_(std::exchange(other.ctrl_, nullptr)),
+    slots_(std::exchange(other.slots_, nullptr)),
+    capacity_(std::exchange(other.capacity_, 0)),
+    size_(std::exchange(other.size_, 0)),
+    deleted_(std::exchange(other.deleted_, 0)),
     hasher_(std::move(other.hasher_)),
     key_equal_(std::move(other.key_equal_)),
     max_load_factor_(other.max_load_factor_)
-  {
-    other.size_ = 0;
-  }
+  {}
 
   template < class Key, class Value, class Hash, class Equal >
   HashTable< Key, Value, Hash, Equal >::HashTable(std::initializer_list< std::pair< Key, Value > > init):
@@ -139,16 +169,21 @@ namespace averenkov
     insert(first, last);
   }
 
+  template < class Key, class Value, class Hash, class Equal >
+  HashTable< Key, Value, Hash, Equal >::~HashTable()
+  {
+    destroy_all();
+    delete[] ctrl_;
+    ::operator delete(slots_);
+  }
+
   template < class Key, class Value, class Hash, class Equal >
   HashTable< Key, Value, Hash, Equal >& HashTable< Key, Value, Hash, Equal >::operator=(const HashTable& other)
   {
     if (this != &other)
     {
-      table_ = other.table_;
-      size_ = other.size_;
-      hasher_ = other.hasher_;
-      key_equal_ = other.key_equal_;
-      max_load_factor_ = other.max_load_factor_;
+      HashTable temp(other);
+      swap(temp);
     }
     return *this;
   }
@@ -158,12 +193,8 @@ namespace averenkov
   {
     if (this != &other)
     {
-      table_ = std::move(other.table_);
-      size_ = other.size_;
-      hasher_ = std::move(other.hasher_);
-      key_equal_ = std::move(other.key_equal_);
-      max_load_factor_ = other.max_load_factor_;
-      other.size_ = 0;
+      HashTable temp(std::move(other));
+      swap(temp);
     }
     return *this;
   }
@@ -180,21 +211,14 @@ namespace averenkov
   typename HashTable< Key, Value, Hash, Equal >::iterator
   HashTable< Key, Value, Hash, Equal >::begin() noexcept
   {
-    for (size_t i = 0; i < table_.size(); ++i)
-    {
-      if (table_[i].occupied && !table_[i].deleted)
-      {
-        return iterator(&table_[i], &table_[0] + table_.size());
-      }
-    }
-    return end();
+    return iterator(ctrl_, slots_, slots_ + capacity_);
   }
 
   template < class Key, class Value, class Hash, class Equal >
   typename HashTable< Key, Value, Hash, Equal >::iterator
   HashTable< Key, Value, Hash, Equal >::end() noexcept
   {
-    return iterator(&table_[0] + table_.size(), &table_[0] + table_.size());
+    return iterator(ctrl_ + capacity_, slots_ + capacity_, slots_ + capacity_);
   }
 
   template < class Key, class Value, class Hash, class Equal >
@@ -215,21 +239,14 @@ namespace averenkov
   typename HashTable< Key, Value, Hash, Equal >::const_iterator
   HashTable< Key, Value, Hash, Equal >::cbegin() const noexcept
   {
-    for (size_t i = 0; i < table_.size(); ++i)
-    {
-      if (table_[i].occupied && !table_[i].deleted)
-      {
-        return const_iterator(&table_[i], &table_[0] + table_.size());
-      }
-    }
-    return cend();
+    return const_iterator(ctrl_, slots_, slots_ + capacity_);
   }
 
   template < class Key, class Value, class Hash, class Equal >
   typename HashTable< Key, Value, Hash, Equal >::const_iterator
   HashTable< Key, Value, Hash, Equal >::cend() const noexcept
   {
-    return const_iterator(&table_[0] + table_.size(), &table_[0] + table_.size());
+    return const_iterator(ctrl_ + capacity_, slots_ + capacity_, slots_ + capacity_);
   }
 
   template < class Key, class Value, class Hash, class Equal >
@@ -247,12 +264,13 @@ namespace averenkov
   template < class Key, class Value, class Hash, class Equal >
   void HashTable< Key, Value, Hash, Equal >::clear() noexcept
   {
-    for (size_t i = 0; i < table_.size(); ++i)
+    destroy_all();
+    if (capacity_ != 0)
     {
-      table_[i].occupied = false;
-      table_[i].deleted = false;
+      std::fill(ctrl_, ctrl_ + capacity_ + detail::GROUP_WIDTH - 1, detail::CTRL_EMPTY);
     }
     size_ = 0;
+    deleted_ = 0;
   }
 
   template < class Key, class Value, class Hash, class Equal >
@@ -267,47 +285,25 @@ namespace averenkov
   std::pair< typename HashTable< Key, Value, Hash, Equal >::iterator, bool >
     HashTable< Key, Value, Hash, Equal >::emplace(K&& key, V&& value)
   {
-    if (size_ + 1 > max_load_factor_ * table_.size())
+    size_t hash = hasher_(key);
+    size_t index = find_index(key, hash);
+    if (index != capacity_)
     {
-      rehash(table_.size() * 2);
+      return { iterator(ctrl_ + index, slots_ + index, slots_ + capacity_), false };
     }
-    size_t hash = hasher_(key) % table_.size();
-    size_t i = 0;
-    size_t index = probe(hash, i);
-    size_t first_deleted = table_.size();
-
-    while (table_[index].occupied || table_[index].deleted)
+    if (size_ + deleted_ + 1 > max_load_factor_ * capacity_)
     {
-      if (table_[index].occupied && key_equal_(table_[index].key, key))
-      {
-        if (table_[index].deleted)
-        {
-          table_[index].key = key;
-          table_[index].value = value;
-          table_[index].occupied = true;
-          table_[index].deleted = false;
-          ++size_;
-          return { iterator(table_.get_data() + index, table_.get_data() + table_.size()), true };
-        }
-        return { iterator(table_.get_data() + index, table_.get_data() + table_.size()), false };
-      }
-      if (table_[index].deleted && first_deleted == table_.size())
-      {
-        first_deleted = index;
-      }
-      ++i;
-      index = probe(hash, i);
+      grow();
     }
-    if (first_deleted != table_.size())
+    index = free_index(hash);
+    new (slots_ + index) bucket_type(std::forward< K >(key), std::forward< V >(value));
+    if (ctrl_[index] == detail::CTRL_DELETED)
     {
-      index = first_deleted;
+      --deleted_;
     }
-    table_[index].key = key;
-    table_[index].value = value;
-    table_[index].occupied = true;
-    table_[index].deleted = false;
+    set_ctrl(index, fragment(hash));
     ++size_;
-    return { iterator(table_.get_data() + index, table_.get_data() + table_.size()), true };
+    return { iterator(ctrl_ + index, slots_ + index, slots_ + capacity_), true };
   }
 
   template < class Key, class Value, class Hash, class Equal >
@@ -330,14 +326,15 @@ namespace averenkov
   typename HashTable< Key, Value, Hash, Equal >::iterator
   HashTable< Key, Value, Hash, Equal >::erase(iterator pos)
   {
-    if (pos.current_ >= &table_[0] + table_.size())
+    if (pos.current_ >= slots_ + capacity_)
     {
       return end();
     }
 
-    size_t index = pos.current_ - &table_[0];
-    table_[index].occupied = false;
-    table_[index].deleted = true;
+    size_t index = pos.current_ - slots_;
+    slots_[index].~bucket_type();
+    set_ctrl(index, detail::CTRL_DELETED);
+    ++deleted_;
     size_--;
 
     auto next = pos;
@@ -371,8 +368,11 @@ namespace averenkov
   template < class Key, class Value, class Hash, class Equal >
   void HashTable< Key, Value, Hash, Equal >::swap(HashTable& other) noexcept
   {
-    table_.swap(other.table_);
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(capacity_, other.capacity_);
     std::swap(size_, other.size_);
+    std::swap(deleted_, other.deleted_);
     std::swap(hasher_, other.hasher_);
     std::swap(key_equal_, other.key_equal_);
     std::swap(max_load_factor_, other.max_load_factor_);
@@ -403,23 +403,13 @@ namespace averenkov
   template < class Key, class Value, class Hash, class Equal >
   Value& HashTable< Key, Value, Hash, Equal >::operator[](const Key& key)
   {
-    auto it = find(key);
-    if (it == end())
-    {
-      it = insert({ key, Value() }).first;
-    }
-    return it->value;
+    return emplace(key, Value()).first->value;
   }
 
   template < class Key, class Value, class Hash, class Equal >
   Value& HashTable< Key, Value, Hash, Equal >::operator[](Key&& key)
   {
-    auto it = find(key);
-    if (it == end())
-    {
-      it = insert({ std::move(key), Value() }).first;
-    }
-    return it->value;
+    return emplace(std::move(key), Value()).first->value;
   }
 
   template < class Key, class Value, class Hash, class Equal >
@@ -436,24 +426,8 @@ namespace averenkov
     {
       return end();
     }
-    size_t hash = hasher_(key) % table_.size();
-    size_t i = 0;
-    size_t index = probe(hash, i);
-
-    while (table_[index].occupied || table_[index].deleted)
-    {
-      if (table_[index].occupied && key_equal_(table_[index].key, key))
-      {
-        return iterator(table_.get_data() + index, table_.get_data() + table_.size());
-      }
-      ++i;
-      index = probe(hash, i);
-      if (i >= table_.size())
-      {
-        break;
-      }
-    }
-    return end();
+    size_t index = find_index(key, hasher_(key));
+    return iterator(ctrl_ + index, slots_ + index, slots_ + capacity_);
   }
 
   template < class Key, class Value, class Hash, class Equal >
@@ -464,30 +438,14 @@ namespace averenkov
     {
       return cend();
     }
-    size_t hash = hasher_(key) % table_.size();
-    size_t i = 0;
-    size_t index = probe(hash, i);
-
-    while (table_[index].occupied || table_[index].deleted)
-    {
-      if (table_[index].occupied && key_equal_(table_[index].key, key))
-      {
-        return const_iterator(table_.get_data() + index, table_.get_data() + table_.size());
-      }
-      ++i;
-      index = probe(hash, i);
-      if (i >= table_.size())
-      {
-        break;
-      }
-    }
-    return cend();
+    size_t index = find_index(key, hasher_(key));
+    return const_iterator(ctrl_ + index, slots_ + index, slots_ + capacity_);
   }
 
   template < class Key, class Value, class Hash, class Equal >
   float HashTable< Key, Value, Hash, Equal >::load_factor() const noexcept
   {
-    return table_.size() == 0 ? 0.0f : static_cast<float>(size_) / table_.size();
+    return capacity_ == 0 ? 0.0f : static_cast<float>(size_) / capacity_;
   }
 
   template < class Key, class Value, class Hash, class Equal >
@@ -510,36 +468,21 @@ namespace averenkov
   template < class Key, class Value, class Hash, class Equal >
   void HashTable< Key, Value, Hash, Equal >::rehash(size_t count)
   {
-    count = next_prime(count);
-    Array< detail::Bucket < Key, Value > > new_table(count);
-    for (size_t i = 0; i < count; ++i)
-    {
-      new_table.push_back(detail::Bucket< Key, Value >());
-    }
-
-    for (size_t i = 0; i < table_.size(); ++i)
+    count = next_prime(std::max(count, static_cast< size_t >(size_ / max_load_factor_) + 1));
+    HashTable temp(count, hasher_, key_equal_);
+    temp.max_load_factor_ = max_load_factor_;
+    for (size_t i = 0; i < capacity_; ++i)
     {
-      auto& bucket = table_[i];
-      if (bucket.occupied && !bucket.deleted)
+      if (detail::is_full(ctrl_[i]))
       {
-        size_t index = hasher_(bucket.key) % count;
-        size_t j = 0;
-
-        while (j < count)
-        {
-          size_t current_index = (index + j * j) % count;
-          if (!new_table[current_index].occupied)
-          {
-            new_table[current_index].key = std::move(bucket.key);
-            new_table[current_index].value = std::move(bucket.value);
-            new_table[current_index].occupied = true;
-            break;
-          }
-          j++;
-        }
+        size_t hash = hasher_(slots_[i].key);
+        size_t index = temp.free_index(hash);
+        new (temp.slots_ + index) bucket_type(std::move_if_noexcept(slots_[i]));
+        temp.set_ctrl(index, temp.fragment(hash));
+        ++temp.size_;
       }
     }
-    table_ = std::move(new_table);
+    swap(temp);
   }
 
   template < class Key, class Value, class Hash, class Equal >
@@ -551,11 +494,11 @@ namespace averenkov
   template < class Key, class Value, class Hash, class Equal >
   size_t HashTable< Key, Value, Hash, Equal >::hash_to_index(const Key& key) const
   {
-    if (table_.empty())
+    if (capacity_ == 0)
     {
       return 0;
     }
-    return hasher_(key) % table_.size();
+    return hasher_(key) % capacity_;
   }
 
   template < class Key, class Value, class Hash, class Equal >
@@ -563,8 +506,113 @@ namespace averenkov
   {
     if (load_factor() > max_load_factor_)
     {
-      rehash(table_.size() * 2 + 1);
+      rehash(capacity_ * 2 + 1);
+    }
+  }
+
+  template < class Key, class Value, class Hash, class Equal >
+  signed char HashTable< Key, Value, Hash, Equal >::fragment(size_t hash) const noexcept
+  {
+    return static_cast< signed char >((hash / capacity_) & 0x7F);
+  }
+
+  template < class Key, class Value, class Hash, class Equal >
+  void HashTable< Key, Value, Hash, Equal >::set_ctrl(size_t index, signed char ctrl) noexcept
+  {
+    for (size_t i = index; i < capacity_ + detail::GROUP_WIDTH - 1; i += capacity_)
+    {
+      ctrl_[i] = ctrl;
+    }
+  }
+
+  template < class Key, class Value, class Hash, class Equal >
+  size_t HashTable< Key, Value, Hash, Equal >::find_index(const Key& key, size_t hash) const
+  {
+    if (capacity_ == 0)
+    {
+      return 0;
+    }
+    signed char frag = fragment(hash);
+    size_t start = hash % capacity_;
+    for (size_t i = 0; i * detail::GROUP_WIDTH < capacity_; ++i)
+    {
+      size_t pos = probe(start, i);
+      detail::Group group(ctrl_ + pos);
+      for (unsigned mask = group.match(frag); mask != 0; mask &= mask - 1)
+      {
+        size_t index = (pos + detail::lowest_bit(mask)) % capacity_;
+        if (key_equal_(slots_[index].key, key))
+        {
+          return index;
+        }
+      }
+      if (group.match_empty() != 0)
+      {
+        break;
+      }
+    }
+    return capacity_;
+  }
+
+  template < class Key, class Value, class Hash, class Equal >
+  size_t HashTable< Key, Value, Hash, Equal >::free_index(size_t hash) const noexcept
+  {
+    size_t start = hash % capacity_;
+    for (size_t i = 0;; ++i)
+    {
+      size_t pos = probe(start, i);
+      unsigned mask = detail::Group(ctrl_ + pos).match_free();
+      if (mask != 0)
+      {
+        return (pos + detail::lowest_bit(mask)) % capacity_;
+      }
+    }
+  }
+
+  template < class Key, class Value, class Hash, class Equal >
+  void HashTable< Key, Value, Hash, Equal >::grow()
+  {
+    if (capacity_ == 0)
+    {
+      rehash(11);
+    }
+    else if (size_ * 2 + 2 > max_load_factor_ * capacity_)
+    {
+      rehash(capacity_ * 2);
+    }
+    else
+    {
+      rehash(capacity_);
+    }
+  }
+
+  template < class Key, class Value, class Hash, class Equal >
+  void HashTable< Key, Value, Hash, Equal >::destroy_all() noexcept
+  {
+    for (size_t i = 0; i < capacity_; ++i)
+    {
+      if (detail::is_full(ctrl_[i]))
+      {
+        slots_[i].~bucket_type();
+      }
+    }
+  }
+
+  template < class Key, class Value, class Hash, class Equal >
+  void HashTable< Key, Value, Hash, Equal >::allocate(size_t count)
+  {
+    ctrl_ = new signed char[count + detail::GROUP_WIDTH - 1];
+    std::fill(ctrl_, ctrl_ + count + detail::GROUP_WIDTH - 1, detail::CTRL_EMPTY);
+    try
+    {
+      slots_ = static_cast< bucket_type* >(::operator new(count * sizeof(bucket_type)));
+    }
+    catch (...)
+    {
+      delete[] std::exchange(ctrl_, nullptr);
+      throw;
     }
+    capacity_ = count;
   }
 
 }
@@ -220,14 +220,8 @@ void dribas::show_rest(std::istream& in, std::ostream& out, const Suite& suite)
   time_t date = parseDate(year, month, day);
   auto it = suite.find(1);
   if (it != suite.end()) {
-    int total_recovery = 0;
-    size_t count = 0;
-    for (auto workout_it = it->second.begin(); workout_it != it->second.end(); ++workout_it) {
-      if (workout_it->first >= date && workout_it->first < date + 86400) {
-        total_recovery += 1;
-        count++;
-      }
-    }
+    size_t count = it->second.summarize(date, date + 86399).workoutCount;
+    int total_recovery = static_cast< int >(count);
     out << "=== Recovery Report ===\n";
     out  << "Date: " << year << "-" << month << "-" << day << "\n";
     out << "Workouts: " << count << "\n";
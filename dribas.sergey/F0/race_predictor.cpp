@@ -38,21 +38,12 @@ namespace
 dribas::RacePrediction dribas::predict_result(const dribas::AVLTree<time_t, workout>& workouts)
 {
   RacePrediction prediction = { 0.0, 0.0, 0.0, 0.0 };
-  size_t count = 0;
-  double max_distance = 0.0;
-  double min_pace = -1;
-  for (auto it = workouts.begin(); it != workouts.end(); ++it) {
-    const workout& w = it->second;
-    if (w.distance > 0 && w.avgPaceMinPerKm > 0) {
-      count++;
-      if (w.distance > max_distance) max_distance = w.distance;
-      if (w.avgPaceMinPerKm < min_pace) min_pace = w.avgPaceMinPerKm;
-    }
-  }
-
-  if (count == 0) {
+  const WorkoutAccumulator& totals = workouts.summary();
+  if (totals.pacedCount == 0) {
     return prediction;
   }
+  double max_distance = totals.maxPacedDistance;
+  double min_pace = totals.minPace;
 
   prediction.fiveKm = min_pace * 1.06;
   prediction.tenKm = min_pace * 1.08;
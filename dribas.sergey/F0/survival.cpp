@@ -5,15 +5,6 @@
 
 namespace dribas
 {
-  WorkoutAccumulator accumulate_workout_data(WorkoutAccumulator acc, const std::pair< time_t, workout >& entry)
-  {
-    const workout& w = entry.second;
-    acc.totalDistance += w.distance;
-    acc.totalDuration += (w.timeEnd - w.timeStart) / 3600.0;
-    acc.strengthSum += (w.maxHeart - w.avgHeart) + w.cadence;
-    acc.workoutCount++;
-    return acc;
-  }
   std::string RecommendationGenerator::operator()(const std::pair< double, std::string >& rule) const
   {
     if (rule.first == 50.0 && score.enduranceScore < rule.first) {
@@ -32,10 +23,7 @@ namespace dribas
       return score;
     }
 
-    WorkoutAccumulator totals;
-    for (auto it = workouts.begin(); it != workouts.end(); ++it) {
-      totals = accumulate_workout_data(totals, *it);
-    }
+    const WorkoutAccumulator& totals = workouts.summary();
     score.enduranceScore = (totals.totalDistance * totals.totalDuration) / totals.workoutCount;
     score.strengthScore = totals.strengthSum / totals.workoutCount;
 
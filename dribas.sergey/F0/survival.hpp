@@ -8,16 +8,6 @@
 
 namespace dribas
 {
-  struct WorkoutAccumulator
-  {
-    double totalDistance = 0.0;
-    double totalDuration = 0.0;
-    double strengthSum = 0.0;
-    size_t workoutCount = 0;
-  };
-
-  WorkoutAccumulator accumulate_workout_data(WorkoutAccumulator, const std::pair<time_t, workout>&);
-
   struct SurvivalScore
   {
     double enduranceScore = 0.0;
@@ -3,6 +3,7 @@
 #include <cmath>
 #include <numbers>
 #include <iomanip>
+#include <algorithm>
 
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
@@ -117,6 +118,44 @@ namespace dribas
     return result;
   }
 
+  WorkoutAccumulator accumulate_workout_data(WorkoutAccumulator acc, const std::pair< time_t, workout >& entry)
+  {
+    const workout& w = entry.second;
+    acc.totalDistance += w.distance;
+    acc.totalDuration += (w.timeEnd - w.timeStart) / 3600.0;
+    acc.strengthSum += (w.maxHeart - w.avgHeart) + w.cadence;
+    acc.workoutCount++;
+    if (w.distance > 0 && w.avgPaceMinPerKm > 0) {
+      acc.maxPacedDistance = acc.pacedCount ? std::max(acc.maxPacedDistance, w.distance) : w.distance;
+      acc.minPace = acc.pacedCount ? std::min(acc.minPace, w.avgPaceMinPerKm) : w.avgPaceMinPerKm;
+      acc.pacedCount++;
+    }
+    return acc;
+  }
+
+  void merge_workout_data(WorkoutAccumulator& acc, const WorkoutAccumulator& other)
+  {
+    acc.totalDistance += other.totalDistance;
+    acc.totalDuration += other.totalDuration;
+    acc.strengthSum += other.strengthSum;
+    acc.workoutCount += other.workoutCount;
+    if (other.pacedCount) {
+      acc.maxPacedDistance = acc.pacedCount ? std::max(acc.maxPacedDistance, other.maxPacedDistance) : other.maxPacedDistance;
+      acc.minPace = acc.pacedCount ? std::min(acc.minPace, other.minPace) : other.minPace;
+      acc.pacedCount += other.pacedCount;
+    }
+  }
+
+  WorkoutAccumulator NodeSummary< time_t, workout >::make(const std::pair< time_t, workout >& entry) noexcept
+  {
+    return accumulate_workout_data(WorkoutAccumulator{}, entry);
+  }
+
+  void NodeSummary< time_t, workout >::merge(WorkoutAccumulator& acc, const WorkoutAccumulator& other) noexcept
+  {
+    merge_workout_data(acc, other);
+  }
+
   std::istream& operator>>(std::istream& is, workout& w)
   {
     dribas::StreamGuard guard(is);
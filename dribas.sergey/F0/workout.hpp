@@ -21,6 +21,28 @@ namespace dribas
     time_t timeEnd = 0;
   };
 
+  struct WorkoutAccumulator
+  {
+    double totalDistance = 0.0;
+    double totalDuration = 0.0;
+    double strengthSum = 0.0;
+    size_t workoutCount = 0;
+    size_t pacedCount = 0;
+    double maxPacedDistance = 0.0;
+    double minPace = 0.0;
+  };
+
+  WorkoutAccumulator accumulate_workout_data(WorkoutAccumulator, const std::pair< time_t, workout >&);
+  void merge_workout_data(WorkoutAccumulator&, const WorkoutAccumulator&);
+
+  template<>
+  struct NodeSummary< time_t, workout >
+  {
+    using type = WorkoutAccumulator;
+    static type make(const std::pair< time_t, workout >&) noexcept;
+    static void merge(type&, const type&) noexcept;
+  };
+
   struct training_suite
   {
     AVLTree< size_t, AVLTree< time_t, workout > > suite;
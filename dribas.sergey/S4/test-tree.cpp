@@ -1,3 +1,4 @@
+#include <type_traits>
 #include <boost/test/unit_test.hpp>
 #include <avlTree.hpp>
 
@@ -417,3 +418,97 @@ BOOST_AUTO_TEST_CASE(DuplicateKeysTest)
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+namespace dribas
+{
+  template<>
+  struct NodeSummary< int, int >
+  {
+    struct type
+    {
+      long long sum = 0;
+      size_t count = 0;
+    };
+    static type make(const std::pair< int, int >& value) noexcept
+    {
+      return type{value.second, 1};
+    }
+    static void merge(type& acc, const type& other) noexcept
+    {
+      acc.sum += other.sum;
+      acc.count += other.count;
+    }
+  };
+}
+
+BOOST_AUTO_TEST_SUITE(SummaryTests)
+
+BOOST_AUTO_TEST_CASE(EmptyTreeSummary)
+{
+  AVLTree< int, int > tree;
+  BOOST_CHECK_EQUAL(tree.summary().count, 0);
+  BOOST_CHECK_EQUAL(tree.summarize(0, 100).count, 0);
+}
+
+BOOST_AUTO_TEST_CASE(SummaryFollowsInsertAndErase)
+{
+  AVLTree< int, int > tree;
+  for (int i = 1; i <= 100; ++i) {
+    tree.insert({i, i * 10});
+  }
+  BOOST_CHECK_EQUAL(tree.summary().count, 100);
+  BOOST_CHECK_EQUAL(tree.summary().sum, 50500);
+  for (int i = 2; i <= 100; i += 2) {
+    tree.erase(i);
+  }
+  BOOST_CHECK_EQUAL(tree.summary().count, 50);
+  BOOST_CHECK_EQUAL(tree.summary().sum, 25000);
+}
+
+BOOST_AUTO_TEST_CASE(SummarizeRange)
+{
+  AVLTree< int, int > tree;
+  for (int i = 0; i < 64; ++i) {
+    tree.emplace(i * 3 % 64, 1);
+  }
+  tree.erase(10);
+  BOOST_CHECK_EQUAL(tree.summarize(5, 20).count, 15);
+  BOOST_CHECK_EQUAL(tree.summarize(-5, 0).count, 1);
+  BOOST_CHECK_EQUAL(tree.summarize(63, 100).count, 1);
+  BOOST_CHECK_EQUAL(tree.summarize(20, 5).count, 0);
+  BOOST_CHECK_EQUAL(tree.summarize(0, 63).count, 63);
+}
+
+BOOST_AUTO_TEST_CASE(UpdateRefreshesSummaries)
+{
+  AVLTree< int, int > tree;
+  for (int i = 1; i <= 100; ++i) {
+    tree.insert({i, 1});
+  }
+  auto it = tree.update(37, 1000);
+  BOOST_CHECK_EQUAL(it->first, 37);
+  BOOST_CHECK_EQUAL(it->second, 1000);
+  BOOST_CHECK_EQUAL(tree.at(37), 1000);
+  BOOST_CHECK_EQUAL(tree.summary().sum, 1099);
+  BOOST_CHECK_EQUAL(tree.summarize(30, 40).sum, 1010);
+  BOOST_CHECK_EQUAL(tree.summarize(38, 100).sum, 63);
+  tree.update(1, 0);
+  tree.update(100, 0);
+  BOOST_CHECK_EQUAL(tree.summary().sum, 1097);
+  BOOST_CHECK_EQUAL(tree.summary().count, 100);
+  BOOST_CHECK_THROW(tree.update(101, 1), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(SummaryTreeValuesAreReadOnly)
+{
+  AVLTree< int, int > tree({{1, 10}, {2, 20}});
+  BOOST_CHECK((std::is_same< decltype(tree.at(1)), const int& >::value));
+  BOOST_CHECK((std::is_same< decltype(tree[1]), const int& >::value));
+  BOOST_CHECK((std::is_same< decltype(*tree.begin()), const std::pair< int, int >& >::value));
+  BOOST_CHECK((std::is_same< decltype(AVLTree< int, std::string >().at(1)), std::string& >::value));
+  BOOST_CHECK_EQUAL(tree[3], 0);
+  BOOST_CHECK_EQUAL(tree.summary().count, 3);
+  BOOST_CHECK_EQUAL(tree.summary().sum, 30);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
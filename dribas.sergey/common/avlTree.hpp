@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <utility>
 
+#include "nodeSummary.hpp"
 #include "iterator.hpp"
 #include "constIterator.hpp"
 #include "stack.hpp"
@@ -21,6 +22,7 @@ namespace dribas
   struct Node
   {
     std::pair< Key, T > value;
+    typename NodeSummary< Key, T >::type summary;
     Node< Key, T >* left;
     Node< Key, T >* right;
     Node< Key, T >* parent;
@@ -37,6 +39,7 @@ namespace dribas
   template< class... Args >
   Node< Key, T >::Node(Node< Key, T >* fakeleaf, Args&&... args):
     value(std::forward< Args >(args)...),
+    summary(NodeSummary< Key, T >::make(value)),
     left(fakeleaf),
     right(fakeleaf),
     parent(nullptr),
@@ -49,6 +52,7 @@ namespace dribas
 
   template< class Key, class T >
   Node< Key, T >::Node():
+    summary(),
     left(nullptr),
     right(nullptr),
     parent(nullptr),
@@ -59,6 +63,7 @@ namespace dribas
   template< class Key, class T >
   Node< Key, T >::Node(const std::pair< Key, T >& val, Node< Key, T >* fakeleaf):
     value(val),
+    summary(NodeSummary< Key, T >::make(val)),
     left(fakeleaf),
     right(fakeleaf),
     parent(nullptr),
@@ -78,7 +83,15 @@ namespace dribas
     using const_iterator = ConstIterator< Key, T, Compare >;
     using TreeType = AVLTree< Key, T, Compare >;
     using NodeType = Node< Key, T >;
+    using SummaryTraits = NodeSummary< Key, T >;
+    static_assert(noexcept(SummaryTraits::make(std::declval< const std::pair< Key, T >& >())),
+      "NodeSummary::make must be noexcept");
+    static_assert(noexcept(SummaryTraits::merge(std::declval< typename SummaryTraits::type& >(),
+      std::declval< const typename SummaryTraits::type& >())), "NodeSummary::merge must be noexcept");
   public:
+    using summary_type = typename SummaryTraits::type;
+    using mapped_reference = typename SummaryAccess< Key, T >::mappedReference;
+
     AVLTree();
     AVLTree(const TreeType&);
     AVLTree(TreeType&&) noexcept;
@@ -89,9 +102,10 @@ namespace dribas
 
     TreeType& operator=(const TreeType&);
     TreeType& operator=(TreeType&&) noexcept;
-    T& at(const Key&);
+    mapped_reference at(const Key&);
     const T& at(const Key&) const;
-    T& operator[](const Key&);
+    mapped_reference operator[](const Key&);
+    iterator update(const Key&, const T&);
 
     std::pair< iterator, bool > insert(const std::pair< Key, T >&);
     std::pair< iterator, bool > insert(std::pair< Key, T >&&);
@@ -129,6 +143,9 @@ namespace dribas
     const_iterator find(const Key&) const;
     size_t count(const Key&) const;
 
+    const summary_type& summary() const noexcept;
+    summary_type summarize(const Key&, const Key&) const;
+
     template< class F >
     F traverse_lnr(F) const;
     template< class F >
@@ -150,6 +167,8 @@ namespace dribas
     void balanceTree(NodeType*);
     NodeType* balance(NodeType*) noexcept;
     void updateHeight(NodeType*) noexcept;
+    void updateSummary(NodeType*) noexcept;
+    void refreshSummaries(NodeType*) noexcept;
     int getBalanceFactor(NodeType*) const noexcept;
     NodeType* rightRotate(NodeType*) noexcept;
     NodeType* leftRotate(NodeType*) noexcept;
@@ -407,6 +426,54 @@ namespace dribas
     return find(key) != end();
   }
 
+  template< class Key, class T, class Compare >
+  const typename AVLTree< Key, T, Compare >::summary_type& AVLTree< Key, T, Compare >::summary() const noexcept
+  {
+    return root_->summary;
+  }
+
+  template< class Key, class T, class Compare >
+  typename AVLTree< Key, T, Compare >::summary_type
+  AVLTree< Key, T, Compare >::summarize(const Key& first, const Key& last) const
+  {
+    summary_type result{};
+    NodeType* split = root_;
+    while (split != fakeleaf_) {
+      if (cmp_(split->value.first, first)) {
+        split = split->right;
+      } else if (cmp_(last, split->value.first)) {
+        split = split->left;
+      } else {
+        break;
+      }
+    }
+    if (split == fakeleaf_) {
+      return result;
+    }
+    SummaryTraits::merge(result, SummaryTraits::make(split->value));
+    NodeType* current = split->left;
+    while (current != fakeleaf_) {
+      if (cmp_(current->value.first, first)) {
+        current = current->right;
+      } else {
+        SummaryTraits::merge(result, SummaryTraits::make(current->value));
+        SummaryTraits::merge(result, current->right->summary);
+        current = current->left;
+      }
+    }
+    current = split->right;
+    while (current != fakeleaf_) {
+      if (cmp_(last, current->value.first)) {
+        current = current->left;
+      } else {
+        SummaryTraits::merge(result, SummaryTraits::make(current->value));
+        SummaryTraits::merge(result, current->left->summary);
+        current = current->right;
+      }
+    }
+    return result;
+  }
+
   template< class Key, class T, class Compare >
   ConstIterator< Key, T, Compare > AVLTree< Key, T, Compare >::cend() const noexcept
   {
@@ -614,7 +681,7 @@ namespace dribas
   }
 
   template< class Key, class T, class Cmp >
-  T& AVLTree< Key, T, Cmp >::operator[](const Key& key)
+  typename AVLTree< Key, T, Cmp >::mapped_reference AVLTree< Key, T, Cmp >::operator[](const Key& key)
   {
     auto result = insert(std::make_pair(key, T()));
     return result.first->second;
@@ -631,7 +698,7 @@ namespace dribas
   }
 
   template< class Key, class T, class Cmp >
-  T& AVLTree< Key, T, Cmp >::at(const Key& key)
+  typename AVLTree< Key, T, Cmp >::mapped_reference AVLTree< Key, T, Cmp >::at(const Key& key)
   {
     NodeType* node = findNode(key);
     if (node == fakeleaf_) {
@@ -640,6 +707,18 @@ namespace dribas
     return node->value.second;
   }
 
+  template< class Key, class T, class Cmp >
+  Iterator< Key, T, Cmp > AVLTree< Key, T, Cmp >::update(const Key& key, const T& value)
+  {
+    NodeType* node = findNode(key);
+    if (node == fakeleaf_) {
+      throw std::out_of_range("Key not found in AVLTree");
+    }
+    node->value.second = value;
+    refreshSummaries(node);
+    return iterator(node, this);
+  }
+
   template< class Key, class T, class Cmp >
   void AVLTree< Key, T, Cmp >::insert(std::initializer_list< std::pair< Key, T > > il)
   {
@@ -825,6 +904,25 @@ namespace dribas
     }
   }
 
+  template< class Key, class T, class Cmp >
+  void AVLTree< Key, T, Cmp >::updateSummary(NodeType* node) noexcept
+  {
+    if (node != fakeleaf_) {
+      node->summary = SummaryTraits::make(node->value);
+      SummaryTraits::merge(node->summary, node->left->summary);
+      SummaryTraits::merge(node->summary, node->right->summary);
+    }
+  }
+
+  template< class Key, class T, class Cmp >
+  void AVLTree< Key, T, Cmp >::refreshSummaries(NodeType* node) noexcept
+  {
+    while (node != nullptr && node != fakeleaf_) {
+      updateSummary(node);
+      node = node->parent;
+    }
+  }
+
   template< class Key, class T, class Cmp >
   int AVLTree< Key, T, Cmp >::getBalanceFactor(NodeType* node) const noexcept
   {
@@ -856,6 +954,8 @@ namespace dribas
 
     updateHeight(node);
     updateHeight(leftNode);
+    updateSummary(node);
+    updateSummary(leftNode);
 
     return leftNode;
   }
@@ -882,6 +982,8 @@ namespace dribas
 
     updateHeight(node);
     updateHeight(rightNode);
+    updateSummary(node);
+    updateSummary(rightNode);
 
     return rightNode;
   }
@@ -893,6 +995,7 @@ namespace dribas
       return fakeleaf_;
     }
     updateHeight(node);
+    updateSummary(node);
     int balanceFactor = getBalanceFactor(node);
 
     if (balanceFactor > 1) {
@@ -3,6 +3,7 @@
 
 #include <utility>
 #include <functional>
+#include "nodeSummary.hpp"
 
 namespace dribas
 {
@@ -21,7 +22,7 @@ namespace dribas
     friend class ConstIterator< Key, T, Compare >;
     friend class AVLTree< Key, T, Compare >;
   public:
-    using valueType = std::pair< Key, T >;
+    using valueType = typename SummaryAccess< Key, T >::valueType;
     using TreeType = AVLTree< Key, T, Compare >;
     using NodeType = Node< Key, T >;
 
@@ -53,13 +54,13 @@ namespace dribas
   {}
 
   template< class Key, class T, class Compare >
-  std::pair< Key, T >& Iterator< Key, T, Compare >::operator*() noexcept
+  typename Iterator< Key, T, Compare >::valueType& Iterator< Key, T, Compare >::operator*() noexcept
   {
     return node_->value;
   }
 
   template< class Key, class T, class Compare >
-  std::pair< Key, T >* Iterator< Key, T, Compare >::operator->() noexcept
+  typename Iterator< Key, T, Compare >::valueType* Iterator< Key, T, Compare >::operator->() noexcept
   {
     return std::addressof(node_->value);
   }
@@ -0,0 +1,38 @@
+#ifndef NODESUMMARY_HPP
+#define NODESUMMARY_HPP
+
+#include <type_traits>
+#include <utility>
+
+namespace dribas
+{
+  template< class Key, class T >
+  struct NodeSummary
+  {
+    struct type
+    {};
+    static type make(const std::pair< Key, T >&) noexcept;
+    static void merge(type&, const type&) noexcept;
+  };
+
+  template< class Key, class T >
+  typename NodeSummary< Key, T >::type NodeSummary< Key, T >::make(const std::pair< Key, T >&) noexcept
+  {
+    return type{};
+  }
+
+  template< class Key, class T >
+  void NodeSummary< Key, T >::merge(type&, const type&) noexcept
+  {}
+
+  // values of a tree that keeps a summary are read-only, change them through AVLTree::update()
+  template< class Key, class T >
+  struct SummaryAccess
+  {
+    static constexpr bool isWritable = std::is_empty< typename NodeSummary< Key, T >::type >::value;
+    using mappedReference = std::conditional_t< isWritable, T&, const T& >;
+    using valueType = std::conditional_t< isWritable, std::pair< Key, T >, const std::pair< Key, T > >;
+  };
+}
+
+#endif
@@ -0,0 +1,102 @@
+#include "frequencyCounter.hpp"
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include "streamCodec.hpp"
+
+namespace
+{
+  constexpr size_t MIN_SLICE_SIZE = 1 << 22;
+  constexpr size_t MAX_THREADS = 16;
+
+  struct Slice
+  {
+    size_t begin;
+    size_t end;
+    size_t counts[256];
+    bool ok;
+  };
+
+  void count_slice(const std::string& filename, Slice& slice)
+  {
+    std::fill(slice.counts, slice.counts + 256, 0);
+    std::ifstream in(filename, std::ios::binary);
+    in.seekg(slice.begin);
+    std::unique_ptr< char[] > buffer(new char[duhanina::CHUNK_SIZE]);
+    size_t remaining = slice.end - slice.begin;
+    while (remaining > 0 && in)
+    {
+      in.read(buffer.get(), std::min(remaining, duhanina::CHUNK_SIZE));
+      const size_t read = static_cast< size_t >(in.gcount());
+      for (size_t i = 0; i < read; ++i)
+      {
+        ++slice.counts[static_cast< unsigned char >(buffer[i])];
+      }
+      remaining -= read;
+    }
+    slice.ok = remaining == 0;
+  }
+
+  size_t thread_count(size_t size)
+  {
+    size_t hardware = std::thread::hardware_concurrency();
+    size_t by_size = size / MIN_SLICE_SIZE;
+    return std::max< size_t >(1, std::min({ hardware, by_size, MAX_THREADS }));
+  }
+}
+
+duhanina::FrequencyTable duhanina::count_frequencies(const std::string& filename)
+{
+  std::ifstream in(filename, std::ios::binary | std::ios::ate);
+  if (!in)
+  {
+    throw std::runtime_error("FILE_NOT_FOUND");
+  }
+  const size_t size = static_cast< size_t >(in.tellg());
+  in.close();
+  const size_t threads = thread_count(size);
+  std::unique_ptr< Slice[] > slices(new Slice[threads]);
+  const size_t step = size / threads;
+  for (size_t i = 0; i < threads; ++i)
+  {
+    slices[i].begin = i * step;
+    slices[i].end = i + 1 == threads ? size : (i + 1) * step;
+  }
+  std::unique_ptr< std::thread[] > workers(new std::thread[threads - 1]);
+  size_t started = 0;
+  try
+  {
+    for (; started + 1 < threads; ++started)
+    {
+      workers[started] = std::thread(count_slice, std::cref(filename), std::ref(slices[started + 1]));
+    }
+    count_slice(filename, slices[0]);
+  }
+  catch (...)
+  {
+    for (size_t i = 0; i < started; ++i)
+    {
+      workers[i].join();
+    }
+    throw;
+  }
+  for (size_t i = 0; i < started; ++i)
+  {
+    workers[i].join();
+  }
+  FrequencyTable table{ {}, size };
+  for (size_t i = 0; i < threads; ++i)
+  {
+    if (!slices[i].ok)
+    {
+      throw std::runtime_error("READ_ERROR");
+    }
+    for (size_t c = 0; c < 256; ++c)
+    {
+      table.counts[c] += slices[i].counts[c];
+    }
+  }
+  return table;
+}
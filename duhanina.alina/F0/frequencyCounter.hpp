@@ -0,0 +1,18 @@
+#ifndef FREQUENCYCOUNTER_HPP
+#define FREQUENCYCOUNTER_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace duhanina
+{
+  struct FrequencyTable
+  {
+    size_t counts[256];
+    size_t total;
+  };
+
+  FrequencyTable count_frequencies(const std::string& filename);
+}
+
+#endif
@@ -2,9 +2,12 @@
 #include <fstream>
 #include <iomanip>
 #include <cmath>
+#include <chrono>
+#include <cstdio>
 #include <algorithm>
 #include <list.hpp>
-#include <array.hpp>
+#include "frequencyCounter.hpp"
+#include "streamCodec.hpp"
 
 namespace
 {
@@ -25,245 +28,86 @@ namespace
     }
   }
 
-  void build_shannon_fano_codes(duhanina::NodeSymb* node, std::string code, duhanina::Tree< char, std::string, std::less< char > >& codes)
+  struct SymbolFreq
   {
-    if (!node)
-    {
-      return;
-    }
-    if (node->left == nullptr && node->right == nullptr)
-    {
-      codes[node->symbol] = code;
-      return;
-    }
-    if (node->left != nullptr)
-    {
-      build_shannon_fano_codes(node->left, code + "0", codes);
-    }
-    if (node->right != nullptr)
-    {
-      build_shannon_fano_codes(node->right, code + "1", codes);
-    }
-  }
+    unsigned char symbol;
+    size_t freq;
+  };
 
-  void delete_tree(duhanina::NodeSymb* node)
+  bool by_frequency(const SymbolFreq& lhs, const SymbolFreq& rhs)
   {
-    if (node != nullptr)
+    if (lhs.freq != rhs.freq)
     {
-      delete_tree(node->left);
-      delete_tree(node->right);
-      delete node;
+      return lhs.freq > rhs.freq;
     }
+    return lhs.symbol < rhs.symbol;
   }
 
-  duhanina::NodeSymb* build_subtree(const duhanina::DynamicArray< duhanina::NodeSymb* >& nodes, size_t start, size_t end)
+  void split_codes(const SymbolFreq* symbols, const size_t* prefix, size_t start, size_t end, std::string& code, duhanina::CodeTable& table)
   {
-    if (start >= end || nodes.empty() || start >= nodes.size())
+    if (end - start == 1)
     {
-      return nullptr;
-    }
-    duhanina::NodeSymb* subtree = nodes[start];
-    for (size_t i = start + 1; i < end; i++)
-    {
-      duhanina::NodeSymb* new_node = nullptr;
-      try
-      {
-        new_node = new duhanina::NodeSymb(subtree->freq + nodes[i]->freq, subtree, nodes[i]);
-      }
-      catch (...)
-      {
-        delete_tree(subtree);
-        throw std::runtime_error("Error memory");
-      }
-      subtree = new_node;
-    }
-    return subtree;
-  }
-
-  std::pair< duhanina::NodeSymb*, duhanina::NodeSymb* > split_nodes(const duhanina::DynamicArray< duhanina::NodeSymb* >& nodes)
-  {
-    size_t total = 0;
-    for (size_t i = 0; i < nodes.size(); ++i)
-    {
-      total += nodes[i]->freq;
-    }
-    size_t sum = 0;
-    size_t split_pos = 0;
-    for (; split_pos < nodes.size(); split_pos++)
-    {
-      sum += nodes[split_pos]->freq;
-      if (sum >= total / 2)
-      {
-        break;
-      }
-    }
-    duhanina::NodeSymb* left = build_subtree(nodes, 0, split_pos);
-    duhanina::NodeSymb* right = build_subtree(nodes, split_pos + 1, nodes.size());
-    return { left, right };
-  }
-
-  duhanina::DynamicArray< duhanina::NodeSymb* > merge_nodes(duhanina::NodeSymb* left, duhanina::NodeSymb* right)
-  {
-    duhanina::DynamicArray< duhanina::NodeSymb* > new_nodes;
-    if (left)
-    {
-      new_nodes.push_back(left);
+      char ch = static_cast< char >(symbols[start].symbol);
+      table.char_to_code[ch] = code;
+      table.code_to_char[code] = ch;
+      return;
     }
-    if (right)
+    size_t half = prefix[start] + (prefix[end] - prefix[start]) / 2;
+    size_t split = std::lower_bound(prefix + start + 1, prefix + end, half) - prefix;
+    if (split > start + 1 && half - prefix[split - 1] <= prefix[split] - half)
     {
-      new_nodes.push_back(right);
+      --split;
     }
-    return new_nodes;
+    code.push_back('0');
+    split_codes(symbols, prefix, start, split, code, table);
+    code.back() = '1';
+    split_codes(symbols, prefix, split, end, code, table);
+    code.pop_back();
   }
 
-  duhanina::CodeTable build_code_table(str_t text)
+  duhanina::CodeTable build_code_table(const duhanina::FrequencyTable& freq)
   {
-    if (text.empty())
+    if (freq.total == 0)
     {
       throw std::runtime_error("EMPTY");
     }
-    duhanina::Tree< char, size_t, std::less< char > > freq_map;
-    for (size_t i = 0; i < text.size(); i++)
+    SymbolFreq symbols[256];
+    size_t count = 0;
+    for (size_t c = 0; c < 256; ++c)
     {
-      char c = text[i];
-      freq_map[c]++;
-    }
-    if (freq_map.size() == 1)
-    {
-      throw std::runtime_error("SINGLE_SYMBOL");
-    }
-    duhanina::DynamicArray< std::pair< char, size_t > > sorted_freq;
-    for (auto it = freq_map.begin(); it != freq_map.end(); ++it)
-    {
-      sorted_freq.push_back(*it);
-    }
-    for (size_t i = 0; i < sorted_freq.size(); i++)
-    {
-      for (size_t j = i + 1; j < sorted_freq.size(); j++)
+      if (freq.counts[c] > 0)
       {
-        if (sorted_freq[i].second < sorted_freq[j].second)
-        {
-          std::swap(sorted_freq[i], sorted_freq[j]);
-        }
+        symbols[count++] = { static_cast< unsigned char >(c), freq.counts[c] };
       }
     }
-    duhanina::DynamicArray< duhanina::NodeSymb* > nodes;
-    try
+    if (count == 1)
     {
-      for (size_t i = 0; i < sorted_freq.size(); i++)
-      {
-        char ch = sorted_freq[i].first;
-        size_t freq = sorted_freq[i].second;
-        nodes.push_back(new duhanina::NodeSymb(ch, freq));
-      }
-    }
-    catch (...)
-    {
-      for (size_t i = 0; i < nodes.size(); i++)
-      {
-        delete nodes[i];
-        nodes[i] = nullptr;
-      }
-      throw std::runtime_error("Error memory");
+      throw std::runtime_error("SINGLE_SYMBOL");
     }
-    while (nodes.size() > 1)
+    std::sort(symbols, symbols + count, by_frequency);
+    size_t prefix[257] = {};
+    for (size_t i = 0; i < count; ++i)
     {
-      auto node_pair = split_nodes(nodes);
-      nodes = merge_nodes(node_pair.first, node_pair.second);
+      prefix[i + 1] = prefix[i] + symbols[i].freq;
     }
     duhanina::CodeTable table;
-    table.total_chars = text.size();
-    build_shannon_fano_codes(nodes[0], "", table.char_to_code);
-    for (auto it = table.char_to_code.begin(); it != table.char_to_code.end(); ++it)
-    {
-      char ch = it->first;
-      std::string code = it->second;
-      table.code_to_char[code] = ch;
-    }
-    delete_tree(nodes[0]);
+    table.total_chars = freq.total;
+    std::string code;
+    split_codes(symbols, prefix, 0, count, code, table);
     return table;
   }
 
-  std::string encode_text(str_t text, const duhanina::CodeTable& table)
-  {
-    std::string encoded;
-    for (size_t i = 0; i < text.size(); i++)
-    {
-      char c = text[i];
-      auto it = table.char_to_code.find(c);
-      if (it == table.char_to_code.cend())
-      {
-        throw std::runtime_error("INVALID_CODES");
-      }
-      encoded += it->second;
-    }
-    return encoded;
-  }
-
-  std::string decode_text(str_t encoded, const duhanina::CodeTable& table)
-  {
-    std::string decoded;
-    std::string current_code;
-    for (size_t i = 0; i < encoded.size(); i++)
-    {
-      char bit = encoded[i];
-      current_code += bit;
-      auto it = table.code_to_char.find(current_code);
-      if (it != table.code_to_char.cend())
-      {
-        decoded += it->second;
-        current_code.clear();
-      }
-    }
-    if (!current_code.empty())
-    {
-      throw std::runtime_error("INVALID_CODES");
-    }
-    return decoded;
-  }
-
-  void write_bits_to_file(str_t bits, str_t filename)
+  void write_header(std::ostream& out, size_t bit_count)
   {
-    std::ofstream out(filename, std::ios::binary);
-    if (!out)
-    {
-      throw std::runtime_error("INVALID_FILE");
-    }
-    size_t bit_count = bits.size();
     for (size_t i = 0; i < sizeof(size_t); i++)
     {
       char byte = (bit_count >> (8 * i)) & 0xFF;
       out.put(byte);
     }
-    char buffer = 0;
-    size_t bit_pos = 0;
-    for (size_t i = 0; i < bits.size(); i++)
-    {
-      if (bits[i] == '1')
-      {
-        buffer |= (1 << (7 - bit_pos));
-      }
-      bit_pos++;
-      if (bit_pos == 8)
-      {
-        out.put(buffer);
-        buffer = 0;
-        bit_pos = 0;
-      }
-    }
-    if (bit_pos > 0)
-    {
-      out.put(buffer);
-    }
   }
 
-  std::string read_bits_from_file(str_t filename)
+  size_t read_header(std::istream& in)
   {
-    std::ifstream in(filename, std::ios::binary);
-    if (!in)
-    {
-      throw std::runtime_error("FILE_NOT_FOUND");
-    }
     size_t bit_count = 0;
     for (size_t i = 0; i < sizeof(size_t); i++)
     {
@@ -274,28 +118,17 @@ namespace
       }
       bit_count |= static_cast< size_t >(static_cast< unsigned char >(byte)) << (8 * i);
     }
-    std::string bits;
-    bits.reserve(bit_count);
-    char byte;
-    while (in.get(byte) && bits.size() < bit_count)
-    {
-      for (size_t i = 0; i < 8 && bits.size() < bit_count; i++)
-      {
-        if (byte & (1 << (7 - i)))
-        {
-          bits += '1';
-        }
-        else
-        {
-          bits += '0';
-        }
-      }
-    }
-    if (bits.size() != bit_count)
+    return bit_count;
+  }
+
+  double throughput(size_t bytes, std::chrono::steady_clock::time_point start)
+  {
+    std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+    if (elapsed.count() <= 0.0)
     {
-      throw std::runtime_error("TRUNCATED_FILE");
+      return 0.0;
     }
-    return bits;
+    return bytes / elapsed.count() / 1e6;
   }
 
   void save_code_table(const duhanina::CodeTable& table, str_t filename)
@@ -344,39 +177,74 @@ namespace
 
   void encode_file_impl(str_t input_file, str_t output_file, const duhanina::CodeTable& table, std::ostream& out)
   {
-    std::ifstream in(input_file);
+    std::ifstream in(input_file, std::ios::binary);
     if (!in)
     {
       throw std::runtime_error("FILE_NOT_FOUND");
     }
-    std::string text;
-    char ch;
-    while (in.get(ch))
+    std::ofstream out_file(output_file, std::ios::binary);
+    if (!out_file)
     {
-      text += ch;
+      throw std::runtime_error("INVALID_FILE");
+    }
+    auto start = std::chrono::steady_clock::now();
+    duhanina::StreamStats stats{ 0, 0 };
+    try
+    {
+      duhanina::StreamEncoder encoder(table);
+      write_header(out_file, 0);
+      stats = encoder.encode(in, out_file);
+      out_file.seekp(0);
+      write_header(out_file, stats.bits);
+      out_file.close();
     }
-    std::string encoded = encode_text(text, table);
-    write_bits_to_file(encoded, output_file);
-    double original_size = text.size();
-    double compressed_size = std::ceil(encoded.size() / 8.0) + sizeof(size_t);
+    catch (...)
+    {
+      out_file.close();
+      std::remove(output_file.c_str());
+      throw;
+    }
+    double speed = throughput(stats.bytes, start);
+    double original_size = stats.bytes;
+    double compressed_size = std::ceil(stats.bits / 8.0) + sizeof(size_t);
     double ratio = (compressed_size / original_size) * 100;
     out << "File successfully compressed:\n";
     out << "Original size: " << original_size << " bytes\n";
     out << "Compressed size: " << compressed_size << " bytes\n";
     out << "Compression ratio: " << std::fixed << std::setprecision(2) << ratio << "%\n";
+    out << "Throughput: " << speed << " MB/s\n";
   }
 
   void decode_file_impl(str_t input_file, str_t output_file, const duhanina::CodeTable& table, std::ostream& out)
   {
-    std::string encoded = read_bits_from_file(input_file);
-    std::string decoded = decode_text(encoded, table);
-    std::ofstream out_file(output_file);
+    std::ifstream in(input_file, std::ios::binary);
+    if (!in)
+    {
+      throw std::runtime_error("FILE_NOT_FOUND");
+    }
+    size_t bit_count = read_header(in);
+    duhanina::StreamDecoder decoder(table);
+    std::ofstream out_file(output_file, std::ios::binary);
     if (!out_file)
     {
       throw std::runtime_error("INVALID_FILE");
     }
-    out_file << decoded;
+    auto start = std::chrono::steady_clock::now();
+    duhanina::StreamStats stats{ 0, 0 };
+    try
+    {
+      stats = decoder.decode(in, bit_count, out_file);
+      out_file.close();
+    }
+    catch (...)
+    {
+      out_file.close();
+      std::remove(output_file.c_str());
+      throw;
+    }
+    double speed = throughput(std::ceil(stats.bits / 8.0), start);
     out << "File successfully decompressed to '" << output_file << "'\n";
+    out << "Throughput: " << std::fixed << std::setprecision(2) << speed << " MB/s\n";
   }
 
   duhanina::List< char > find_missing_chars(str_t text, const duhanina::Tree< char, std::string, std::less< char > >& char_to_code)
@@ -423,18 +291,7 @@ void duhanina::build_codes(str_t input_file, str_t encoding_id, std::ostream& ou
   {
     throw std::runtime_error("ID_EXISTS");
   }
-  std::ifstream in(input_file);
-  if (!in)
-  {
-    throw std::runtime_error("FILE_NOT_FOUND");
-  }
-  std::string text;
-  char ch;
-  while (in.get(ch))
-  {
-    text += ch;
-  }
-  CodeTable table = build_code_table(text);
+  CodeTable table = build_code_table(count_frequencies(input_file));
   encoding_store[encoding_id] = table;
   out << "Code table successfully built and saved with ID '" << encoding_id << "'\n";
 }
@@ -576,13 +433,13 @@ void duhanina::compare(str_t file1, str_t file2, str_t encod_id1, str_t encod_id
   {
     throw std::runtime_error("IDENTICAL_TEXTS");
   }
-  std::string encoded1 = encode_text(text1, it1->second);
-  std::string encoded2 = encode_text(text2, it2->second);
+  size_t encoded1 = StreamEncoder(it1->second).encoded_bits(text1.data(), text1.size());
+  size_t encoded2 = StreamEncoder(it2->second).encoded_bits(text2.data(), text2.size());
   double size1_orig = text1.size();
-  double size1_comp = std::ceil(encoded1.size() / 8.0) + sizeof(size_t);
+  double size1_comp = std::ceil(encoded1 / 8.0) + sizeof(size_t);
   double ratio1 = size1_comp / size1_orig;
   double size2_orig = text2.size();
-  double size2_comp = std::ceil(encoded2.size() / 8.0) + sizeof(size_t);
+  double size2_comp = std::ceil(encoded2 / 8.0) + sizeof(size_t);
   double ratio2 = size2_comp / size2_orig;
   out << "Compression efficiency comparison:\n";
   out << "----------------------------------------\n";
@@ -664,24 +521,18 @@ void duhanina::check_encoding(str_t input_file, str_t encoding_id, std::ostream&
 
 void duhanina::suggest_encodings(str_t input_file, std::ostream& out)
 {
-  std::ifstream in(input_file);
-  if (!in)
-  {
-    throw std::runtime_error("FILE_NOT_FOUND");
-  }
-  std::string text;
-  char ch;
-  while (in.get(ch))
-  {
-    text += ch;
-  }
+  FrequencyTable freq = count_frequencies(input_file);
   out << "Encoding compatibility report:\n";
   for (auto encoding_it = encoding_store.begin(); encoding_it != encoding_store.end(); ++encoding_it)
   {
     str_t id = encoding_it->first;
     const CodeTable& table = encoding_it->second;
-    duhanina::List< char > missing = find_missing_chars(text, table.char_to_code);
-    if (missing.empty())
+    bool supported = true;
+    for (size_t c = 0; c < 256 && supported; ++c)
+    {
+      supported = freq.counts[c] == 0 || table.char_to_code.find(static_cast< char >(c)) != table.char_to_code.cend();
+    }
+    if (supported)
     {
       out << " - " << id << ": " << "FULL" << " support\n";
     }
@@ -15,28 +15,6 @@ namespace duhanina
     size_t total_chars = 0;
   };
 
-  struct NodeSymb
-  {
-    char symbol;
-    size_t freq;
-    NodeSymb* left;
-    NodeSymb* right;
-
-    NodeSymb(char s, size_t f):
-      symbol(s),
-      freq(f),
-      left(nullptr),
-      right(nullptr)
-    {}
-
-    NodeSymb(size_t f, NodeSymb* l, NodeSymb* r):
-      symbol(0),
-      freq(f),
-      left(l),
-      right(r)
-    {}
-  };
-
   using str_t = const std::string&;
 
   void print_help(std::ostream& out);
@@ -0,0 +1,255 @@
+#include "streamCodec.hpp"
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+namespace
+{
+  constexpr uint32_t NO_NODE = 0xFFFFFFFF;
+  constexpr size_t MAX_TABLE_NODES = 1024;
+  constexpr size_t PIECE_BITS = 32;
+
+  size_t read_chunk(std::istream& in, char* buffer)
+  {
+    in.read(buffer, duhanina::CHUNK_SIZE);
+    return static_cast< size_t >(in.gcount());
+  }
+}
+
+duhanina::BitWriter::BitWriter(std::ostream& out):
+  out_(out),
+  acc_(0),
+  acc_bits_(0),
+  total_bits_(0),
+  buffer_(new char[CHUNK_SIZE]),
+  buffered_(0)
+{}
+
+void duhanina::BitWriter::put(uint32_t bits, size_t count)
+{
+  acc_ = (acc_ << count) | bits;
+  acc_bits_ += count;
+  total_bits_ += count;
+  while (acc_bits_ >= 8)
+  {
+    acc_bits_ -= 8;
+    buffer_[buffered_++] = static_cast< char >((acc_ >> acc_bits_) & 0xFF);
+    if (buffered_ == CHUNK_SIZE)
+    {
+      out_.write(buffer_.get(), buffered_);
+      buffered_ = 0;
+    }
+  }
+}
+
+void duhanina::BitWriter::flush()
+{
+  if (acc_bits_ > 0)
+  {
+    buffer_[buffered_++] = static_cast< char >((acc_ << (8 - acc_bits_)) & 0xFF);
+    acc_bits_ = 0;
+  }
+  out_.write(buffer_.get(), buffered_);
+  buffered_ = 0;
+  if (!out_)
+  {
+    throw std::runtime_error("INVALID_FILE");
+  }
+}
+
+size_t duhanina::BitWriter::bit_count() const noexcept
+{
+  return total_bits_;
+}
+
+duhanina::StreamEncoder::StreamEncoder(const CodeTable& table):
+  pieces_(nullptr),
+  first_(),
+  last_(),
+  length_()
+{
+  size_t total = 0;
+  for (auto it = table.char_to_code.cbegin(); it != table.char_to_code.cend(); ++it)
+  {
+    total += (it->second.size() + PIECE_BITS - 1) / PIECE_BITS;
+  }
+  pieces_.reset(new Piece[total]);
+  size_t next = 0;
+  for (auto it = table.char_to_code.cbegin(); it != table.char_to_code.cend(); ++it)
+  {
+    const unsigned char symbol = static_cast< unsigned char >(it->first);
+    const std::string& code = it->second;
+    first_[symbol] = next;
+    length_[symbol] = code.size();
+    for (size_t pos = 0; pos < code.size(); pos += PIECE_BITS)
+    {
+      Piece piece{ 0, 0 };
+      for (size_t i = pos; i < code.size() && piece.count < PIECE_BITS; ++i, ++piece.count)
+      {
+        piece.bits = (piece.bits << 1) | (code[i] == '1' ? 1 : 0);
+      }
+      pieces_[next++] = piece;
+    }
+    last_[symbol] = next;
+  }
+}
+
+duhanina::StreamStats duhanina::StreamEncoder::encode(std::istream& in, std::ostream& out) const
+{
+  std::unique_ptr< char[] > buffer(new char[CHUNK_SIZE]);
+  BitWriter writer(out);
+  size_t bytes = 0;
+  size_t read = 0;
+  while ((read = read_chunk(in, buffer.get())) > 0)
+  {
+    for (size_t i = 0; i < read; ++i)
+    {
+      const unsigned char symbol = static_cast< unsigned char >(buffer[i]);
+      if (length_[symbol] == 0)
+      {
+        throw std::runtime_error("INVALID_CODES");
+      }
+      for (size_t j = first_[symbol]; j < last_[symbol]; ++j)
+      {
+        writer.put(pieces_[j].bits, pieces_[j].count);
+      }
+    }
+    bytes += read;
+  }
+  writer.flush();
+  return { bytes, writer.bit_count() };
+}
+
+size_t duhanina::StreamEncoder::encoded_bits(const char* data, size_t size) const
+{
+  size_t bits = 0;
+  for (size_t i = 0; i < size; ++i)
+  {
+    const size_t length = length_[static_cast< unsigned char >(data[i])];
+    if (length == 0)
+    {
+      throw std::runtime_error("INVALID_CODES");
+    }
+    bits += length;
+  }
+  return bits;
+}
+
+duhanina::StreamDecoder::StreamDecoder(const CodeTable& table):
+  trie_(nullptr),
+  trie_size_(1),
+  steps_(nullptr)
+{
+  size_t capacity = 1;
+  for (auto it = table.code_to_char.cbegin(); it != table.code_to_char.cend(); ++it)
+  {
+    capacity += it->first.size();
+  }
+  trie_.reset(new TrieNode[capacity]);
+  trie_[0] = TrieNode{ { NO_NODE, NO_NODE }, -1 };
+  for (auto it = table.code_to_char.cbegin(); it != table.code_to_char.cend(); ++it)
+  {
+    const std::string& code = it->first;
+    if (code.find_first_not_of("01") != std::string::npos)
+    {
+      continue;
+    }
+    uint32_t node = 0;
+    for (size_t i = 0; i < code.size(); ++i)
+    {
+      uint32_t& child = trie_[node].child[code[i] - '0'];
+      if (child == NO_NODE)
+      {
+        child = static_cast< uint32_t >(trie_size_);
+        trie_[trie_size_++] = TrieNode{ { NO_NODE, NO_NODE }, -1 };
+      }
+      node = child;
+    }
+    trie_[node].symbol = static_cast< unsigned char >(it->second);
+  }
+  if (trie_size_ > MAX_TABLE_NODES)
+  {
+    return;
+  }
+  steps_.reset(new Step[trie_size_ * 256]);
+  for (uint32_t state = 0; state < trie_size_; ++state)
+  {
+    for (size_t byte = 0; byte < 256; ++byte)
+    {
+      Step& step = steps_[state * 256 + byte];
+      size_t count = 0;
+      step.next = walk(state, static_cast< unsigned char >(byte), 8, step.symbols, count);
+      step.count = static_cast< unsigned char >(count);
+    }
+  }
+}
+
+uint32_t duhanina::StreamDecoder::walk(uint32_t state, unsigned char byte, size_t bits, char* symbols, size_t& count) const
+{
+  for (size_t i = 0; i < bits && state != NO_NODE; ++i)
+  {
+    state = trie_[state].child[(byte >> (7 - i)) & 1];
+    if (state != NO_NODE && trie_[state].symbol >= 0)
+    {
+      symbols[count++] = static_cast< char >(trie_[state].symbol);
+      state = 0;
+    }
+  }
+  return state;
+}
+
+duhanina::StreamStats duhanina::StreamDecoder::decode(std::istream& in, size_t bit_count, std::ostream& out) const
+{
+  std::unique_ptr< char[] > input(new char[CHUNK_SIZE]);
+  std::unique_ptr< char[] > output(new char[CHUNK_SIZE + 8]);
+  size_t produced = 0;
+  size_t bytes = 0;
+  size_t remaining = bit_count;
+  uint32_t state = 0;
+  while (remaining > 0 && state != NO_NODE)
+  {
+    const size_t read = read_chunk(in, input.get());
+    if (read == 0)
+    {
+      throw std::runtime_error("TRUNCATED_FILE");
+    }
+    for (size_t i = 0; i < read && remaining > 0 && state != NO_NODE; ++i)
+    {
+      const unsigned char byte = static_cast< unsigned char >(input[i]);
+      if (steps_ && remaining >= 8)
+      {
+        const Step& step = steps_[state * 256 + byte];
+        for (size_t j = 0; j < step.count; ++j)
+        {
+          output[produced + j] = step.symbols[j];
+        }
+        produced += step.count;
+        state = step.next;
+        remaining -= 8;
+      }
+      else
+      {
+        const size_t bits = remaining < 8 ? remaining : 8;
+        state = walk(state, byte, bits, output.get(), produced);
+        remaining -= bits;
+      }
+      if (produced >= CHUNK_SIZE)
+      {
+        out.write(output.get(), produced);
+        bytes += produced;
+        produced = 0;
+      }
+    }
+  }
+  if (state != 0)
+  {
+    throw std::runtime_error("INVALID_CODES");
+  }
+  out.write(output.get(), produced);
+  bytes += produced;
+  if (!out)
+  {
+    throw std::runtime_error("INVALID_FILE");
+  }
+  return { bytes, bit_count };
+}
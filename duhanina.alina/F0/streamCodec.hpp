@@ -0,0 +1,88 @@
+#ifndef STREAMCODEC_HPP
+#define STREAMCODEC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include "shannonFano.hpp"
+
+namespace duhanina
+{
+  constexpr size_t CHUNK_SIZE = 1 << 16;
+
+  struct StreamStats
+  {
+    size_t bytes;
+    size_t bits;
+  };
+
+  class BitWriter
+  {
+  public:
+    explicit BitWriter(std::ostream& out);
+
+    void put(uint32_t bits, size_t count);
+    void flush();
+    size_t bit_count() const noexcept;
+
+  private:
+    std::ostream& out_;
+    uint64_t acc_;
+    size_t acc_bits_;
+    size_t total_bits_;
+    std::unique_ptr< char[] > buffer_;
+    size_t buffered_;
+  };
+
+  class StreamEncoder
+  {
+  public:
+    explicit StreamEncoder(const CodeTable& table);
+
+    StreamStats encode(std::istream& in, std::ostream& out) const;
+    size_t encoded_bits(const char* data, size_t size) const;
+
+  private:
+    struct Piece
+    {
+      uint32_t bits;
+      size_t count;
+    };
+
+    std::unique_ptr< Piece[] > pieces_;
+    size_t first_[256];
+    size_t last_[256];
+    size_t length_[256];
+  };
+
+  class StreamDecoder
+  {
+  public:
+    explicit StreamDecoder(const CodeTable& table);
+
+    StreamStats decode(std::istream& in, size_t bit_count, std::ostream& out) const;
+
+  private:
+    struct TrieNode
+    {
+      uint32_t child[2];
+      int symbol;
+    };
+
+    struct Step
+    {
+      uint32_t next;
+      unsigned char count;
+      char symbols[8];
+    };
+
+    std::unique_ptr< TrieNode[] > trie_;
+    size_t trie_size_;
+    std::unique_ptr< Step[] > steps_;
+
+    uint32_t walk(uint32_t state, unsigned char byte, size_t bits, char* symbols, size_t& count) const;
+  };
+}
+
+#endif
@@ -0,0 +1,63 @@
+#include "RankingIndex.hpp"
+
+bool gavrilova::HigherAverageFirst::operator()(const RankKey& a, const RankKey& b) const
+{
+  if (a.average == b.average) return a.id < b.id;
+  return a.average > b.average;
+}
+
+bool gavrilova::LowerAverageFirst::operator()(const RankKey& a, const RankKey& b) const
+{
+  if (a.average == b.average) return a.id < b.id;
+  return a.average < b.average;
+}
+
+void gavrilova::RankingIndex::insert(const StudentPtr& student)
+{
+  RankKey key{student->averageGrade_, student->id_};
+  byRank_.insert({key, StudentRef(student)});
+  if (!student->grades_.empty()) {
+    graded_.insert({key, StudentRef(student)});
+  }
+}
+
+void gavrilova::RankingIndex::erase(const student::Student& student)
+{
+  RankKey key{student.averageGrade_, student.id_};
+  byRank_.erase(key);
+  graded_.erase(key);
+}
+
+void gavrilova::RankingIndex::clear() noexcept
+{
+  byRank_.clear();
+  graded_.clear();
+}
+
+gavrilova::RankingIndex::ConstStudentList gavrilova::RankingIndex::top(size_t n) const
+{
+  ConstStudentList result;
+  auto it = byRank_.cbegin();
+  for (size_t i = 0; i < n && it != byRank_.cend(); ++it) {
+    SharedPtr< const student::Student > student = it->second.lock();
+    if (student) {
+      result.push_front(student);
+      ++i;
+    }
+  }
+  result.reverse();
+  return result;
+}
+
+gavrilova::RankingIndex::ConstStudentList gavrilova::RankingIndex::below(double threshold) const
+{
+  ConstStudentList result;
+  for (auto it = graded_.cbegin(); it != graded_.cend() && it->first.average < threshold; ++it) {
+    SharedPtr< const student::Student > student = it->second.lock();
+    if (student) {
+      result.push_front(student);
+    }
+  }
+  result.reverse();
+  return result;
+}
@@ -0,0 +1,43 @@
+#ifndef RANKING_INDEX_HPP
+#define RANKING_INDEX_HPP
+
+#include <cstddef>
+#include "Containers.hpp"
+#include "SharedPointer.hpp"
+#include "Student.hpp"
+
+namespace gavrilova {
+
+  struct RankKey {
+    double average;
+    StudentID id;
+  };
+
+  struct HigherAverageFirst {
+    bool operator()(const RankKey& a, const RankKey& b) const;
+  };
+
+  struct LowerAverageFirst {
+    bool operator()(const RankKey& a, const RankKey& b) const;
+  };
+
+  class RankingIndex {
+  public:
+    using StudentPtr = SharedPtr< student::Student >;
+    using StudentRef = WeakPtr< student::Student >;
+    using ConstStudentList = FwdList< SharedPtr< const student::Student > >;
+
+    void insert(const StudentPtr& student);
+    void erase(const student::Student& student);
+    void clear() noexcept;
+
+    ConstStudentList top(size_t n) const;
+    ConstStudentList below(double threshold) const;
+
+  private:
+    map< RankKey, StudentRef, HigherAverageFirst > byRank_;
+    map< RankKey, StudentRef, LowerAverageFirst > graded_;
+  };
+}
+
+#endif
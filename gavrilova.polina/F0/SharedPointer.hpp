@@ -1,12 +1,64 @@
-
 #ifndef SHARED_POINTER_HPP
 #define SHARED_POINTER_HPP
 
 #include <cstddef>
+#include <new>
 #include <utility>
 
 namespace gavrilova {
 
+  namespace detail {
+    class ControlBlock {
+    public:
+      ControlBlock() noexcept;
+      ControlBlock(const ControlBlock&) = delete;
+      ControlBlock& operator=(const ControlBlock&) = delete;
+
+      void add_shared() noexcept;
+      bool try_add_shared() noexcept;
+      void release_shared() noexcept;
+      void add_weak() noexcept;
+      void release_weak() noexcept;
+      size_t use_count() const noexcept;
+
+    protected:
+      virtual ~ControlBlock() = default;
+      virtual void destroy_object() noexcept = 0;
+
+    private:
+      size_t shared_count_;
+      size_t weak_count_;
+    };
+
+    template < typename T >
+    class PointerBlock final: public ControlBlock {
+    public:
+      explicit PointerBlock(T* ptr) noexcept;
+
+    private:
+      T* ptr_;
+
+      void destroy_object() noexcept override;
+    };
+
+    template < typename T >
+    class InplaceBlock final: public ControlBlock {
+    public:
+      template < typename... Args >
+      explicit InplaceBlock(Args&&... args);
+
+      T* get() noexcept;
+
+    private:
+      alignas(T) unsigned char storage_[sizeof(T)];
+
+      void destroy_object() noexcept override;
+    };
+  }
+
+  template < typename T >
+  class WeakPtr;
+
   template < typename T >
   class SharedPtr {
   public:
@@ -25,60 +77,177 @@ namespace gavrilova {
     T& operator*() const noexcept;
     T* operator->() const noexcept;
     operator bool() const noexcept;
+    size_t use_count() const noexcept;
 
   private:
+    SharedPtr(T* ptr, detail::ControlBlock* block) noexcept;
     void release();
 
     T* ptr_;
-    size_t* ref_count_;
+    detail::ControlBlock* block_;
 
     template < class U >
     friend class SharedPtr;
+    template < class U >
+    friend class WeakPtr;
+    template < typename U, typename... Args >
+    friend SharedPtr< U > make_shared(Args&&... args);
+  };
+
+  template < typename T >
+  class WeakPtr {
+  public:
+    WeakPtr() noexcept;
+    template < class U >
+    WeakPtr(const SharedPtr< U >& shared) noexcept;
+    WeakPtr(const WeakPtr& other) noexcept;
+    WeakPtr(WeakPtr&& other) noexcept;
+    ~WeakPtr();
+
+    WeakPtr& operator=(const WeakPtr& other) noexcept;
+    WeakPtr& operator=(WeakPtr&& other) noexcept;
+
+    bool expired() const noexcept;
+    SharedPtr< T > lock() const noexcept;
+    void reset() noexcept;
+
+  private:
+    T* ptr_;
+    detail::ControlBlock* block_;
   };
 
   template < typename T, typename... Args >
   SharedPtr< T > make_shared(Args&&... args);
 
+  inline detail::ControlBlock::ControlBlock() noexcept:
+    shared_count_(1),
+    weak_count_(1)
+  {}
+
+  inline void detail::ControlBlock::add_shared() noexcept
+  {
+    ++shared_count_;
+  }
+
+  inline bool detail::ControlBlock::try_add_shared() noexcept
+  {
+    if (shared_count_ == 0) {
+      return false;
+    }
+    ++shared_count_;
+    return true;
+  }
+
+  inline void detail::ControlBlock::release_shared() noexcept
+  {
+    if (--shared_count_ == 0) {
+      destroy_object();
+      release_weak();
+    }
+  }
+
+  inline void detail::ControlBlock::add_weak() noexcept
+  {
+    ++weak_count_;
+  }
+
+  inline void detail::ControlBlock::release_weak() noexcept
+  {
+    if (--weak_count_ == 0) {
+      delete this;
+    }
+  }
+
+  inline size_t detail::ControlBlock::use_count() const noexcept
+  {
+    return shared_count_;
+  }
+
+  template < typename T >
+  detail::PointerBlock< T >::PointerBlock(T* ptr) noexcept:
+    ptr_(ptr)
+  {}
+
+  template < typename T >
+  void detail::PointerBlock< T >::destroy_object() noexcept
+  {
+    delete ptr_;
+  }
+
+  template < typename T >
+  template < typename... Args >
+  detail::InplaceBlock< T >::InplaceBlock(Args&&... args)
+  {
+    new (storage_) T(std::forward< Args >(args)...);
+  }
+
+  template < typename T >
+  T* detail::InplaceBlock< T >::get() noexcept
+  {
+    return reinterpret_cast< T* >(storage_);
+  }
+
+  template < typename T >
+  void detail::InplaceBlock< T >::destroy_object() noexcept
+  {
+    get()->~T();
+  }
+
   template < typename T >
   SharedPtr< T >::SharedPtr() noexcept:
     ptr_(nullptr),
-    ref_count_(nullptr)
+    block_(nullptr)
   {}
 
   template < typename T >
   template < class U >
   SharedPtr< T >::SharedPtr(const SharedPtr< U >& other) noexcept:
     ptr_(other.get()),
-    ref_count_(other.ref_count_)
+    block_(other.block_)
   {
-    if (ref_count_) {
-      (*ref_count_)++;
+    if (block_) {
+      block_->add_shared();
     }
   }
 
   template < typename T >
   SharedPtr< T >::SharedPtr(T* ptr):
     ptr_(ptr),
-    ref_count_(new size_t(1))
+    block_(nullptr)
+  {
+    if (ptr_) {
+      try {
+        block_ = new detail::PointerBlock< T >(ptr_);
+      } catch (...) {
+        delete ptr_;
+        throw;
+      }
+    }
+  }
+
+  template < typename T >
+  SharedPtr< T >::SharedPtr(T* ptr, detail::ControlBlock* block) noexcept:
+    ptr_(ptr),
+    block_(block)
   {}
 
   template < typename T >
   SharedPtr< T >::SharedPtr(const SharedPtr& other) noexcept:
     ptr_(other.ptr_),
-    ref_count_(other.ref_count_)
+    block_(other.block_)
   {
-    if (ref_count_) {
-      (*ref_count_)++;
+    if (block_) {
+      block_->add_shared();
     }
   }
 
   template < typename T >
   SharedPtr< T >::SharedPtr(SharedPtr&& other) noexcept:
     ptr_(other.ptr_),
-    ref_count_(other.ref_count_)
+    block_(other.block_)
   {
     other.ptr_ = nullptr;
-    other.ref_count_ = nullptr;
+    other.block_ = nullptr;
   }
 
   template < typename T >
@@ -93,9 +262,9 @@ namespace gavrilova {
     if (this != &other) {
       release();
       ptr_ = other.ptr_;
-      ref_count_ = other.ref_count_;
-      if (ref_count_) {
-        (*ref_count_)++;
+      block_ = other.block_;
+      if (block_) {
+        block_->add_shared();
       }
     }
     return *this;
@@ -107,9 +276,9 @@ namespace gavrilova {
     if (this != &other) {
       release();
       ptr_ = other.ptr_;
-      ref_count_ = other.ref_count_;
+      block_ = other.block_;
       other.ptr_ = nullptr;
-      other.ref_count_ = nullptr;
+      other.block_ = nullptr;
     }
     return *this;
   }
@@ -138,21 +307,121 @@ namespace gavrilova {
     return ptr_ != nullptr;
   }
 
+  template < typename T >
+  size_t SharedPtr< T >::use_count() const noexcept
+  {
+    return block_ ? block_->use_count() : 0;
+  }
+
   template < typename T >
   void SharedPtr< T >::release()
   {
-    if (ref_count_ && --(*ref_count_) == 0) {
-      delete ptr_;
-      delete ref_count_;
+    if (block_) {
+      block_->release_shared();
+    }
+    ptr_ = nullptr;
+    block_ = nullptr;
+  }
+
+  template < typename T >
+  WeakPtr< T >::WeakPtr() noexcept:
+    ptr_(nullptr),
+    block_(nullptr)
+  {}
+
+  template < typename T >
+  template < class U >
+  WeakPtr< T >::WeakPtr(const SharedPtr< U >& shared) noexcept:
+    ptr_(shared.ptr_),
+    block_(shared.block_)
+  {
+    if (block_) {
+      block_->add_weak();
+    }
+  }
+
+  template < typename T >
+  WeakPtr< T >::WeakPtr(const WeakPtr& other) noexcept:
+    ptr_(other.ptr_),
+    block_(other.block_)
+  {
+    if (block_) {
+      block_->add_weak();
+    }
+  }
+
+  template < typename T >
+  WeakPtr< T >::WeakPtr(WeakPtr&& other) noexcept:
+    ptr_(other.ptr_),
+    block_(other.block_)
+  {
+    other.ptr_ = nullptr;
+    other.block_ = nullptr;
+  }
+
+  template < typename T >
+  WeakPtr< T >::~WeakPtr()
+  {
+    reset();
+  }
+
+  template < typename T >
+  WeakPtr< T >& WeakPtr< T >::operator=(const WeakPtr& other) noexcept
+  {
+    if (this != &other) {
+      reset();
+      ptr_ = other.ptr_;
+      block_ = other.block_;
+      if (block_) {
+        block_->add_weak();
+      }
+    }
+    return *this;
+  }
+
+  template < typename T >
+  WeakPtr< T >& WeakPtr< T >::operator=(WeakPtr&& other) noexcept
+  {
+    if (this != &other) {
+      reset();
+      ptr_ = other.ptr_;
+      block_ = other.block_;
+      other.ptr_ = nullptr;
+      other.block_ = nullptr;
+    }
+    return *this;
+  }
+
+  template < typename T >
+  bool WeakPtr< T >::expired() const noexcept
+  {
+    return !block_ || block_->use_count() == 0;
+  }
+
+  template < typename T >
+  SharedPtr< T > WeakPtr< T >::lock() const noexcept
+  {
+    if (block_ && block_->try_add_shared()) {
+      return SharedPtr< T >(ptr_, block_);
+    }
+    return SharedPtr< T >();
+  }
+
+  template < typename T >
+  void WeakPtr< T >::reset() noexcept
+  {
+    if (block_) {
+      block_->release_weak();
     }
     ptr_ = nullptr;
-    ref_count_ = nullptr;
+    block_ = nullptr;
   }
 
   template < typename T, typename... Args >
   SharedPtr< T > make_shared(Args&&... args)
   {
-    return SharedPtr< T >(new T(std::forward< Args >(args)...));
+    detail::InplaceBlock< T >* block = new detail::InplaceBlock< T >(std::forward< Args >(args)...);
+    return SharedPtr< T >(block->get(), block);
   }
 }
 
@@ -87,6 +87,8 @@ void gavrilova::StudentDatabase::clear()
   groups.clear();
   nameToStudentIndex.clear();
   dateToGradesIndex.clear();
+  ranking.clear();
+  groupRankings.clear();
 }
 
 bool gavrilova::StudentDatabase::createGroup(const std::string& groupName)
@@ -94,6 +96,7 @@ bool gavrilova::StudentDatabase::createGroup(const std::string& groupName)
   if (groupExists(groupName)) {
     return false;
   }
+  groupRankings.insert({groupName, RankingIndex{}});
   return groups.insert({groupName, Group{}}).second;
 }
 
@@ -132,6 +135,7 @@ std::pair< bool, gavrilova::StudentID > gavrilova::StudentDatabase::addStudent(c
   auto student = gavrilova::make_shared< student::Student >(nextId, fullName, groupName);
   students.insert({nextId, student});
   groups.at(groupName).insert({nextId, student});
+  rank(student);
 
   auto name_set_it = nameToStudentIndex.find(fullName);
   if (name_set_it == nameToStudentIndex.end()) {
@@ -171,6 +175,7 @@ bool gavrilova::StudentDatabase::deleteStudent(StudentID id)
     }
   };
   student->grades_.traverse_lnr(GradeRemoverFromIndex{this, id});
+  unrank(*student);
 
   groups.at(student->group_).erase(id);
 
@@ -190,8 +195,10 @@ bool gavrilova::StudentDatabase::moveStudentToGroup(StudentID id, const std::str
     return false;
   }
   groups.at(student_ptr->group_).erase(id);
+  groupRankings.at(student_ptr->group_).erase(*student_ptr);
   groups.at(newGroupName).insert({id, student_ptr});
   student_ptr->group_ = newGroupName;
+  groupRankings.at(newGroupName).insert(student_ptr);
   return true;
 }
 
@@ -286,10 +293,24 @@ bool gavrilova::StudentDatabase::removeGradesByDate(StudentID id, const date::Da
   return true;
 }
 
+void gavrilova::StudentDatabase::rank(const SharedPtr< student::Student >& student)
+{
+  ranking.insert(student);
+  groupRankings.at(student->group_).insert(student);
+}
+
+void gavrilova::StudentDatabase::unrank(const student::Student& student)
+{
+  ranking.erase(student);
+  groupRankings.at(student.group_).erase(student);
+}
+
 void gavrilova::StudentDatabase::updateStudentAverageGrade(SharedPtr< student::Student >& student)
 {
+  unrank(*student);
   if (student->grades_.empty()) {
     student->averageGrade_ = 0.0;
+    rank(student);
     return;
   }
   struct SumAccumulator {
@@ -299,6 +320,7 @@ void gavrilova::StudentDatabase::updateStudentAverageGrade(SharedPtr< student::S
   double sum = 0.0;
   student->grades_.traverse_lnr(SumAccumulator{sum});
   student->averageGrade_ = sum / student->grades_.size();
+  rank(student);
 }
 
 gavrilova::FwdList< gavrilova::SharedPtr< const gavrilova::student::Student > >
@@ -312,9 +334,12 @@ gavrilova::StudentDatabase::getStudentsInGroup(const std::string& groupName) con
 
   struct StudentCollector {
     FwdList< SharedPtr< const student::Student > >& list;
-    void operator()(const std::pair< const StudentID, SharedPtr< student::Student > >& p) const
+    void operator()(const std::pair< const StudentID, WeakPtr< student::Student > >& p) const
     {
-      list.push_front(p.second);
+      SharedPtr< const student::Student > student = p.second.lock();
+      if (student) {
+        list.push_front(student);
+      }
     }
   };
   
@@ -335,9 +360,10 @@ bool gavrilova::StudentDatabase::exportGroupForGrading(const std::string& groupN
   out << "#GROUP:" << groupName << '\n';
   struct GroupExporter {
     std::ostream& out;
-    void operator()(const std::pair< const StudentID, SharedPtr< student::Student > >& p) const
+    void operator()(const std::pair< const StudentID, WeakPtr< student::Student > >& p) const
     {
-      const auto& student = p.second;
+      SharedPtr< const student::Student > student = p.second.lock();
+      if (!student) return;
       out << "ID:" << student->id_ << '\n';
       out << "ФИО:" << student->fullName_ << '\n';
       out << "Оценка:\n";
@@ -474,8 +500,10 @@ gavrilova::StudentDatabase::getGroupStatistics(const std::string& groupName, con
         const DateRange& p;
         double& s;
         int& c;
-        void operator()(const std::pair< const StudentID, SharedPtr< student::Student > >& student_pair) const
+        void operator()(const std::pair< const StudentID, WeakPtr< student::Student > >& student_pair) const
         {
+          SharedPtr< const student::Student > student = student_pair.second.lock();
+          if (!student) return;
           struct GradeExtractor {
             const DateRange& period;
             double& sum;
@@ -489,7 +517,7 @@ gavrilova::StudentDatabase::getGroupStatistics(const std::string& groupName, con
               }
             }
           };
-          student_pair.second->grades_.traverse_lnr(GradeExtractor{p, s, c});
+          student->grades_.traverse_lnr(GradeExtractor{p, s, c});
         }
       };
       group_pair.second.traverse_lnr(StudentGradeCollector{period, sum, count});
@@ -507,95 +535,33 @@ gavrilova::StudentDatabase::getGroupStatistics(const std::string& groupName, con
 gavrilova::FwdList< gavrilova::SharedPtr< const gavrilova::student::Student > >
 gavrilova::StudentDatabase::getTopStudents(size_t n) const
 {
-  FwdList< SharedPtr< const student::Student > > allStudents;
-
-  struct StudentCollector {
-    FwdList< SharedPtr< const student::Student > >& list;
-    void operator()(const std::pair< const StudentID, SharedPtr< student::Student > >& p) const
-    {
-      list.push_front(p.second);
-    }
-  };
-  students.traverse_lnr(StudentCollector{allStudents});
-
-  struct CompareTop {
-    bool operator()(const SharedPtr< const student::Student >& a, const SharedPtr< const student::Student >& b) const
-    {
-      if (a->averageGrade_ == b->averageGrade_) return a->id_ < b->id_;
-      return a->averageGrade_ > b->averageGrade_;
-    }
-  };
-  sortList(allStudents, CompareTop{});
-
-  FwdList< SharedPtr< const student::Student > > topN;
-  auto it = allStudents.cbegin();
-  for (size_t i = 0; i < n && it != allStudents.cend(); ++i, ++it) {
-    topN.push_front(*it);
-  }
-  topN.reverse();
-  return topN;
+  return ranking.top(n);
 }
 
 gavrilova::FwdList< gavrilova::SharedPtr< const gavrilova::student::Student > >
 gavrilova::StudentDatabase::getRiskStudents(double threshold) const
 {
-  FwdList< SharedPtr< const student::Student > > result;
-
-  struct RiskStudentCollector {
-    FwdList< SharedPtr< const student::Student > >& list;
-    double threshold;
-    void operator()(const std::pair< const StudentID, SharedPtr< student::Student > >& p) const
-    {
-      if (!p.second->grades_.empty() && p.second->averageGrade_ < threshold) {
-        list.push_front(p.second);
-      }
-    }
-  };
-  students.traverse_rnl(RiskStudentCollector{result, threshold});
-  return result;
+  return ranking.below(threshold);
 }
 
 gavrilova::FwdList< gavrilova::SharedPtr< const gavrilova::student::Student > >
 gavrilova::StudentDatabase::getTopStudentsInGroup(const std::string& groupName, size_t n) const
 {
-  FwdList< SharedPtr< const student::Student > > studentsInGroup = getStudentsInGroup(groupName);
-  struct CompareTop {
-    bool operator()(const SharedPtr< const student::Student >& a, const SharedPtr< const student::Student >& b) const
-    {
-      if (a->averageGrade_ == b->averageGrade_) return a->id_ < b->id_;
-      return a->averageGrade_ > b->averageGrade_;
-    }
-  };
-  sortList(studentsInGroup, CompareTop{});
-  FwdList< SharedPtr< const student::Student > > topN;
-  auto it = studentsInGroup.cbegin();
-  for (size_t i = 0; i < n && it != studentsInGroup.cend(); ++i, ++it) {
-    topN.push_front(*it);
-  }
-  topN.reverse();
-  return topN;
+  auto it = groupRankings.find(groupName);
+  if (it == groupRankings.end()) {
+    return {};
+  }
+  return it->second.top(n);
 }
 
 gavrilova::FwdList< gavrilova::SharedPtr< const gavrilova::student::Student > >
 gavrilova::StudentDatabase::getRiskStudentsInGroup(const std::string& groupName, double threshold) const
 {
-  FwdList< SharedPtr< const student::Student > > studentsInGroup = getStudentsInGroup(groupName);
-  FwdList< SharedPtr< const student::Student > > result;
-  struct RiskStudentInGroupCollector {
-    FwdList< SharedPtr< const student::Student > >& list;
-    double threshold;
-    void operator()(const SharedPtr< const student::Student >& s) const
-    {
-      if (!s->grades_.empty() && s->averageGrade_ < threshold) {
-        list.push_front(s);
-      }
-    }
-  };
-  for (const auto& s: studentsInGroup) {
-    RiskStudentInGroupCollector{result, threshold}(s);
+  auto it = groupRankings.find(groupName);
+  if (it == groupRankings.end()) {
+    return {};
   }
-  result.reverse();
-  return result;
+  return it->second.below(threshold);
 }
 
 std::pair< bool, double > gavrilova::StudentDatabase::getAverageGradeByDate(const date::Date& date) const
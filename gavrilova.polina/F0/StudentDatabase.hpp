@@ -5,6 +5,7 @@
 #include "Date.hpp"
 #include "Student.hpp"
 #include "Containers.hpp"
+#include "RankingIndex.hpp"
 #include "SharedPointer.hpp"
 
 namespace gavrilova {
@@ -24,7 +25,7 @@ namespace gavrilova {
 
   class StudentDatabase {
   public:
-    using Group = map< StudentID, SharedPtr< student::Student > >;
+    using Group = map< StudentID, WeakPtr< student::Student > >;
 
     explicit StudentDatabase(int id_digits = 4);
 
@@ -65,7 +66,12 @@ namespace gavrilova {
     map< std::string, Group > groups;
     map< std::string, set< StudentID > > nameToStudentIndex;
     map< date::Date, FwdList< std::pair< StudentID, int > > > dateToGradesIndex;
+    RankingIndex ranking;
+    map< std::string, RankingIndex > groupRankings;
     StudentID nextId;
+
+    void rank(const SharedPtr< student::Student >& student);
+    void unrank(const student::Student& student);
   };
 }
 
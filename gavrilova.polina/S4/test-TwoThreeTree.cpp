@@ -1,5 +1,6 @@
 #include <boost/test/unit_test.hpp>
 #include <string>
+#include <vector>
 #include <tree/ConstIterator.hpp>
 #include <tree/Iterator.hpp>
 #include <tree/TwoThreeTree.hpp>
@@ -342,6 +343,51 @@ BOOST_AUTO_TEST_CASE(TestIteratorForwardTraversal)
   BOOST_CHECK(it == tree.end());
 }
 
+BOOST_AUTO_TEST_CASE(TestIteratorThroughThreeNodeMiddleChild)
+{
+  gavrilova::TwoThreeTree< int, std::string > tree;
+  for (int key: {4, 19, 13, 0, 3}) {
+    tree.insert({key, std::to_string(key)});
+  }
+
+  std::vector< int > expected = {0, 3, 4, 13, 19};
+  std::vector< int > keys;
+  for (auto it = tree.begin(); it != tree.end(); ++it) {
+    keys.push_back(it->first);
+  }
+  BOOST_TEST(keys == expected, boost::test_tools::per_element());
+
+  const auto& constTree = tree;
+  keys.clear();
+  for (auto it = constTree.cbegin(); it != constTree.cend(); ++it) {
+    keys.push_back(it->first);
+  }
+  BOOST_TEST(keys == expected, boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(TestIteratorOrderWithManyThreeNodes)
+{
+  gavrilova::TwoThreeTree< int, std::string > tree;
+  const int count = 500;
+  for (int i = 0; i < count; ++i) {
+    const int key = (i * 211) % count;
+    tree.insert({key, std::to_string(key)});
+  }
+
+  int expected = 0;
+  for (auto it = tree.begin(); it != tree.end(); ++it, ++expected) {
+    BOOST_TEST(it->first == expected);
+  }
+  BOOST_TEST(expected == count);
+
+  const auto& constTree = tree;
+  expected = 0;
+  for (auto it = constTree.cbegin(); it != constTree.cend(); ++it, ++expected) {
+    BOOST_TEST(it->first == expected);
+  }
+  BOOST_TEST(expected == count);
+}
+
 BOOST_AUTO_TEST_CASE(TestIteratorBackwardTraversal)
 {
   gavrilova::TwoThreeTree< int, std::string > tree;
@@ -14,6 +14,7 @@
 
 namespace kizhin {
   bool isSatisfied(const std::string& str, const std::string& regexp);
+  bool hasPrefix(const std::string& str, const std::string& prefix);
   std::string wordAndSizeToString(const WordAndSize&);
   float getFreq(const FrequencyDictionary&, const WordAndSize&);
   void outWordInfo(std::ostream&, const FrequencyDictionary&, const WordAndSize&);
@@ -355,13 +356,17 @@ void kizhin::CommandProcessor::handleFind(const CmdArgs& args) const
   }
   const FrequencyDictionary dict = loadDictionary(state_.at(args[0]));
   const WordMap& wordMap = dict.wordMap;
+  const std::string prefix = args[1].substr(0, args[1].find('*'));
   WordMap result{};
   using std::placeholders::_1;
   const auto inserter = std::inserter(result, result.end());
   static const auto getFirst = std::bind(&WordMap::value_type::first, _1);
+  const auto inPrefix = std::bind(hasPrefix, std::bind(getFirst, _1), std::cref(prefix));
+  const auto begin = wordMap.lowerBound(prefix);
+  const auto end = std::find_if_not(begin, wordMap.end(), inPrefix);
   static const auto validator = std::addressof(isSatisfied);
   const auto isRight = std::bind(validator, std::bind(getFirst, _1), std::cref(args[1]));
-  std::copy_if(wordMap.begin(), wordMap.end(), inserter, isRight);
+  std::copy_if(begin, end, inserter, isRight);
   using OutIt = std::ostream_iterator< std::string >;
   std::transform(result.begin(), result.end(), OutIt{ out_, "\n" }, wordAndSizeToString);
 }
@@ -381,12 +386,7 @@ void kizhin::CommandProcessor::outDictionary(const State::key_type& dictionary)
 kizhin::FrequencyDictionary kizhin::CommandProcessor::loadDictionary(
     const std::vector< std::string >& files) const
 {
-  FrequencyDictionary result{};
-  using std::placeholders::_1;
-  const auto expander = std::bind(std::addressof(expandDictionary), _1, std::ref(result));
-  std::vector< std::ifstream > fins(files.begin(), files.end());
-  std::for_each(fins.begin(), fins.end(), expander);
-  return result;
+  return kizhin::loadDictionary(files);
 }
 
 bool kizhin::isSatisfied(const std::string& str, const std::string& reg)
@@ -407,6 +407,11 @@ bool kizhin::isSatisfied(const std::string& str, const std::string& reg)
   return strPos == str.end() && (isRegEnd || doesMathcAny);
 }
 
+bool kizhin::hasPrefix(const std::string& str, const std::string& prefix)
+{
+  return str.compare(0, prefix.size(), prefix) == 0;
+}
+
 std::string kizhin::wordAndSizeToString(const WordAndSize& val)
 {
   return std::to_string(val.second) + '\t' + val.first;
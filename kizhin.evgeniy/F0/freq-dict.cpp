@@ -2,10 +2,16 @@
 #include <algorithm>
 #include <fstream>
 #include <functional>
+#include <future>
 #include <iterator>
 
 namespace kizhin {
   void appendWord(FrequencyDictionary&, const std::string&);
+  void countWord(FrequencyDictionary&, const std::string&);
+  FrequencyDictionary loadPartial(const std::string&);
+  std::future< FrequencyDictionary > launchPartial(const std::string&);
+  void mergePartial(FrequencyDictionary&, std::future< FrequencyDictionary >&);
+  void rebuildSets(FrequencyDictionary&);
 }
 
 bool kizhin::SizeDescendingComp::operator()(const WordAndSize& lhs,
@@ -40,3 +46,60 @@ void kizhin::appendWord(FrequencyDictionary& dict, const std::string& word)
   ++dict.total;
 }
 
+kizhin::FrequencyDictionary kizhin::loadDictionary(const std::vector< std::string >& files)
+{
+  std::vector< std::future< FrequencyDictionary > > partials{};
+  partials.reserve(files.size());
+  const auto inserter = std::back_inserter(partials);
+  std::transform(files.begin(), files.end(), inserter, launchPartial);
+  FrequencyDictionary result{};
+  using std::placeholders::_1;
+  const auto merger = std::bind(std::addressof(mergePartial), std::ref(result), _1);
+  std::for_each(partials.begin(), partials.end(), merger);
+  rebuildSets(result);
+  return result;
+}
+
+void kizhin::countWord(FrequencyDictionary& dict, const std::string& word)
+{
+  ++dict.wordMap[word];
+  ++dict.total;
+}
+
+kizhin::FrequencyDictionary kizhin::loadPartial(const std::string& file)
+{
+  FrequencyDictionary result{};
+  std::ifstream in(file);
+  using InIt = std::istream_iterator< std::string >;
+  using std::placeholders::_1;
+  const auto counter = std::bind(std::addressof(countWord), std::ref(result), _1);
+  std::for_each(InIt{ in }, InIt{}, counter);
+  return result;
+}
+
+std::future< kizhin::FrequencyDictionary > kizhin::launchPartial(const std::string& file)
+{
+  return std::async(std::launch::async, std::addressof(loadPartial), file);
+}
+
+void kizhin::mergePartial(FrequencyDictionary& dict, std::future< FrequencyDictionary >& partial)
+{
+  FrequencyDictionary part = partial.get();
+  if (dict.wordMap.empty()) {
+    dict.wordMap = std::move(part.wordMap);
+  } else {
+    for (const WordMap::value_type& word: part.wordMap) {
+      dict.wordMap[word.first] += word.second;
+    }
+  }
+  dict.total += part.total;
+}
+
+void kizhin::rebuildSets(FrequencyDictionary& dict)
+{
+  using std::placeholders::_1;
+  static const auto getFirst = std::bind(&WordMap::value_type::first, _1);
+  const auto wordInserter = std::inserter(dict.wordSet, dict.wordSet.end());
+  std::transform(dict.wordMap.begin(), dict.wordMap.end(), wordInserter, getFirst);
+  dict.sizeSet.insert(dict.wordMap.begin(), dict.wordMap.end());
+}
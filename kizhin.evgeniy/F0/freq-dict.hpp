@@ -4,6 +4,7 @@
 #include <iosfwd>
 #include <set>
 #include <string>
+#include <vector>
 #include <map.hpp>
 
 namespace kizhin {
@@ -27,6 +28,7 @@ namespace kizhin {
   };
 
   void expandDictionary(std::istream&, FrequencyDictionary&);
+  FrequencyDictionary loadDictionary(const std::vector< std::string >&);
 }
 
 #endif
@@ -4,6 +4,7 @@
 #include <limits>
 #include <map>
 #include <stdexcept>
+#include <utility>
 #include "io-utils.hpp"
 
 namespace kizhin {
@@ -62,13 +63,8 @@ void kizhin::complement(DSContainer& datasets, std::istream& in)
   }
   const auto& ds1 = datasets.at(name1);
   const auto& ds2 = datasets.at(name2);
-  Dataset result;
-  for (const auto& p: ds1) {
-    if (!ds2.count(p.first)) {
-      result[p.first] = p.second;
-    }
-  }
-  datasets[newName] = result;
+  Dataset result = setDifference(ds1, ds2);
+  datasets[newName] = std::move(result);
 }
 
 void kizhin::intersect(DSContainer& datasets, std::istream& in)
@@ -81,13 +77,8 @@ void kizhin::intersect(DSContainer& datasets, std::istream& in)
   }
   const auto& ds1 = datasets.at(name1);
   const auto& ds2 = datasets.at(name2);
-  Dataset result;
-  for (const auto& p: ds1) {
-    if (ds2.count(p.first)) {
-      result[p.first] = p.second;
-    }
-  }
-  datasets[newName] = result;
+  Dataset result = setIntersection(ds1, ds2);
+  datasets[newName] = std::move(result);
 }
 
 void kizhin::unionCmd(DSContainer& datasets, std::istream& in)
@@ -101,12 +92,7 @@ void kizhin::unionCmd(DSContainer& datasets, std::istream& in)
   }
   const auto& ds1 = datasets.at(name1);
   const auto& ds2 = datasets.at(name2);
-  Dataset result = ds1;
-  for (const auto& p: ds2) {
-    if (!result.count(p.first)) {
-      result[p.first] = p.second;
-    }
-  }
-  datasets[newName] = result;
+  Dataset result = setUnion(ds1, ds2);
+  datasets[newName] = std::move(result);
 }
 
@@ -1,10 +1,42 @@
 #include "io-utils.hpp"
+#include <cctype>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <buffer.hpp>
 
 namespace kizhin {
-  std::istream& operator>>(std::istream&, Dataset&);
   std::ostream& operator<<(std::ostream&, Dataset::const_reference);
   std::ostream& operator<<(std::ostream&, const Dataset&);
+
+  class DatasetsParser final
+  {
+  public:
+    explicit DatasetsParser(DSContainer&) noexcept;
+    void parseToken(const char*, const char*);
+    void finish();
+
+  private:
+    using Entry = std::pair< Dataset::key_type, Dataset::mapped_type >;
+
+    DSContainer& datasets_;
+    DSContainer::key_type name_;
+    Dataset dataset_;
+    Buffer< Entry > run_;
+    Dataset::key_type key_ = 0;
+    bool hasName_ = false;
+    bool hasKey_ = false;
+
+    void pushEntry(Dataset::mapped_type&&);
+    void flushRun();
+    void finishDataset();
+  };
+
+  DSContainer readDatasets(std::istream&);
+  const char* skipSpaces(const char*, const char*) noexcept;
+  const char* tokenEnd(const char*, const char*) noexcept;
+  const char* parseKey(const char*, const char*, Dataset::key_type&) noexcept;
 }
 
 std::istream& kizhin::operator>>(std::istream& in, DSContainer& dest)
@@ -13,22 +45,135 @@ std::istream& kizhin::operator>>(std::istream& in, DSContainer& dest)
   if (!sentry) {
     return in;
   }
-  DSContainer input;
-  while (in) {
-    DSContainer::key_type key;
-    DSContainer::mapped_type val;
-    in >> key >> val;
-    if (!key.empty()) {
-      input.emplace(std::move(key), std::move(val));
-    }
-  }
+  DSContainer input = readDatasets(in);
   if (!input.empty()) {
-    in.clear();
-    dest = input;
+    dest = std::move(input);
   }
   return in;
 }
 
+kizhin::DSContainer kizhin::readDatasets(std::istream& in)
+{
+  constexpr std::streamsize blockSize = 1 << 16;
+  DSContainer datasets;
+  DatasetsParser parser(datasets);
+  std::string block;
+  std::streamsize read = 0;
+  do {
+    const std::size_t carried = block.size();
+    block.resize(carried + blockSize);
+    read = in.rdbuf()->sgetn(&block[carried], blockSize);
+    block.resize(carried + read);
+    const char* const last = block.data() + block.size();
+    const char* current = skipSpaces(block.data(), last);
+    for (const char* end = tokenEnd(current, last); end != last; end = tokenEnd(current, last)) {
+      parser.parseToken(current, end);
+      current = skipSpaces(end, last);
+    }
+    block.erase(0, current - block.data());
+  } while (read == blockSize);
+  if (!block.empty()) {
+    parser.parseToken(block.data(), block.data() + block.size());
+  }
+  parser.finish();
+  return datasets;
+}
+
+kizhin::DatasetsParser::DatasetsParser(DSContainer& datasets) noexcept:
+  datasets_(datasets)
+{}
+
+void kizhin::DatasetsParser::parseToken(const char* first, const char* last)
+{
+  if (hasName_) {
+    if (hasKey_) {
+      hasKey_ = false;
+      pushEntry(Dataset::mapped_type(first, last));
+      return;
+    }
+    if (const char* keyEnd = parseKey(first, last, key_)) {
+      hasKey_ = keyEnd == last;
+      if (!hasKey_) {
+        pushEntry(Dataset::mapped_type(keyEnd, last));
+      }
+      return;
+    }
+    finishDataset();
+  }
+  name_.assign(first, last);
+  hasName_ = true;
+}
+
+void kizhin::DatasetsParser::finish()
+{
+  if (hasName_) {
+    finishDataset();
+  }
+}
+
+void kizhin::DatasetsParser::pushEntry(Dataset::mapped_type&& value)
+{
+  if (!run_.empty() && !dataset_.keyComp()(run_.back().first, key_)) {
+    flushRun();
+  }
+  run_.emplaceBack(key_, std::move(value));
+}
+
+void kizhin::DatasetsParser::flushRun()
+{
+  dataset_.insert(std::make_move_iterator(run_.begin()), std::make_move_iterator(run_.end()));
+  run_.clear();
+}
+
+void kizhin::DatasetsParser::finishDataset()
+{
+  flushRun();
+  datasets_.emplace(std::move(name_), std::move(dataset_));
+  dataset_.clear();
+  hasName_ = false;
+  hasKey_ = false;
+}
+
+const char* kizhin::skipSpaces(const char* current, const char* const last) noexcept
+{
+  while (current != last && std::isspace(static_cast< unsigned char >(*current))) {
+    ++current;
+  }
+  return current;
+}
+
+const char* kizhin::tokenEnd(const char* current, const char* const last) noexcept
+{
+  while (current != last && !std::isspace(static_cast< unsigned char >(*current))) {
+    ++current;
+  }
+  return current;
+}
+
+const char* kizhin::parseKey(const char* current, const char* const last,
+    Dataset::key_type& key) noexcept
+{
+  using limits = std::numeric_limits< Dataset::key_type >;
+  const bool isNegative = *current == '-';
+  if (*current == '-' || *current == '+') {
+    ++current;
+  }
+  const char* const digits = current;
+  long long value = 0;
+  for (; current != last && std::isdigit(static_cast< unsigned char >(*current)); ++current) {
+    value = value * 10 + (*current - '0');
+    if (value > static_cast< long long >(limits::max()) + 1) {
+      return nullptr;
+    }
+  }
+  value = isNegative ? -value : value;
+  if (current == digits || value > limits::max() || value < limits::min()) {
+    return nullptr;
+  }
+  key = static_cast< Dataset::key_type >(value);
+  return current;
+}
+
 std::ostream& kizhin::operator<<(std::ostream& out, DSContainer::const_reference data)
 {
   std::ostream::sentry sentry(out);
@@ -43,23 +188,6 @@ std::ostream& kizhin::operator<<(std::ostream& out, DSContainer::const_reference
   return out;
 }
 
-std::istream& kizhin::operator>>(std::istream& in, Dataset& dest)
-{
-  std::istream::sentry sentry(in);
-  if (!sentry) {
-    return in;
-  }
-  Dataset::key_type key{};
-  Dataset::mapped_type val{};
-  Dataset input;
-  while (in >> key >> val) {
-    input.emplace(std::move(key), std::move(val));
-  }
-  in.clear();
-  dest = input;
-  return in;
-}
-
 std::ostream& kizhin::operator<<(std::ostream& out, Dataset::const_reference data)
 {
   std::ostream::sentry sentry(out);
@@ -1,5 +1,8 @@
+#include <iterator>
 #include <numeric>
 #include <random>
+#include <string>
+#include <vector>
 #include <boost/test/unit_test.hpp>
 #include "test-utils.hpp"
 
@@ -70,6 +73,42 @@ BOOST_AUTO_TEST_CASE(range_constructor)
   BOOST_TEST(std::equal(map.begin(), map.end(), init.begin()));
 }
 
+BOOST_AUTO_TEST_CASE(sorted_range_constructor)
+{
+  for (int size = 1; size != 100; ++size) {
+    std::vector< MapT::value_type > init;
+    for (int i = 0; i != size; ++i) {
+      init.emplace_back(i * 2, std::to_string(i));
+    }
+    MapT map(init.begin(), init.end());
+    testMapInvariants(map);
+    BOOST_TEST(map.size() == init.size());
+    BOOST_TEST(std::equal(map.begin(), map.end(), init.begin()));
+    const auto rbegin = std::make_reverse_iterator(map.end());
+    const auto rend = std::make_reverse_iterator(map.begin());
+    BOOST_TEST(std::equal(rbegin, rend, init.rbegin()));
+    for (int i = 0; i < size; i += 2) {
+      BOOST_TEST(map.erase(i * 2) == 1);
+      BOOST_TEST(map.insert({ i * 2 + 1, "" }).second);
+    }
+    testMapInvariants(map);
+    BOOST_TEST(map.size() == init.size());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(unsorted_range_constructor)
+{
+  const std::initializer_list< MapT::value_type > init{
+    { 3, "abc" },
+    { 1, "def" },
+    { 3, "ghi" },
+  };
+  const MapT map(init.begin(), init.end());
+  testMapInvariants(map);
+  BOOST_TEST(map.size() == 2);
+  BOOST_TEST(map.at(3) == "abc");
+}
+
 BOOST_AUTO_TEST_CASE(initializer_list_constructor)
 {
   const std::initializer_list< MapT::value_type > init{
@@ -580,3 +619,41 @@ BOOST_AUTO_TEST_CASE(less_operator_different_values)
 
 BOOST_AUTO_TEST_SUITE_END();
 
+BOOST_AUTO_TEST_SUITE(set_operations);
+
+BOOST_AUTO_TEST_CASE(set_union)
+{
+  const MapT map1{ { 1, "a" }, { 3, "b" }, { 5, "c" } };
+  const MapT map2{ { 2, "d" }, { 3, "e" }, { 6, "f" } };
+  const MapT expected{ { 1, "a" }, { 2, "d" }, { 3, "b" }, { 5, "c" }, { 6, "f" } };
+  const MapT result = kizhin::setUnion(map1, map2);
+  testMapInvariants(result);
+  BOOST_TEST(result == expected);
+  BOOST_TEST(kizhin::setUnion(map1, MapT{}) == map1);
+  BOOST_TEST(kizhin::setUnion(MapT{}, map2) == map2);
+}
+
+BOOST_AUTO_TEST_CASE(set_intersection)
+{
+  const MapT map1{ { 1, "a" }, { 3, "b" }, { 5, "c" } };
+  const MapT map2{ { 2, "d" }, { 3, "e" }, { 5, "f" } };
+  const MapT expected{ { 3, "b" }, { 5, "c" } };
+  const MapT result = kizhin::setIntersection(map1, map2);
+  testMapInvariants(result);
+  BOOST_TEST(result == expected);
+  BOOST_TEST(kizhin::setIntersection(map1, MapT{}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(set_difference)
+{
+  const MapT map1{ { 1, "a" }, { 3, "b" }, { 5, "c" } };
+  const MapT map2{ { 2, "d" }, { 3, "e" }, { 6, "f" } };
+  const MapT expected{ { 1, "a" }, { 5, "c" } };
+  const MapT result = kizhin::setDifference(map1, map2);
+  testMapInvariants(result);
+  BOOST_TEST(result == expected);
+  BOOST_TEST(kizhin::setDifference(map1, MapT{}) == map1);
+  BOOST_TEST(kizhin::setDifference(MapT{}, map2).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -25,14 +25,12 @@ int main(int argc, char** argv)
       std::cout << "<EMPTY>\n";
       return 0;
     }
-    ValueCollector result;
-    MapT* mapPtr = std::addressof(map);
-    const Map< std::string, std::function< ValueCollector() > > commands{
-      { "ascending", std::bind(&MapT::traverseLmr< ValueCollector >, mapPtr, result) },
-      { "descending", std::bind(&MapT::traverseRml< ValueCollector >, mapPtr, result) },
-      { "breadth", std::bind(&MapT::traverseBreadth< ValueCollector >, mapPtr, result) },
+    const Map< std::string, std::function< ValueCollector(const MapT&) > > commands{
+      { "ascending", collectAscending },
+      { "descending", collectDescending },
+      { "breadth", collectBreadth },
     };
-    result = commands.at(argv[1])();
+    const ValueCollector result = commands.at(argv[1])(map);
     std::cout << result.keys << ' ' << result.values << '\n';
   } catch (const std::exception& e) {
     std::cerr << "Error: " << e.what() << '\n';
@@ -1,6 +1,28 @@
 #include "map-utils.hpp"
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <future>
 #include <istream>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <stdexcept>
+
+namespace kizhin {
+  constexpr MapT::size_type parallelThreshold = 1 << 16;
+  constexpr std::size_t maxParts = 8;
+  using ValueRef = std::reference_wrapper< const MapT::value_type >;
+
+  bool canAdd(MapT::key_type, MapT::key_type) noexcept;
+  MapT::key_type addKey(MapT::key_type, MapT::key_type);
+  Buffer< MapT::const_iterator > splitByKeys(const MapT&);
+  template < typename It >
+  Buffer< PartCollector > collectParts(const Buffer< It >&);
+  template < typename It >
+  PartCollector collectPart(It, It);
+  ValueCollector assemble(const Buffer< PartCollector >&);
+}
 
 std::istream& kizhin::operator>>(std::istream& in, MapT& dest)
 {
@@ -22,17 +44,144 @@ std::istream& kizhin::operator>>(std::istream& in, MapT& dest)
 
 void kizhin::ValueCollector::operator()(MapT::const_reference value)
 {
-  const MapT::key_type& key = value.first;
-  if (key > 0 && keys > std::numeric_limits< MapT::key_type >::max() - key) {
-    throw std::overflow_error("Overflow");
-  }
-  if (key < 0 && keys < std::numeric_limits< MapT::key_type >::min() - key) {
-    throw std::underflow_error("Underflow");
-  }
-  keys += value.first;
+  keys = addKey(keys, value.first);
   if (!values.empty()) {
     values += ' ';
   }
   values += value.second;
 }
 
+void kizhin::PartCollector::operator()(MapT::const_reference value)
+{
+  values.pushBack(std::addressof(value));
+  length += value.second.size();
+  if (exact && canAdd(keys, value.first)) {
+    keys += value.first;
+    minPrefix = std::min(minPrefix, keys);
+    maxPrefix = std::max(maxPrefix, keys);
+  } else {
+    exact = false;
+  }
+}
+
+kizhin::ValueCollector kizhin::collectAscending(const MapT& map)
+{
+  if (map.size() < parallelThreshold) {
+    return map.traverseLmr(ValueCollector{});
+  }
+  return assemble(collectParts(splitByKeys(map)));
+}
+
+kizhin::ValueCollector kizhin::collectDescending(const MapT& map)
+{
+  if (map.size() < parallelThreshold) {
+    return map.traverseRml(ValueCollector{});
+  }
+  const Buffer< MapT::const_iterator > bounds = splitByKeys(map);
+  Buffer< std::reverse_iterator< MapT::const_iterator > > reversed;
+  for (auto it = bounds.end(); it != bounds.begin(); --it) {
+    reversed.pushBack(std::make_reverse_iterator(*(it - 1)));
+  }
+  return assemble(collectParts(reversed));
+}
+
+kizhin::ValueCollector kizhin::collectBreadth(const MapT& map)
+{
+  if (map.size() < parallelThreshold) {
+    return map.traverseBreadth(ValueCollector{});
+  }
+  Buffer< ValueRef > values;
+  for (auto it = map.bfsBegin(), end = map.bfsEnd(); it != end; ++it) {
+    values.pushBack(std::cref(*it));
+  }
+  Buffer< const ValueRef* > bounds;
+  for (std::size_t i = 0; i <= maxParts; ++i) {
+    bounds.pushBack(values.begin() + values.size() * i / maxParts);
+  }
+  return assemble(collectParts(bounds));
+}
+
+bool kizhin::canAdd(MapT::key_type sum, MapT::key_type key) noexcept
+{
+  if (key > 0) {
+    return sum <= std::numeric_limits< MapT::key_type >::max() - key;
+  }
+  return sum >= std::numeric_limits< MapT::key_type >::min() - key;
+}
+
+kizhin::MapT::key_type kizhin::addKey(MapT::key_type sum, MapT::key_type key)
+{
+  if (!canAdd(sum, key)) {
+    if (key > 0) {
+      throw std::overflow_error("Overflow");
+    }
+    throw std::underflow_error("Underflow");
+  }
+  return sum + key;
+}
+
+kizhin::Buffer< kizhin::MapT::const_iterator > kizhin::splitByKeys(const MapT& map)
+{
+  Buffer< MapT::key_type > pivots;
+  auto it = map.bfsBegin();
+  for (auto end = map.bfsEnd(); it != end && pivots.size() + 1 != maxParts; ++it) {
+    pivots.pushBack(it->first);
+  }
+  std::sort(pivots.begin(), pivots.end());
+  Buffer< MapT::const_iterator > bounds;
+  bounds.pushBack(map.begin());
+  for (MapT::key_type pivot: pivots) {
+    bounds.pushBack(map.find(pivot));
+  }
+  bounds.pushBack(map.end());
+  return bounds;
+}
+
+template < typename It >
+kizhin::Buffer< kizhin::PartCollector > kizhin::collectParts(const Buffer< It >& bounds)
+{
+  std::array< std::future< PartCollector >, maxParts > workers;
+  const std::size_t count = bounds.size() - 1;
+  for (std::size_t i = 0; i != count; ++i) {
+    workers[i] = std::async(std::launch::async, collectPart< It >, *(bounds.begin() + i),
+        *(bounds.begin() + i + 1));
+  }
+  Buffer< PartCollector > parts;
+  for (std::size_t i = 0; i != count; ++i) {
+    parts.pushBack(workers[i].get());
+  }
+  return parts;
+}
+
+template < typename It >
+kizhin::PartCollector kizhin::collectPart(const It first, const It last)
+{
+  return std::for_each(first, last, PartCollector{});
+}
+
+kizhin::ValueCollector kizhin::assemble(const Buffer< PartCollector >& parts)
+{
+  std::size_t length = 0;
+  for (const PartCollector& part: parts) {
+    length += part.length + part.values.size();
+  }
+  ValueCollector result;
+  result.values.reserve(length);
+  for (const PartCollector& part: parts) {
+    const bool summed = part.exact && canAdd(result.keys, part.minPrefix) &&
+        canAdd(result.keys, part.maxPrefix);
+    if (summed) {
+      result.keys += part.keys;
+    }
+    for (MapT::const_pointer value: part.values) {
+      if (!summed) {
+        result.keys = addKey(result.keys, value->first);
+      }
+      if (!result.values.empty()) {
+        result.values += ' ';
+      }
+      result.values += value->second;
+    }
+  }
+  return result;
+}
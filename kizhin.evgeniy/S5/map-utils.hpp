@@ -2,12 +2,18 @@
 #define SPBSPU_LABS_2025_AADS_A_KIZHIN_EVGENIY_S5_MAP_UTILS_HPP
 
 #include <iosfwd>
+#include <buffer.hpp>
 #include <map.hpp>
 
 namespace kizhin {
   using MapT = Map< long long, std::string >;
   struct ValueCollector;
+  struct PartCollector;
   std::istream& operator>>(std::istream&, MapT&);
+
+  ValueCollector collectAscending(const MapT&);
+  ValueCollector collectDescending(const MapT&);
+  ValueCollector collectBreadth(const MapT&);
 }
 
 struct kizhin::ValueCollector
@@ -17,5 +23,15 @@ struct kizhin::ValueCollector
   MapT::mapped_type values;
 };
 
-#endif
+struct kizhin::PartCollector
+{
+  void operator()(MapT::const_reference);
+  Buffer< MapT::const_pointer > values;
+  MapT::key_type keys = 0;
+  MapT::key_type minPrefix = 0;
+  MapT::key_type maxPrefix = 0;
+  std::size_t length = 0;
+  bool exact = true;
+};
 
+#endif
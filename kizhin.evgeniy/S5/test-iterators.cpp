@@ -119,3 +119,13 @@ BOOST_AUTO_TEST_CASE(bfs_to_iterator)
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_AUTO_TEST_CASE(rml_iterator_three_nodes)
+{
+  MapFixture::MapT map;
+  for (int i = 0; i != 1000; ++i) {
+    map.emplace((i * 7919) % 1000, i);
+  }
+  auto keys = extract_keys(map.rmlBegin(), map.rmlEnd());
+  std::reverse(keys.begin(), keys.end());
+  BOOST_TEST(keys == extract_keys(map.begin(), map.end()));
+}
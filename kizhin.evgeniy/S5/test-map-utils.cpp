@@ -0,0 +1,41 @@
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include "map-utils.hpp"
+
+kizhin::MapT make_map(long long size, long long step)
+{
+  kizhin::MapT map;
+  for (long long i = 0; i != size; ++i) {
+    map.emplace(((i * 7919) % size - size / 2) * step, std::to_string(i));
+  }
+  return map;
+}
+
+void check_same(const kizhin::ValueCollector& lhs, const kizhin::ValueCollector& rhs)
+{
+  BOOST_TEST(lhs.keys == rhs.keys);
+  BOOST_TEST(lhs.values == rhs.values);
+}
+
+BOOST_AUTO_TEST_CASE(collectors_match_sequential_traversals)
+{
+  using kizhin::ValueCollector;
+  for (long long size: { 0, 1, 5, 1000, 70001 }) {
+    const kizhin::MapT map = make_map(size, 3);
+    check_same(kizhin::collectAscending(map), map.traverseLmr(ValueCollector{}));
+    check_same(kizhin::collectDescending(map), map.traverseRml(ValueCollector{}));
+    check_same(kizhin::collectBreadth(map), map.traverseBreadth(ValueCollector{}));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(collectors_report_overflow)
+{
+  const long long step = std::numeric_limits< long long >::max() / 35000;
+  const kizhin::MapT map = make_map(70001, step);
+  BOOST_CHECK_THROW(map.traverseLmr(kizhin::ValueCollector{}), std::underflow_error);
+  BOOST_CHECK_THROW(kizhin::collectAscending(map), std::underflow_error);
+  BOOST_CHECK_THROW(map.traverseRml(kizhin::ValueCollector{}), std::overflow_error);
+  BOOST_CHECK_THROW(kizhin::collectDescending(map), std::overflow_error);
+}
@@ -80,7 +80,7 @@ void kizhin::outOutbound(const GraphContainer& graphs, std::ostream& out,
     throw std::logic_error("Falied to input key");
   }
   const Graph& graph = graphs.at(graphName);
-  if (graph.empty()) {
+  if (graph.edges.empty()) {
     throw std::logic_error("Empty graph");
   }
   SortedGraph outbounds = getOutbound(graph, vertex);
@@ -106,7 +106,7 @@ void kizhin::outInbound(const GraphContainer& graphs, std::ostream& out, std::is
     throw std::logic_error("Falied to input key");
   }
   const Graph& graph = graphs.at(graphName);
-  if (graph.empty()) {
+  if (graph.edges.empty()) {
     throw std::logic_error("Empty graph");
   }
   SortedGraph inbounds = getInbound(graph, vertex);
@@ -134,7 +134,7 @@ void kizhin::bindEdge(GraphContainer& graphs, std::istream& in)
     throw std::logic_error("Falied to input key");
   }
   Graph& target = graphs.at(graphName);
-  target[{ from, to }].insert(weight);
+  insertEdge(target, { from, to }).insert(weight);
 }
 
 void kizhin::cutEdge(GraphContainer& graphs, std::istream& in)
@@ -147,8 +147,8 @@ void kizhin::cutEdge(GraphContainer& graphs, std::istream& in)
     throw std::logic_error("Falied to input key");
   }
   Graph& graph = graphs.at(graphName);
-  auto edgePos = graph.find({ from, to });
-  if (edgePos == graph.end()) {
+  auto edgePos = graph.edges.find({ from, to });
+  if (edgePos == graph.edges.end()) {
     throw std::logic_error("Failed to find edge");
   }
   WeightContiner& weights = edgePos->second;
@@ -158,9 +158,9 @@ void kizhin::cutEdge(GraphContainer& graphs, std::istream& in)
   }
   weights.erase(weightPos);
   if (weights.empty()) {
-    graph.erase(edgePos);
+    eraseEdge(graph, edgePos);
   }
-  if (graph.empty()) {
+  if (graph.edges.empty()) {
     graphs.erase(graphName);
   }
 }
@@ -177,10 +177,10 @@ void kizhin::create(GraphContainer& graphs, std::istream& in)
     throw std::logic_error("Failed to input vertex count");
   }
   Vertex current{};
-  while (graph.size() != vertexCount && (in >> current)) {
-    graph[{ current, current }];
+  while (graph.edges.size() != vertexCount && (in >> current)) {
+    insertEdge(graph, { current, current });
   }
-  if (graph.size() != vertexCount) {
+  if (graph.edges.size() != vertexCount) {
     throw std::logic_error("Failed to input vertexes");
   }
   graphs.insert({ std::move(graphName), std::move(graph) });
@@ -198,12 +198,7 @@ void kizhin::merge(GraphContainer& graphs, std::istream& in)
     throw std::logic_error("Falied to perform merge");
   }
   Graph result = graphs[firstSrc];
-  for (const auto& edge: graphs[secondSrc]) {
-    const VertexPair& vertexes = edge.first;
-    const WeightContiner& weights = edge.second;
-    result[vertexes].insert(weights.begin(), weights.end());
-  }
-  result.insert(graphs[secondSrc].begin(), graphs[secondSrc].end());
+  mergeGraph(result, graphs[secondSrc]);
   graphs[dest] = std::move(result);
 }
 
@@ -226,14 +221,7 @@ void kizhin::extract(GraphContainer& graphs, std::istream& in)
   if (vertexes.size() != vertexCount) {
     throw std::logic_error("Failed to input vertexes");
   }
-  Graph result{};
-  const Graph& src = graphs[srcName];
-  for (const auto& edge: src) {
-    const VertexPair& srcVertexes = edge.first;
-    if (vertexes.count(srcVertexes.from) && vertexes.count(srcVertexes.to)) {
-      result.insert(edge);
-    }
-  }
+  Graph result = extractGraph(graphs[srcName], vertexes);
   graphs.insert({ std::move(dest), std::move(result) });
 }
 
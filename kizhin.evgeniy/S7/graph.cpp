@@ -1,29 +1,10 @@
 #include "graph.hpp"
-#include <algorithm>
 #include <tuple>
 #include <boost/hash2/fnv1a.hpp>
 #include <boost/hash2/hash_append.hpp>
 
 namespace kizhin {
-  struct VertexEdgeFrom
-  {
-    Vertex lhs{};
-    bool operator()(Graph::const_reference rhs) const
-    {
-      const VertexPair& vertexes = rhs.first;
-      return lhs == vertexes.from;
-    }
-  };
-
-  struct VertexEdgeTo
-  {
-    Vertex lhs{};
-    bool operator()(Graph::const_reference rhs) const
-    {
-      const VertexPair& vertexes = rhs.first;
-      return lhs == vertexes.to;
-    }
-  };
+  void eraseAdjacent(AdjacencyContainer&, const Vertex&, const Vertex&);
 }
 
 std::size_t std::hash< kizhin::VertexPair >::operator()(
@@ -48,13 +29,68 @@ bool kizhin::operator<(const VertexPair& lhs, const VertexPair& rhs)
   return lhsTuple < rhsTuple;
 }
 
+kizhin::WeightContiner& kizhin::insertEdge(Graph& graph, const VertexPair& vertexes)
+{
+  auto inserted = graph.edges.insert({ vertexes, {} });
+  if (inserted.second) {
+    graph.outbound[vertexes.from].insert(vertexes.to);
+    graph.inbound[vertexes.to].insert(vertexes.from);
+  }
+  return inserted.first->second;
+}
+
+void kizhin::eraseEdge(Graph& graph, const EdgeContainer::const_iterator position)
+{
+  const VertexPair& vertexes = position->first;
+  eraseAdjacent(graph.outbound, vertexes.from, vertexes.to);
+  eraseAdjacent(graph.inbound, vertexes.to, vertexes.from);
+  graph.edges.erase(position);
+}
+
+void kizhin::eraseAdjacent(AdjacencyContainer& adjacency, const Vertex& vertex,
+    const Vertex& adjacent)
+{
+  auto pos = adjacency.find(vertex);
+  pos->second.erase(adjacent);
+  if (pos->second.empty()) {
+    adjacency.erase(pos);
+  }
+}
+
+void kizhin::mergeGraph(Graph& dest, const Graph& src)
+{
+  for (const auto& edge: src.edges) {
+    const WeightContiner& weights = edge.second;
+    insertEdge(dest, edge.first).insert(weights.begin(), weights.end());
+  }
+}
+
+kizhin::Graph kizhin::extractGraph(const Graph& src, const VertexContainer& vertexes)
+{
+  Graph result{};
+  for (const Vertex& from: vertexes) {
+    auto outPos = src.outbound.find(from);
+    if (outPos == src.outbound.end()) {
+      continue;
+    }
+    for (const Vertex& to: outPos->second) {
+      if (vertexes.count(to)) {
+        const VertexPair edge{ from, to };
+        insertEdge(result, edge) = src.edges.at(edge);
+      }
+    }
+  }
+  return result;
+}
+
 kizhin::VertexContainer kizhin::getVertices(const Graph& graph)
 {
   VertexContainer result;
-  for (const auto& edge: graph) {
-    const VertexPair& vertexes = edge.first;
-    result.insert(vertexes.from);
-    result.insert(vertexes.to);
+  for (const auto& adjacent: graph.outbound) {
+    result.insert(adjacent.first);
+  }
+  for (const auto& adjacent: graph.inbound) {
+    result.insert(adjacent.first);
   }
   return result;
 }
@@ -62,16 +98,29 @@ kizhin::VertexContainer kizhin::getVertices(const Graph& graph)
 kizhin::SortedGraph kizhin::getOutbound(const Graph& graph, const Vertex& vertex)
 {
   SortedGraph result;
-  auto out = std::inserter(result, result.end());
-  std::copy_if(graph.begin(), graph.end(), out, VertexEdgeFrom{ vertex });
+  auto pos = graph.outbound.find(vertex);
+  if (pos == graph.outbound.end()) {
+    return result;
+  }
+  for (const Vertex& to: pos->second) {
+    VertexPair edge{ vertex, to };
+    const WeightContiner& weights = graph.edges.at(edge);
+    result.emplace_hint(result.end(), std::move(edge), weights);
+  }
   return result;
 }
 
 kizhin::SortedGraph kizhin::getInbound(const Graph& graph, const Vertex& vertex)
 {
   SortedGraph result;
-  auto out = std::inserter(result, result.end());
-  std::copy_if(graph.begin(), graph.end(), out, VertexEdgeTo{ vertex });
+  auto pos = graph.inbound.find(vertex);
+  if (pos == graph.inbound.end()) {
+    return result;
+  }
+  for (const Vertex& from: pos->second) {
+    VertexPair edge{ from, vertex };
+    const WeightContiner& weights = graph.edges.at(edge);
+    result.emplace_hint(result.end(), std::move(edge), weights);
+  }
   return result;
 }
-
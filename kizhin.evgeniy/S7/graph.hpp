@@ -30,9 +30,22 @@ namespace kizhin {
   bool operator==(const VertexPair&, const VertexPair&);
   bool operator<(const VertexPair&, const VertexPair&);
 
-  using Graph = UnorderedMap< VertexPair, WeightContiner >;
+  using EdgeContainer = UnorderedMap< VertexPair, WeightContiner >;
   using VertexContainer = std::set< Vertex >;
-  using SortedGraph = std::map< Graph::key_type, Graph::mapped_type >;
+  using AdjacencyContainer = UnorderedMap< Vertex, VertexContainer >;
+  using SortedGraph = std::map< EdgeContainer::key_type, EdgeContainer::mapped_type >;
+
+  struct Graph
+  {
+    EdgeContainer edges{};
+    AdjacencyContainer outbound{};
+    AdjacencyContainer inbound{};
+  };
+
+  WeightContiner& insertEdge(Graph&, const VertexPair&);
+  void eraseEdge(Graph&, EdgeContainer::const_iterator);
+  void mergeGraph(Graph&, const Graph&);
+  Graph extractGraph(const Graph&, const VertexContainer&);
 
   VertexContainer getVertices(const Graph&);
   SortedGraph getOutbound(const Graph&, const Vertex&);
@@ -40,4 +53,3 @@ namespace kizhin {
 }
 
 #endif
-
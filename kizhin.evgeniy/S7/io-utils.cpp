@@ -33,15 +33,15 @@ std::istream& kizhin::operator>>(std::istream& in, Graph& dest)
   Graph input{};
   std::size_t count{};
   in >> count;
-  while (in && count != input.size()) {
+  while (in && count != input.edges.size()) {
     Vertex from{};
     Vertex to{};
     Weight weight{};
     if (in >> from >> to >> weight) {
-      input[{ std::move(from), std::move(to) }].insert(weight);
+      insertEdge(input, { std::move(from), std::move(to) }).insert(weight);
     }
   }
-  if (input.size() == count) {
+  if (input.edges.size() == count) {
     in.clear();
     dest = std::move(input);
   }
@@ -0,0 +1,116 @@
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include "graph.hpp"
+
+using kizhin::Graph;
+using kizhin::SortedGraph;
+using kizhin::VertexContainer;
+
+void testGraphInvariants(const Graph& graph)
+{
+  std::size_t outboundCount = 0;
+  for (const auto& adjacent: graph.outbound) {
+    BOOST_TEST(!adjacent.second.empty());
+    outboundCount += adjacent.second.size();
+    for (const auto& to: adjacent.second) {
+      BOOST_TEST(graph.edges.count({ adjacent.first, to }) == 1);
+    }
+  }
+  std::size_t inboundCount = 0;
+  for (const auto& adjacent: graph.inbound) {
+    BOOST_TEST(!adjacent.second.empty());
+    inboundCount += adjacent.second.size();
+    for (const auto& from: adjacent.second) {
+      BOOST_TEST(graph.edges.count({ from, adjacent.first }) == 1);
+    }
+  }
+  BOOST_TEST(outboundCount == graph.edges.size());
+  BOOST_TEST(inboundCount == graph.edges.size());
+  for (const auto& edge: graph.edges) {
+    const SortedGraph outbound = kizhin::getOutbound(graph, edge.first.from);
+    const SortedGraph inbound = kizhin::getInbound(graph, edge.first.to);
+    BOOST_TEST(outbound.count(edge.first) == 1);
+    BOOST_TEST(inbound.count(edge.first) == 1);
+    BOOST_TEST((outbound.at(edge.first) == edge.second));
+    BOOST_TEST((inbound.at(edge.first) == edge.second));
+  }
+}
+
+Graph makeGraph()
+{
+  Graph graph;
+  kizhin::insertEdge(graph, { "a", "b" }).insert(1);
+  kizhin::insertEdge(graph, { "a", "c" }).insert(2);
+  kizhin::insertEdge(graph, { "b", "c" }).insert(3);
+  kizhin::insertEdge(graph, { "c", "a" }).insert(4);
+  kizhin::insertEdge(graph, { "c", "d" }).insert(5);
+  return graph;
+}
+
+BOOST_AUTO_TEST_SUITE(graph);
+
+BOOST_AUTO_TEST_CASE(insert_edge)
+{
+  Graph graph = makeGraph();
+  kizhin::insertEdge(graph, { "a", "b" }).insert(6);
+  testGraphInvariants(graph);
+  BOOST_TEST(graph.edges.size() == 5);
+  BOOST_TEST(graph.edges.at({ "a", "b" }).size() == 2);
+  BOOST_TEST((kizhin::getVertices(graph) == VertexContainer{ "a", "b", "c", "d" }));
+}
+
+BOOST_AUTO_TEST_CASE(erase_edge)
+{
+  Graph graph = makeGraph();
+  kizhin::eraseEdge(graph, graph.edges.find({ "a", "c" }));
+  testGraphInvariants(graph);
+  BOOST_TEST(graph.edges.size() == 4);
+  BOOST_TEST(kizhin::getOutbound(graph, "a").size() == 1);
+  BOOST_TEST(kizhin::getInbound(graph, "c").size() == 1);
+  BOOST_TEST((kizhin::getVertices(graph) == VertexContainer{ "a", "b", "c", "d" }));
+}
+
+BOOST_AUTO_TEST_CASE(erase_last_edges_of_vertex)
+{
+  Graph graph = makeGraph();
+  kizhin::eraseEdge(graph, graph.edges.find({ "c", "d" }));
+  testGraphInvariants(graph);
+  BOOST_TEST(graph.inbound.count("d") == 0);
+  BOOST_TEST(kizhin::getInbound(graph, "d").empty());
+  BOOST_TEST((kizhin::getVertices(graph) == VertexContainer{ "a", "b", "c" }));
+  kizhin::eraseEdge(graph, graph.edges.find({ "a", "b" }));
+  kizhin::eraseEdge(graph, graph.edges.find({ "b", "c" }));
+  testGraphInvariants(graph);
+  BOOST_TEST(graph.outbound.count("b") == 0);
+  BOOST_TEST(graph.inbound.count("b") == 0);
+  BOOST_TEST((kizhin::getVertices(graph) == VertexContainer{ "a", "c" }));
+}
+
+BOOST_AUTO_TEST_CASE(merge_graph)
+{
+  Graph dest = makeGraph();
+  Graph src;
+  kizhin::insertEdge(src, { "a", "b" }).insert(7);
+  kizhin::insertEdge(src, { "d", "e" }).insert(8);
+  kizhin::insertEdge(src, { "e", "a" }).insert(9);
+  kizhin::mergeGraph(dest, src);
+  testGraphInvariants(dest);
+  testGraphInvariants(src);
+  BOOST_TEST(dest.edges.size() == 7);
+  BOOST_TEST((dest.edges.at({ "a", "b" }) == kizhin::WeightContiner{ 1, 7 }));
+  BOOST_TEST(kizhin::getOutbound(dest, "d").size() == 1);
+  BOOST_TEST(kizhin::getInbound(dest, "a").size() == 2);
+  BOOST_TEST((kizhin::getVertices(dest) == VertexContainer{ "a", "b", "c", "d", "e" }));
+}
+
+BOOST_AUTO_TEST_CASE(extract_graph)
+{
+  const Graph src = makeGraph();
+  const Graph result = kizhin::extractGraph(src, { "a", "c", "d" });
+  testGraphInvariants(result);
+  BOOST_TEST(result.edges.size() == 3);
+  BOOST_TEST(result.edges.count({ "a", "b" }) == 0);
+  BOOST_TEST((kizhin::getVertices(result) == VertexContainer{ "a", "c", "d" }));
+}
+
+BOOST_AUTO_TEST_SUITE_END();
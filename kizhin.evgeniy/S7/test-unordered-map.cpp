@@ -1,3 +1,5 @@
+#include <map>
+#include <string>
 #include <boost/test/unit_test.hpp>
 #include <boost/test/unit_test_suite.hpp>
 #include <unordered-map.hpp>
@@ -185,6 +187,128 @@ BOOST_AUTO_TEST_CASE(erase_existing_key)
   BOOST_TEST((map.find(1) == map.end()));
 }
 
+BOOST_AUTO_TEST_CASE(erase_keeps_colliding_keys)
+{
+  UnorderedMapT map;
+  map.reserve(8);
+  const std::size_t buckets = map.bucketCount();
+  for (int i = 0; i != 5; ++i) {
+    map[i * static_cast< int >(buckets)] = i;
+  }
+  map.erase(0);
+  map.erase(2 * static_cast< int >(buckets));
+  testUnorderedMapInvariants(map);
+  BOOST_TEST(map.size() == 3);
+  BOOST_TEST(map.count(0) == 0);
+  BOOST_TEST(map.at(static_cast< int >(buckets)) == 1);
+  BOOST_TEST(map.at(3 * static_cast< int >(buckets)) == 3);
+  BOOST_TEST(map.at(4 * static_cast< int >(buckets)) == 4);
+}
+
+BOOST_AUTO_TEST_CASE(erase_range)
+{
+  UnorderedMapT map;
+  for (int i = 0; i != 100; ++i) {
+    map[i] = i;
+  }
+  map.erase(map.begin(), map.end());
+  testUnorderedMapInvariants(map);
+  BOOST_TEST(map.empty());
+}
+
+BOOST_AUTO_TEST_CASE(erase_while_iterating_past_last_bucket)
+{
+  UnorderedMapT map;
+  map.reserve(8);
+  const int buckets = static_cast< int >(map.bucketCount());
+  for (int i = 0; i != 4; ++i) {
+    map[buckets - 1 + i * buckets] = i;
+  }
+  map[0] = 4;
+  map[1] = 5;
+  std::map< int, int > visits;
+  for (auto it = map.begin(); it != map.end();) {
+    ++visits[it->first];
+    it = it->second % 2 == 0 ? map.erase(it) : std::next(it);
+  }
+  testUnorderedMapInvariants(map);
+  BOOST_TEST(map.size() == 3);
+  BOOST_TEST(visits.size() == 6);
+  for (const auto& visit: visits) {
+    BOOST_TEST(visit.second == 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(erase_range_past_last_bucket)
+{
+  UnorderedMapT map;
+  map.reserve(8);
+  const int buckets = static_cast< int >(map.bucketCount());
+  for (int i = 0; i != 4; ++i) {
+    map[buckets - 1 + i * buckets] = i;
+  }
+  map[0] = 4;
+  map[1] = 5;
+  auto first = map.find(buckets - 1);
+  std::map< int, int > kept(map.begin(), first);
+  const auto erased = std::distance(first, map.end());
+  BOOST_TEST((map.erase(first, map.end()) == map.end()));
+  testUnorderedMapInvariants(map);
+  BOOST_TEST(map.size() == 6 - erased);
+  BOOST_TEST((std::map< int, int >(map.begin(), map.end()) == kept));
+}
+
+BOOST_AUTO_TEST_CASE(long_run_past_last_bucket_does_not_grow_table)
+{
+  for (const int shift: { 24, 40 }) {
+    kizhin::UnorderedMap< long long, int > map;
+    for (int k = 1; k <= 40; ++k) {
+      map[(static_cast< long long >(k) << shift) - 1] = k;
+    }
+    BOOST_TEST(map.size() == 40);
+    BOOST_TEST(map.bucketCount() <= 128);
+    BOOST_TEST(std::distance(map.begin(), map.end()) == 40);
+    for (int k = 1; k <= 40; k += 2) {
+      BOOST_TEST(map.erase((static_cast< long long >(k) << shift) - 1) == 1);
+    }
+    for (int k = 1; k <= 40; ++k) {
+      BOOST_TEST(map.count((static_cast< long long >(k) << shift) - 1) == (k % 2 == 0 ? 1 : 0));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(string_keys_survive_rehash_and_erase)
+{
+  kizhin::UnorderedMap< std::string, std::string > map;
+  for (int i = 0; i != 200; ++i) {
+    map[std::to_string(i) + " long enough to live on the heap"] = std::to_string(i);
+  }
+  for (int i = 0; i < 200; i += 2) {
+    BOOST_TEST(map.erase(std::to_string(i) + " long enough to live on the heap") == 1);
+  }
+  BOOST_TEST(map.size() == 100);
+  for (int i = 1; i < 200; i += 2) {
+    BOOST_TEST(map.at(std::to_string(i) + " long enough to live on the heap") == std::to_string(i));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(insert_erase_churn)
+{
+  UnorderedMapT map;
+  for (int i = 0; i != 1000; ++i) {
+    map[i] = i;
+    if (i % 3 == 0) {
+      BOOST_TEST(map.erase(i / 2) <= 1);
+    }
+  }
+  testUnorderedMapInvariants(map);
+  for (int i = 0; i != 1000; ++i) {
+    const bool erased = i <= 499 && (i * 2 % 3 == 0 || (i * 2 + 1) % 3 == 0);
+    BOOST_TEST(map.count(i) == (erased ? 0 : 1));
+  }
+  BOOST_TEST(map.count(1000) == 0);
+}
+
 BOOST_AUTO_TEST_CASE(clear)
 {
   UnorderedMapT map = { { 1, 1 } };
@@ -0,0 +1,152 @@
+#ifndef SPBSPU_LABS_2025_AADS_A_KIZHIN_EVGENIY_COMMON_INTERNAL_MAP_NODE_POOL_HPP
+#define SPBSPU_LABS_2025_AADS_A_KIZHIN_EVGENIY_COMMON_INTERNAL_MAP_NODE_POOL_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace kizhin {
+  namespace detail {
+    constexpr std::size_t minSlabSize = 4;
+    constexpr std::size_t maxSlabSize = 1024;
+
+    template < typename Node >
+    class NodePool final
+    {
+    public:
+      NodePool() noexcept = default;
+      NodePool(const NodePool&) = delete;
+      NodePool(NodePool&&) noexcept;
+      ~NodePool();
+
+      NodePool& operator=(const NodePool&) = delete;
+      NodePool& operator=(NodePool&&) noexcept;
+
+      Node* create();
+      void destroy(Node*) noexcept;
+      void release() noexcept;
+      void swap(NodePool&) noexcept;
+
+    private:
+      union Slot
+      {
+        Slot* next;
+        alignas(Node) char storage[sizeof(Node)];
+      };
+
+      struct alignas(Slot) Slab
+      {
+        Slab* next;
+        std::size_t size;
+
+        Slot* slots() noexcept { return reinterpret_cast< Slot* >(this + 1); }
+      };
+
+      static_assert(alignof(Slot) <= alignof(std::max_align_t), "Over-aligned node");
+
+      Slab* slabs_ = nullptr;
+      Slot* free_ = nullptr;
+      std::size_t used_ = 0;
+
+      Slot* allocate();
+    };
+
+    template < typename Node >
+    class NodeDeleter final
+    {
+    public:
+      explicit NodeDeleter(NodePool< Node >* pool = nullptr) noexcept:
+        pool_(pool)
+      {}
+
+      void operator()(Node* node) const noexcept
+      {
+        assert(pool_ && "NodeDeleter: pool is not set");
+        pool_->destroy(node);
+      }
+
+    private:
+      NodePool< Node >* pool_;
+    };
+  }
+}
+
+template < typename Node >
+kizhin::detail::NodePool< Node >::NodePool(NodePool&& rhs) noexcept:
+  slabs_(std::exchange(rhs.slabs_, nullptr)),
+  free_(std::exchange(rhs.free_, nullptr)),
+  used_(std::exchange(rhs.used_, 0))
+{}
+
+template < typename Node >
+kizhin::detail::NodePool< Node >::~NodePool()
+{
+  release();
+}
+
+template < typename Node >
+auto kizhin::detail::NodePool< Node >::operator=(NodePool&& rhs) noexcept -> NodePool&
+{
+  NodePool(std::move(rhs)).swap(*this);
+  return *this;
+}
+
+template < typename Node >
+Node* kizhin::detail::NodePool< Node >::create()
+{
+  Slot* slot = allocate();
+  try {
+    return new (slot->storage) Node;
+  } catch (...) {
+    slot->next = std::exchange(free_, slot);
+    throw;
+  }
+}
+
+template < typename Node >
+void kizhin::detail::NodePool< Node >::destroy(Node* node) noexcept
+{
+  if (!node) {
+    return;
+  }
+  node->~Node();
+  Slot* slot = reinterpret_cast< Slot* >(node);
+  slot->next = std::exchange(free_, slot);
+}
+
+template < typename Node >
+void kizhin::detail::NodePool< Node >::release() noexcept
+{
+  while (slabs_) {
+    ::operator delete(std::exchange(slabs_, slabs_->next));
+  }
+  free_ = nullptr;
+  used_ = 0;
+}
+
+template < typename Node >
+void kizhin::detail::NodePool< Node >::swap(NodePool& rhs) noexcept
+{
+  std::swap(slabs_, rhs.slabs_);
+  std::swap(free_, rhs.free_);
+  std::swap(used_, rhs.used_);
+}
+
+template < typename Node >
+auto kizhin::detail::NodePool< Node >::allocate() -> Slot*
+{
+  if (free_) {
+    return std::exchange(free_, free_->next);
+  }
+  if (!slabs_ || used_ == slabs_->size) {
+    const std::size_t size = slabs_ ? std::min(slabs_->size * 2, maxSlabSize) : minSlabSize;
+    void* memory = ::operator new(sizeof(Slab) + size * sizeof(Slot));
+    slabs_ = new (memory) Slab{ slabs_, size };
+    used_ = 0;
+  }
+  return slabs_->slots() + used_++;
+}
+
+#endif
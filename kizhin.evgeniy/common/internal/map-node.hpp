@@ -17,16 +17,21 @@ namespace kizhin {
     template < typename T >
     struct Node final
     {
-      alignas(T) char buffer[maxValues * sizeof(T)];
-      T* begin = reinterpret_cast< T* >(buffer);
-      T* end = reinterpret_cast< T* >(buffer);
       std::array< Node*, maxChildren > children{};
       Node* parent = nullptr;
+      unsigned char count = 0;
+      alignas(T) char buffer[maxValues * sizeof(T)];
 
       Node() = default;
       Node(const Node&) = delete;
       ~Node() { clear(this); }
       Node& operator=(const Node&) = delete;
+
+      T* begin() const noexcept
+      {
+        return reinterpret_cast< T* >(const_cast< char* >(buffer));
+      }
+      T* end() const noexcept { return begin() + count; }
     };
 
     template < typename NodePtr >
@@ -81,22 +86,22 @@ template < typename NodePtr >
 void kizhin::detail::clear(NodePtr node) noexcept
 {
   assert(node && "Clear: nullptr node given");
-  kizhin::destroy(node->begin, node->end);
-  node->end = node->begin;
+  kizhin::destroy(node->begin(), node->end());
+  node->count = 0;
 }
 
 template < typename NodePtr >
 std::size_t kizhin::detail::size(NodePtr node) noexcept
 {
   assert(node && "Size: nullptr node given");
-  return node->end - node->begin;
+  return node->count;
 }
 
 template < typename NodePtr >
 bool kizhin::detail::isEmpty(NodePtr node) noexcept
 {
   assert(node && "IsEmpty: nullptr node given");
-  return node->end == node->begin;
+  return node->count == 0;
 }
 
 template < typename NodePtr >
@@ -224,20 +229,20 @@ std::tuple< NodePtr, ValPtr > kizhin::detail::nextIter(NodePtr node, ValPtr valu
 {
   assert(node && valuePtr && "Incrementing empty iterator");
   if (!isLeaf(node)) {
-    node = treeMin(node->children[(valuePtr - node->begin) + 1]);
-    return std::make_tuple(node, node->begin);
+    node = treeMin(node->children[(valuePtr - node->begin()) + 1]);
+    return std::make_tuple(node, node->begin());
   }
-  if (valuePtr + 1 != node->end) {
+  if (valuePtr + 1 != node->end()) {
     return std::make_tuple(node, ++valuePtr);
   }
   NodePtr firstChild = node->children[1];
   if (firstChild && isEmpty(firstChild)) {
-    return std::make_tuple(firstChild, firstChild->begin);
+    return std::make_tuple(firstChild, firstChild->begin());
   }
   while (node->parent) {
     NodePtr parent = node->parent;
     if (isLeft(node) || (isThree(parent) && isMiddle(node))) {
-      valuePtr = isLeft(node) ? parent->begin : parent->begin + 1;
+      valuePtr = isLeft(node) ? parent->begin() : parent->begin() + 1;
       return std::make_tuple(parent, valuePtr);
     }
     node = parent;
@@ -250,20 +255,20 @@ std::tuple< NodePtr, ValPtr > kizhin::detail::prevIter(NodePtr node, ValPtr valu
 {
   assert(node && valuePtr && "Decrementing empty iterator");
   if (isEmpty(node)) {
-    return std::make_tuple(node->parent, node->parent->end - 1);
+    return std::make_tuple(node->parent, node->parent->end() - 1);
   }
   if (!isLeaf(node)) {
-    node = treeMax(node->children[valuePtr - node->begin]);
-    return std::make_tuple(node, node->end - 1);
+    node = treeMax(node->children[valuePtr - node->begin()]);
+    return std::make_tuple(node, node->end() - 1);
   }
-  if (valuePtr != node->begin) {
+  if (valuePtr != node->begin()) {
     return std::make_tuple(node, --valuePtr);
   }
   while (node->parent) {
     NodePtr parent = node->parent;
     if (!isLeft(node)) {
       const bool useBegin = !(size(parent) == 1 || isMiddle(node));
-      return std::make_tuple(parent, parent->begin + useBegin);
+      return std::make_tuple(parent, parent->begin() + useBegin);
     }
     node = parent;
   }
@@ -275,9 +280,9 @@ void kizhin::detail::emplaceBack(NodePtr node, Args&&... args)
 {
   assert(node && "EmplaceBack: nullptr node given");
   assert(size(node) < maxValues && "EmplaceBack: filled node given");
-  using value_type = std::remove_reference_t< decltype(*(node->begin)) >;
-  new (node->end) value_type(std::forward< Args >(args)...);
-  ++node->end;
+  using value_type = std::remove_reference_t< decltype(*(node->begin())) >;
+  new (node->end()) value_type(std::forward< Args >(args)...);
+  ++node->count;
 }
 
 template < typename NodePtr, typename Cmp, typename... Args >
@@ -286,14 +291,14 @@ void kizhin::detail::emplace(NodePtr src, NodePtr dest, Cmp cmp, Args&&... args)
   assert(src && dest && "Emplace: nullptr node given");
   assert(size(src) < maxValues && "Emplace: filled node given");
   assert(isEmpty(dest) && "Emplace: non-empty node given");
-  using value_type = std::remove_reference_t< decltype(*(src->begin)) >;
+  using value_type = std::remove_reference_t< decltype(*(src->begin())) >;
   value_type val(std::forward< Args >(args)...);
-  auto i = src->begin;
-  while (i != src->end && cmp(*i, val)) {
+  auto i = src->begin();
+  while (i != src->end() && cmp(*i, val)) {
     emplaceBack(dest, std::move_if_noexcept(*(i++)));
   }
   emplaceBack(dest, std::move(val));
-  while (i != src->end) {
+  while (i != src->end()) {
     emplaceBack(dest, std::move_if_noexcept(*(i++)));
   }
 }
@@ -303,9 +308,9 @@ void kizhin::detail::popBack(NodePtr node) noexcept
 {
   assert(node && "PopBack: nullptr node given");
   assert(!isEmpty(node) && "PopBack: non-empty node given");
-  using value_type = std::remove_reference_t< decltype(*(node->begin)) >;
-  (node->end - 1)->~value_type();
-  --node->end;
+  using value_type = std::remove_reference_t< decltype(*(node->begin())) >;
+  (node->end() - 1)->~value_type();
+  --node->count;
 }
 
 template < typename NodePtr, typename ValPtr >
@@ -313,13 +318,13 @@ void kizhin::detail::pop(NodePtr src, NodePtr dest, ValPtr val)
 {
   assert(src && dest && "Pop: nullptr node given");
   assert(isEmpty(dest) && "Pop: non-empty node given");
-  assert(val >= src->begin && val < src->end && "Pop: invalid val given");
-  auto i = src->begin;
+  assert(val >= src->begin() && val < src->end() && "Pop: invalid val given");
+  auto i = src->begin();
   while (i != val) {
     emplaceBack(dest, std::move_if_noexcept(*(i++)));
   }
   ++i;
-  while (i != src->end) {
+  while (i != src->end()) {
     emplaceBack(dest, std::move_if_noexcept(*(i++)));
   }
 }
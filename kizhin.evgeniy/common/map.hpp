@@ -2,11 +2,13 @@
 #define SPBSPU_LABS_2025_AADS_A_KIZHIN_EVGENIY_COMMON_MAP_HPP
 
 #include <algorithm>
+#include <iterator>
 #include <memory>
 #include <tuple>
 #include <utility>
+#include "buffer.hpp"
+#include "internal/map-node-pool.hpp"
 #include "internal/map-node.hpp"
-#include "queue.hpp"
 #include "stack.hpp"
 #include "type-utils.hpp"
 
@@ -151,8 +153,10 @@ namespace kizhin {
 
   private:
     using Node = detail::Node< value_type >;
+    using NodeHolder = std::unique_ptr< Node, detail::NodeDeleter< Node > >;
     class EndNodeGuard;
 
+    detail::NodePool< Node > pool_;
     Node* root_ = nullptr;
     size_type size_ = 0;
     Comparator comparator_;
@@ -160,6 +164,20 @@ namespace kizhin {
     void deallocate() noexcept;
     Node* getEndNode() const noexcept;
 
+    Node* createNode();
+    NodeHolder makeNode();
+    void destroyNode(Node*) noexcept;
+
+    template < typename InputIt >
+    void insertRange(InputIt, InputIt, std::input_iterator_tag);
+    template < typename ForwardIt >
+    void insertRange(ForwardIt, ForwardIt, std::forward_iterator_tag);
+    template < typename ForwardIt >
+    bool isStrictlySorted(ForwardIt, ForwardIt) const;
+    template < typename ForwardIt >
+    Node* buildSorted(ForwardIt&, size_type count, size_type childCapacity);
+    void deleteSubtree(Node*) noexcept;
+
     template < typename... Args >
     Node* emplaceToNode(Node*, Args&&...);
     template < typename... Args >
@@ -216,6 +234,15 @@ namespace kizhin {
 
   template < typename K, typename T, typename C >
   void swap(Map< K, T, C >& l, Map< K, T, C >& r) noexcept(noexcept(l.swap(r)));
+
+  template < typename K, typename T, typename C >
+  Map< K, T, C > setUnion(const Map< K, T, C >&, const Map< K, T, C >&);
+
+  template < typename K, typename T, typename C >
+  Map< K, T, C > setIntersection(const Map< K, T, C >&, const Map< K, T, C >&);
+
+  template < typename K, typename T, typename C >
+  Map< K, T, C > setDifference(const Map< K, T, C >&, const Map< K, T, C >&);
 }
 
 template < typename K, typename T, typename C >
@@ -269,7 +296,7 @@ template < typename K, typename T, typename C >
 template < bool IsConst >
 kizhin::Map< K, T, C >::Iterator< IsConst >::Iterator(Node* node) noexcept:
   node_(node),
-  valuePtr_(node ? node->begin : nullptr)
+  valuePtr_(node ? node->begin() : nullptr)
 {}
 
 template < typename K, typename T, typename C >
@@ -425,7 +452,7 @@ kizhin::Map< K, T, C >::LmrIterator< IsConst >::LmrIterator(Node* root):
     root = root->parent;
   }
   while (root && !detail::isEmpty(root)) {
-    values_.emplace(root, root->begin);
+    values_.emplace(root, root->begin());
     root = root->children[0];
   }
   ++(*this);
@@ -444,14 +471,14 @@ auto kizhin::Map< K, T, C >::LmrIterator< IsConst >::operator++() -> LmrIterator
   valuePtr_ = values_.top().second;
   values_.pop();
   Node* next = nullptr;
-  if (valuePtr_ == node_->begin && detail::isThree(node_)) {
+  if (valuePtr_ == node_->begin() && detail::isThree(node_)) {
     values_.emplace(node_, valuePtr_ + 1);
     next = node_->children[1];
   } else {
     next = node_->children[detail::size(node_)];
   }
   while (next && !detail::isEmpty(next)) {
-    values_.emplace(next, next->begin);
+    values_.emplace(next, next->begin());
     next = next->children[0];
   }
   return *this;
@@ -503,7 +530,7 @@ kizhin::Map< K, T, C >::RmlIterator< IsConst >::RmlIterator(Node* root):
     root = root->parent;
   }
   while (root && !detail::isEmpty(root)) {
-    values_.emplace(root, root->end - 1);
+    values_.emplace(root, root->end() - 1);
     root = root->children[detail::size(root)];
   }
   ++(*this);
@@ -522,14 +549,14 @@ auto kizhin::Map< K, T, C >::RmlIterator< IsConst >::operator++() -> RmlIterator
   valuePtr_ = values_.top().second;
   values_.pop();
   Node* next = nullptr;
-  if (valuePtr_ != node_->begin) {
-    values_.emplace(node_, valuePtr_ + 1);
-    next = node_->children[valuePtr_ == node_->begin + 1];
+  if (valuePtr_ != node_->begin()) {
+    values_.emplace(node_, valuePtr_ - 1);
+    next = node_->children[valuePtr_ - node_->begin()];
   } else {
     next = node_->children[0];
   }
   while (next && !detail::isEmpty(next)) {
-    values_.emplace(next, next->begin);
+    values_.emplace(next, next->end() - 1);
     next = next->children[detail::size(next)];
   }
   return *this;
@@ -547,7 +574,9 @@ public:
   template < bool RhsConst, std::enable_if_t< IsConst && !RhsConst, int > = 0 >
   BfsIterator(const BfsIterator< RhsConst >& rhs):
     HeavyIterator< IsConst >(rhs),
-    nodes_(rhs.nodes_)
+    level_(rhs.level_),
+    nextLevel_(rhs.nextLevel_),
+    position_(rhs.position_)
   {}
   template < bool RhsConst, std::enable_if_t< !IsConst || RhsConst, int > = 0 >
   BfsIterator(Iterator< RhsConst > rhs):
@@ -565,7 +594,9 @@ public:
 private:
   friend class Map;
 
-  Queue< Node* > nodes_{};
+  Buffer< Node* > level_{};
+  Buffer< Node* > nextLevel_{};
+  size_type position_ = 0;
   using HeavyIterator< IsConst >::valuePtr_;
   using HeavyIterator< IsConst >::node_;
 
@@ -581,7 +612,7 @@ kizhin::Map< K, T, C >::BfsIterator< IsConst >::BfsIterator(Node* root):
     root = root->parent;
   }
   if (root) {
-    nodes_.push(root);
+    level_.pushBack(root);
     ++(*this);
   }
 }
@@ -590,21 +621,25 @@ template < typename K, typename T, typename C >
 template < bool IsConst >
 auto kizhin::Map< K, T, C >::BfsIterator< IsConst >::operator++() -> BfsIterator&
 {
-  if (valuePtr_ && valuePtr_ + 1 != node_->end) {
+  if (valuePtr_ && valuePtr_ + 1 != node_->end()) {
     ++valuePtr_;
     return *this;
   }
-  if (nodes_.empty()) {
+  if (position_ == level_.size()) {
+    level_.swap(nextLevel_);
+    nextLevel_.clear();
+    position_ = 0;
+  }
+  if (level_.empty()) {
     valuePtr_ = nullptr;
     node_ = nullptr;
     return *this;
   }
-  node_ = nodes_.front();
-  valuePtr_ = node_->begin;
-  nodes_.pop();
+  node_ = *(level_.begin() + position_++);
+  valuePtr_ = node_->begin();
   for (Node* child: node_->children) {
     if (child && !detail::isEmpty(child)) {
-      nodes_.push(child);
+      nextLevel_.pushBack(child);
     }
   }
   return *this;
@@ -635,6 +670,7 @@ kizhin::Map< K, T, C >::Map(const Map& rhs):
 
 template < typename K, typename T, typename C >
 kizhin::Map< K, T, C >::Map(Map&& rhs) noexcept(is_nothrow_move_constructible):
+  pool_(std::move(rhs.pool_)),
   root_(std::exchange(rhs.root_, nullptr)),
   size_(std::exchange(rhs.size_, 0)),
   comparator_(std::move(rhs.comparator_))
@@ -870,9 +906,8 @@ template < typename K, typename T, typename C >
 template < typename InputIt >
 void kizhin::Map< K, T, C >::insert(InputIt first, const InputIt last)
 {
-  for (; first != last; ++first) {
-    insert(*first);
-  }
+  using category = typename std::iterator_traits< InputIt >::iterator_category;
+  insertRange(first, last, category{});
 }
 
 template < typename K, typename T, typename C >
@@ -891,13 +926,13 @@ typename kizhin::Map< K, T, C >::iterator kizhin::Map< K, T, C >::erase(
   pointer nodePtr = const_cast< pointer >(position.valuePtr_);
   EndNodeGuard guard(this);
   using std::exchange;
-  if (!detail::isLeaf(node) && nodePtr == node->begin) {
+  if (!detail::isLeaf(node) && nodePtr == node->begin()) {
     Node* left = detail::treeMax(node->children[0]);
-    pointer leftPtr = left->end - 1;
+    pointer leftPtr = left->end() - 1;
     swapVals(left, leftPtr, exchange(node, left), exchange(nodePtr, leftPtr));
   } else if (!detail::isLeaf(node)) {
     Node* right = detail::treeMin(node->children[detail::size(node)]);
-    pointer rightPtr = right->begin;
+    pointer rightPtr = right->begin();
     swapVals(right, rightPtr, exchange(node, right), exchange(nodePtr, rightPtr));
   }
   node = eraseFromNode(node, nodePtr);
@@ -944,12 +979,14 @@ void kizhin::Map< K, T, C >::clear() noexcept
     root_ = nullptr;
     size_ = 0;
   }
+  pool_.release();
 }
 
 template < typename K, typename T, typename C >
 void kizhin::Map< K, T, C >::swap(Map& rhs) noexcept(is_nothrow_swappable)
 {
   using std::swap;
+  pool_.swap(rhs.pool_);
   swap(root_, rhs.root_);
   swap(size_, rhs.size_);
   swap(comparator_, rhs.comparator_);
@@ -978,7 +1015,7 @@ typename kizhin::Map< K, T, C >::iterator kizhin::Map< K, T, C >::emplaceHint(
   value_type value{ std::forward< Args >(args)... };
   Node* target = findTarget(hint.node_, value.first);
   pointer valuePtr = findKey(target, value.first);
-  if (valuePtr != target->end) {
+  if (valuePtr != target->end()) {
     return iterator(target, valuePtr);
   }
   const key_type key = value.first;
@@ -1021,7 +1058,7 @@ typename kizhin::Map< K, T, C >::const_iterator kizhin::Map< K, T, C >::find(
   }
   Node* target = findTarget(root_, key);
   pointer valuePtr = findKey(target, key);
-  return valuePtr == target->end ? end() : const_iterator(target, valuePtr);
+  return valuePtr == target->end() ? end() : const_iterator(target, valuePtr);
 }
 
 template < typename K, typename T, typename C >
@@ -1131,7 +1168,7 @@ public:
     assert(!isJoined_ && "EndNode has already joined");
     isJoined_ = true;
     if (owner_->empty()) {
-      delete endNode_;
+      owner_->destroyNode(endNode_);
       return;
     }
     Node* max = detail::treeMax(owner_->root_);
@@ -1151,15 +1188,15 @@ void kizhin::Map< K, T, C >::deallocate() noexcept
   assert(!empty() && "Attempt to deallocate empty tree");
   Node* endNode = getEndNode();
   endNode->parent->children.fill(nullptr);
-  delete endNode;
+  destroyNode(endNode);
   Node* left = root_;
   while (root_->children[0]) {
     left = detail::treeMin(left);
     const auto& rtChildren = root_->children;
     std::copy(rtChildren.begin() + 1, rtChildren.end(), left->children.begin());
-    delete std::exchange(root_, root_->children[0]);
+    destroyNode(std::exchange(root_, root_->children[0]));
   }
-  delete root_;
+  destroyNode(root_);
 }
 
 template < typename K, typename T, typename C >
@@ -1172,6 +1209,111 @@ typename kizhin::Map< K, T, C >::Node* kizhin::Map< K, T, C >::getEndNode() cons
   return detail::isEmpty(max) ? max : max->children[0];
 }
 
+template < typename K, typename T, typename C >
+typename kizhin::Map< K, T, C >::Node* kizhin::Map< K, T, C >::createNode()
+{
+  return pool_.create();
+}
+
+template < typename K, typename T, typename C >
+typename kizhin::Map< K, T, C >::NodeHolder kizhin::Map< K, T, C >::makeNode()
+{
+  return NodeHolder(createNode(), detail::NodeDeleter< Node >(&pool_));
+}
+
+template < typename K, typename T, typename C >
+void kizhin::Map< K, T, C >::destroyNode(Node* node) noexcept
+{
+  pool_.destroy(node);
+}
+
+template < typename K, typename T, typename C >
+template < typename InputIt >
+void kizhin::Map< K, T, C >::insertRange(InputIt first, const InputIt last,
+    std::input_iterator_tag)
+{
+  for (; first != last; ++first) {
+    insert(*first);
+  }
+}
+
+template < typename K, typename T, typename C >
+template < typename ForwardIt >
+void kizhin::Map< K, T, C >::insertRange(ForwardIt first, const ForwardIt last,
+    std::forward_iterator_tag)
+{
+  if (!empty() || first == last || !isStrictlySorted(first, last)) {
+    insertRange(first, last, std::input_iterator_tag{});
+    return;
+  }
+  const size_type count = std::distance(first, last);
+  size_type capacity = 2;
+  while (capacity < count) {
+    capacity = capacity * 3 + 2;
+  }
+  NodeHolder endNode = makeNode();
+  root_ = buildSorted(first, count, (capacity - 2) / 3);
+  size_ = count;
+  Node* max = detail::treeMax(root_);
+  endNode->parent = max;
+  max->children.fill(endNode.release());
+}
+
+template < typename K, typename T, typename C >
+template < typename ForwardIt >
+bool kizhin::Map< K, T, C >::isStrictlySorted(ForwardIt first, const ForwardIt last) const
+{
+  const auto isOutOfOrder = [this](const auto& lhs, const auto& rhs) -> bool
+  {
+    return !comparator_(lhs.first, rhs.first);
+  };
+  return std::adjacent_find(first, last, isOutOfOrder) == last;
+}
+
+template < typename K, typename T, typename C >
+template < typename ForwardIt >
+typename kizhin::Map< K, T, C >::Node* kizhin::Map< K, T, C >::buildSorted(
+    ForwardIt& current, const size_type count, const size_type childCapacity)
+{
+  assert(count > 0 && count <= childCapacity * 3 + 2 && "BuildSorted: invalid count");
+  NodeHolder node = makeNode();
+  if (childCapacity == 0) {
+    for (size_type i = 0; i != count; ++i, ++current) {
+      detail::emplaceBack(node.get(), *current);
+    }
+    return node.release();
+  }
+  const size_type childCount = count - 1 <= childCapacity * 2 ? 2 : 3;
+  const size_type childKeys = count - (childCount - 1);
+  try {
+    for (size_type i = 0; i != childCount; ++i) {
+      const size_type keys = childKeys / childCount + (i < childKeys % childCount);
+      Node* child = buildSorted(current, keys, (childCapacity - 2) / 3);
+      child->parent = node.get();
+      node->children[i] = child;
+      if (i + 1 != childCount) {
+        detail::emplaceBack(node.get(), *current);
+        ++current;
+      }
+    }
+  } catch (...) {
+    deleteSubtree(node.release());
+    throw;
+  }
+  return node.release();
+}
+
+template < typename K, typename T, typename C >
+void kizhin::Map< K, T, C >::deleteSubtree(Node* node) noexcept
+{
+  for (Node* child: node->children) {
+    if (child) {
+      deleteSubtree(child);
+    }
+  }
+  destroyNode(node);
+}
+
 template < typename K, typename T, typename C >
 template < typename... Args >
 typename kizhin::Map< K, T, C >::Node* kizhin::Map< K, T, C >::emplaceToNode(Node* node,
@@ -1182,13 +1324,13 @@ typename kizhin::Map< K, T, C >::Node* kizhin::Map< K, T, C >::emplaceToNode(Nod
     detail::emplaceBack(node, std::forward< Args >(args)...);
     return node;
   }
-  std::unique_ptr< Node > result = std::make_unique< Node >();
+  NodeHolder result = makeNode();
   detail::emplace(node, result.get(), valueComp(), std::forward< Args >(args)...);
   detail::relink(node, result.get());
   if (node == root_) {
     root_ = result.get();
   }
-  delete node;
+  destroyNode(node);
   return result.release();
 }
 
@@ -1198,9 +1340,9 @@ typename kizhin::Map< K, T, C >::iterator kizhin::Map< K, T, C >::emplaceToEmpty
     Args&&... args)
 {
   assert(empty() && "emplaceToEmpty called on non empty Map");
-  root_ = new Node;
+  root_ = createNode();
   detail::emplaceBack(root_, std::forward< Args >(args)...);
-  Node* endNode = new Node;
+  Node* endNode = createNode();
   endNode->parent = root_;
   root_->children.fill(endNode);
   ++size_;
@@ -1212,18 +1354,18 @@ typename kizhin::Map< K, T, C >::Node* kizhin::Map< K, T, C >::eraseFromNode(Nod
     const_pointer valPtr)
 {
   assert(node && valPtr && "eraseFromNode: nullptr given");
-  assert(valPtr >= node->begin && valPtr < node->end && "eraseFromNode: invalid valPtr");
-  if (valPtr == node->end - 1) {
+  assert(valPtr >= node->begin() && valPtr < node->end() && "eraseFromNode: invalid valPtr");
+  if (valPtr == node->end() - 1) {
     detail::popBack(node);
     return node;
   }
-  std::unique_ptr< Node > result = std::make_unique< Node >();
+  NodeHolder result = makeNode();
   detail::pop(node, result.get(), valPtr);
   detail::relink(node, result.get());
   if (node == root_) {
     root_ = result.get();
   }
-  delete node;
+  destroyNode(node);
   return result.release();
 }
 
@@ -1252,14 +1394,14 @@ typename kizhin::Map< K, T, C >::Node* kizhin::Map< K, T, C >::split(Node* node)
   std::tie(left, right) = splitInTwo(node);
   Node* parent = node->parent;
   if (!parent) {
-    parent = new Node;
+    parent = createNode();
     parent->children[0] = node;
     root_ = parent;
   }
-  parent = emplaceToNode(parent, *(node->begin + 1));
+  parent = emplaceToNode(parent, *(node->begin() + 1));
   auto& children = parent->children;
   *std::remove(children.begin(), children.end(), node) = nullptr;
-  delete node;
+  destroyNode(node);
   auto it = std::find(children.begin(), children.end(), nullptr);
   *(it++) = detail::updateParent(left);
   *(it++) = detail::updateParent(right);
@@ -1267,7 +1409,7 @@ typename kizhin::Map< K, T, C >::Node* kizhin::Map< K, T, C >::split(Node* node)
   {
     bool operator()(const Node* lhs, const Node* rhs) const
     {
-      return comp(*(lhs->begin), *(rhs->begin));
+      return comp(*(lhs->begin()), *(rhs->begin()));
     }
     value_compare comp;
   };
@@ -1282,10 +1424,10 @@ kizhin::Map< K, T, C >::splitInTwo(const Node* node)
 {
   assert(node && "splitInTwo: nullptr node given");
   assert(detail::size(node) == 3 && "splitInTwo: node must be filled");
-  std::unique_ptr< Node > left = std::make_unique< Node >();
-  std::unique_ptr< Node > right = std::make_unique< Node >();
-  emplaceToNode(left.get(), *node->begin);
-  emplaceToNode(right.get(), *(node->end - 1));
+  NodeHolder left = makeNode();
+  NodeHolder right = makeNode();
+  emplaceToNode(left.get(), *node->begin());
+  emplaceToNode(right.get(), *(node->end() - 1));
   splitChildren(node, left.get(), right.get());
   return std::make_tuple(left.release(), right.release());
 }
@@ -1314,7 +1456,7 @@ typename kizhin::Map< K, T, C >::pointer kizhin::Map< K, T, C >::findKey(const N
     C comp;
     const key_type& key;
   };
-  return std::find_if(node->begin, node->end, KeyEqual{ keyComp(), key });
+  return std::find_if(node->begin(), node->end(), KeyEqual{ keyComp(), key });
 }
 
 template < typename K, typename T, typename C >
@@ -1323,11 +1465,11 @@ typename kizhin::Map< K, T, C >::Node* kizhin::Map< K, T, C >::findTarget(Node*
 {
   assert(!empty() && "Attempt to find target node in empty tree");
   Node* current = validateHint(hint, key);
-  while (!detail::isLeaf(current) && findKey(current, key) == current->end) {
+  while (!detail::isLeaf(current) && findKey(current, key) == current->end()) {
     const size_t currSize = detail::size(current);
-    if (comparator_(key, current->begin->first)) {
+    if (comparator_(key, current->begin()->first)) {
       current = current->children[0];
-    } else if (currSize == 1 || comparator_(key, (current->begin + 1)->first)) {
+    } else if (currSize == 1 || comparator_(key, (current->begin() + 1)->first)) {
       current = current->children[1];
     } else {
       current = current->children[2];
@@ -1347,8 +1489,8 @@ typename kizhin::Map< K, T, C >::Node* kizhin::Map< K, T, C >::validateHint(Node
   bool isMid = false;
   const Node* current = hint;
   while (current->parent && isValid && !isMid) {
-    const key_type& parFirst = current->parent->begin->first;
-    const key_type& parLast = (current->parent->end - 1)->first;
+    const key_type& parFirst = current->parent->begin()->first;
+    const key_type& parLast = (current->parent->end() - 1)->first;
     isMid = detail::isMiddle(current);
     isValid = isMid && !(keyComp()(key, parFirst) || keyComp()(parLast, key));
     isValid = isValid || (detail::isLeft(current) && !keyComp()(parFirst, key));
@@ -1379,12 +1521,12 @@ typename kizhin::Map< K, T, C >::Node* kizhin::Map< K, T, C >::fixRootUnderflow(
   assert(root && "fixRootUnderflow: nullptr node given");
   assert(root == root_ && "fixRootUnderflow: non-root node given");
   if (detail::isLeaf(root)) {
-    delete std::exchange(root_, nullptr);
+    destroyNode(std::exchange(root_, nullptr));
     return root_;
   }
   Node* newRoot = root_->children[0];
   newRoot->parent = nullptr;
-  delete std::exchange(root_, newRoot);
+  destroyNode(std::exchange(root_, newRoot));
   return root_;
 }
 
@@ -1411,7 +1553,7 @@ typename kizhin::Map< K, T, C >::Node* kizhin::Map< K, T, C >::merge(Node* node)
   using detail::getLeftSibling;
   using detail::getRightSibling;
   Node* sibling = detail::isLeft(node) ? getRightSibling(node) : getLeftSibling(node);
-  sibling = emplaceToNode(sibling, std::move_if_noexcept(*parent->begin));
+  sibling = emplaceToNode(sibling, std::move_if_noexcept(*parent->begin()));
   if (detail::isRight(node)) {
     sibling->children[2] = node->children[0];
   } else {
@@ -1419,7 +1561,7 @@ typename kizhin::Map< K, T, C >::Node* kizhin::Map< K, T, C >::merge(Node* node)
     sibling->children[0] = node->children[0];
   }
   *std::remove(parent->children.begin(), parent->children.end(), node) = nullptr;
-  delete node;
+  destroyNode(node);
   detail::clear(parent);
   return detail::updateParent(sibling);
 }
@@ -1449,7 +1591,7 @@ typename kizhin::Map< K, T, C >::Node* kizhin::Map< K, T, C >::giveToSibling(Nod
   const auto getLeft = detail::getLeftSibling< Node* >;
   Node* parent = node->parent;
   Node* sibling = detail::isLeft(node) ? getRight(node) : getLeft(node);
-  pointer parentPtr = detail::isRight(node) ? parent->end - 1 : parent->begin;
+  pointer parentPtr = detail::isRight(node) ? parent->end() - 1 : parent->begin();
   sibling = emplaceToNode(sibling, *parentPtr);
   parent = eraseFromNode(parent, parentPtr);
   if (detail::isLeft(node)) {
@@ -1460,7 +1602,7 @@ typename kizhin::Map< K, T, C >::Node* kizhin::Map< K, T, C >::giveToSibling(Nod
     sibling->children[2] = node->children[0];
   }
   *std::remove(parent->children.begin(), parent->children.end(), node) = nullptr;
-  delete node;
+  destroyNode(node);
   return detail::updateParent(sibling);
 }
 
@@ -1504,11 +1646,11 @@ typename kizhin::Map< K, T, C >::Node* kizhin::Map< K, T, C >::borrowFromLeft(No
   assert(node != sibling && isThree(sibling) && "BorrowFromLeft: invalid sibling");
   assert(!detail::isLeft(node) && "BorrowFromLeft: left node given");
   Node* parent = node->parent;
-  pointer const parentPtr = detail::isRight(node) ? parent->end - 1 : parent->begin;
+  pointer const parentPtr = detail::isRight(node) ? parent->end() - 1 : parent->begin();
   node = emplaceToNode(node, *parentPtr);
   parent = eraseFromNode(parent, parentPtr);
-  parent = emplaceToNode(parent, *(sibling->end - 1));
-  sibling = eraseFromNode(sibling, sibling->end - 1);
+  parent = emplaceToNode(parent, *(sibling->end() - 1));
+  sibling = eraseFromNode(sibling, sibling->end() - 1);
   return node;
 }
 
@@ -1521,11 +1663,11 @@ typename kizhin::Map< K, T, C >::Node* kizhin::Map< K, T, C >::borrowFromRight(N
   assert(node != sibling && isThree(sibling) && "BorrowFromRight: invalid sibling");
   assert(!detail::isRight(node) && "BorrowFromRight: left node given");
   Node* parent = node->parent;
-  pointer const parentPtr = detail::isLeft(node) ? parent->begin : parent->end - 1;
+  pointer const parentPtr = detail::isLeft(node) ? parent->begin() : parent->end() - 1;
   node = emplaceToNode(node, *parentPtr);
   parent = eraseFromNode(parent, parentPtr);
-  parent = emplaceToNode(parent, *sibling->begin);
-  sibling = eraseFromNode(sibling, sibling->begin);
+  parent = emplaceToNode(parent, *sibling->begin());
+  sibling = eraseFromNode(sibling, sibling->begin());
   return node;
 }
 
@@ -1573,5 +1715,77 @@ void kizhin::swap(Map< K, T, C >& lhs, Map< K, T, C >& rhs) noexcept(
   lhs.swap(rhs);
 }
 
+template < typename K, typename T, typename C >
+kizhin::Map< K, T, C > kizhin::setUnion(const Map< K, T, C >& lhs,
+    const Map< K, T, C >& rhs)
+{
+  const auto comp = lhs.valueComp();
+  Buffer< std::pair< K, T > > result;
+  auto lhsIt = lhs.begin();
+  auto rhsIt = rhs.begin();
+  while (lhsIt != lhs.end() && rhsIt != rhs.end()) {
+    if (comp(*lhsIt, *rhsIt)) {
+      result.emplaceBack(*(lhsIt++));
+    } else if (comp(*rhsIt, *lhsIt)) {
+      result.emplaceBack(*(rhsIt++));
+    } else {
+      result.emplaceBack(*(lhsIt++));
+      ++rhsIt;
+    }
+  }
+  for (; lhsIt != lhs.end(); ++lhsIt) {
+    result.emplaceBack(*lhsIt);
+  }
+  for (; rhsIt != rhs.end(); ++rhsIt) {
+    result.emplaceBack(*rhsIt);
+  }
+  const auto first = std::make_move_iterator(result.begin());
+  const auto last = std::make_move_iterator(result.end());
+  return Map< K, T, C >(first, last, lhs.keyComp());
+}
+
+template < typename K, typename T, typename C >
+kizhin::Map< K, T, C > kizhin::setIntersection(const Map< K, T, C >& lhs,
+    const Map< K, T, C >& rhs)
+{
+  const auto comp = lhs.valueComp();
+  Buffer< std::pair< K, T > > result;
+  auto lhsIt = lhs.begin();
+  auto rhsIt = rhs.begin();
+  while (lhsIt != lhs.end() && rhsIt != rhs.end()) {
+    if (comp(*lhsIt, *rhsIt)) {
+      ++lhsIt;
+    } else if (comp(*rhsIt, *lhsIt)) {
+      ++rhsIt;
+    } else {
+      result.emplaceBack(*(lhsIt++));
+      ++rhsIt;
+    }
+  }
+  const auto first = std::make_move_iterator(result.begin());
+  const auto last = std::make_move_iterator(result.end());
+  return Map< K, T, C >(first, last, lhs.keyComp());
+}
+
+template < typename K, typename T, typename C >
+kizhin::Map< K, T, C > kizhin::setDifference(const Map< K, T, C >& lhs,
+    const Map< K, T, C >& rhs)
+{
+  const auto comp = lhs.valueComp();
+  Buffer< std::pair< K, T > > result;
+  auto rhsIt = rhs.begin();
+  for (auto lhsIt = lhs.begin(); lhsIt != lhs.end(); ++lhsIt) {
+    while (rhsIt != rhs.end() && comp(*rhsIt, *lhsIt)) {
+      ++rhsIt;
+    }
+    if (rhsIt == rhs.end() || comp(*lhsIt, *rhsIt)) {
+      result.emplaceBack(*lhsIt);
+    }
+  }
+  const auto first = std::make_move_iterator(result.begin());
+  const auto last = std::make_move_iterator(result.end());
+  return Map< K, T, C >(first, last, lhs.keyComp());
+}
+
 #endif
 
@@ -5,6 +5,7 @@
 #include <cassert>
 #include <cmath>
 #include <functional>
+#include <iterator>
 #include <stdexcept>
 #include <utility>
 
@@ -95,18 +96,25 @@ namespace kizhin {
 
     Node* begin_ = nullptr;
     Node* end_ = nullptr;
+    size_type buckets_ = 0;
     size_type size_ = 0;
     float maxLoadFact_ = 0.75;
+
+    Node* homeOf(const key_type&) const;
+    void growTail();
+    Node* insertUnique(value_type&&);
+    Node* insertAt(Node*, size_type, value_type&&);
+    static value_type& valueOf(Node*) noexcept;
   };
 
   template < typename K, typename T, typename H, typename E >
   struct UnorderedMap< K, T, H, E >::Node
   {
     alignas(value_type) char value[sizeof(value_type)];
+    size_type distance = 0;
     enum {
       empty,
       occupied,
-      deleted,
     } state = empty;
   };
 
@@ -225,6 +233,7 @@ namespace kizhin {
   UnorderedMap< K, T, H, E >::UnorderedMap(UnorderedMap&& rhs) noexcept:
     begin_(std::exchange(rhs.begin_, nullptr)),
     end_(std::exchange(rhs.end_, nullptr)),
+    buckets_(std::exchange(rhs.buckets_, 0)),
     size_(std::exchange(rhs.size_, 0)),
     maxLoadFact_(rhs.maxLoadFact_)
   {}
@@ -347,16 +356,13 @@ namespace kizhin {
     if (empty()) {
       return end();
     }
-    const size_type capacity = bucketCount();
-    Node* curr = begin_ + hashFunc()(key) % capacity;
-    const Node* const stop = curr == begin_ ? end_ : curr - 1;
-    while (curr != stop) {
-      pointer currVal = reinterpret_cast< pointer >(curr->value);
-      if (curr->state == Node::occupied && keyEq()(currVal->first, key)) {
+    Node* curr = homeOf(key);
+    for (size_type dist = 0;
+        curr != end_ && curr->state == Node::occupied && dist <= curr->distance;
+        ++dist, ++curr) {
+      if (keyEq()(valueOf(curr).first, key)) {
         return const_iterator{ curr, end_ };
       }
-      ++curr;
-      curr = curr == end_ ? begin_ : curr;
     }
     return end();
   }
@@ -373,29 +379,25 @@ namespace kizhin {
   std::pair< typename UnorderedMap< K, T, H, E >::iterator, bool > UnorderedMap< K, T, H,
       E >::emplace(Args&&... args)
   {
-    if (loadFactor() >= maxLoadFactor()) {
+    if (size() >= bucketCount() || loadFactor() >= maxLoadFactor()) {
       rehash(std::max< size_type >(bucketCount() * 2, 4));
     }
-    const size_type capacity = bucketCount();
     value_type value(std::forward< Args >(args)...);
-    Node* curr = begin_ + hashFunc()(value.first) % capacity;
-    Node* firstDeleted = nullptr;
-    while (curr->state != Node::empty) {
-      pointer currVal = reinterpret_cast< pointer >(curr->value);
-      if (curr->state == Node::occupied && keyEq()(currVal->first, value.first)) {
-        return std::make_pair(iterator{ curr, end_ }, false);
+    while (true) {
+      Node* curr = homeOf(value.first);
+      size_type dist = 0;
+      for (; curr != end_ && curr->state == Node::occupied && dist <= curr->distance;
+          ++dist, ++curr) {
+        if (keyEq()(valueOf(curr).first, value.first)) {
+          return std::make_pair(iterator{ curr, end_ }, false);
+        }
       }
-      if (curr->state == Node::deleted && !firstDeleted) {
-        firstDeleted = curr;
+      Node* inserted = insertAt(curr, dist, std::move(value));
+      if (inserted) {
+        return std::make_pair(iterator{ inserted, end_ }, true);
       }
-      ++curr;
-      curr = curr == end_ ? begin_ : curr;
+      growTail();
     }
-    curr = firstDeleted ? firstDeleted : curr;
-    new (reinterpret_cast< pointer >(curr->value)) value_type(std::move(value));
-    curr->state = Node::occupied;
-    ++size_;
-    return std::make_pair(iterator{ curr, end_ }, true);
   }
 
   template < typename K, typename T, typename H, typename E >
@@ -455,9 +457,20 @@ namespace kizhin {
       const_iterator position)
   {
     assert(position != end() && "UnorderedMap: cannot erase element past the end");
-    position.node_->state = Node::deleted;
-    (reinterpret_cast< pointer >(position.node_->value))->~value_type();
-    ++position;
+    Node* curr = position.node_;
+    valueOf(curr).~value_type();
+    curr->state = Node::empty;
+    curr->distance = 0;
+    for (Node* succ = curr + 1;
+        succ != end_ && succ->state == Node::occupied && succ->distance != 0; ++succ) {
+      new (curr->value) value_type(std::move(valueOf(succ)));
+      curr->distance = succ->distance - 1;
+      curr->state = Node::occupied;
+      valueOf(succ).~value_type();
+      succ->state = Node::empty;
+      succ->distance = 0;
+      curr = succ;
+    }
     --size_;
     return iterator{ position.node_, position.end_ };
   }
@@ -478,18 +491,24 @@ namespace kizhin {
   typename UnorderedMap< K, T, H, E >::iterator UnorderedMap< K, T, H, E >::erase(
       const_iterator first, const_iterator last)
   {
-    while (first != last) {
-      first = erase(first);
+    iterator result{ first.node_, first.end_ };
+    for (auto count = std::distance(first, last); count != 0; --count) {
+      result = erase(result);
     }
-    return iterator{ first.node_, first.end_ };
+    return result;
   }
 
   template < typename K, typename T, typename H, typename E >
   void UnorderedMap< K, T, H, E >::clear() noexcept
   {
-    erase(begin(), end());
+    for (Node* curr = begin_; curr != end_; ++curr) {
+      if (curr->state == Node::occupied) {
+        valueOf(curr).~value_type();
+      }
+    }
     delete[] std::exchange(begin_, nullptr);
     end_ = nullptr;
+    buckets_ = 0;
     size_ = 0;
   }
 
@@ -499,6 +518,7 @@ namespace kizhin {
     using std::swap;
     swap(begin_, rhs.begin_);
     swap(end_, rhs.end_);
+    swap(buckets_, rhs.buckets_);
     swap(size_, rhs.size_);
     swap(maxLoadFact_, rhs.maxLoadFact_);
   }
@@ -507,7 +527,7 @@ namespace kizhin {
   typename UnorderedMap< K, T, H, E >::size_type UnorderedMap< K, T, H, E >::bucketCount()
       const noexcept
   {
-    return end_ - begin_;
+    return buckets_;
   }
 
   template < typename K, typename T, typename H, typename E >
@@ -535,13 +555,24 @@ namespace kizhin {
   template < typename K, typename T, typename H, typename E >
   void UnorderedMap< K, T, H, E >::rehash(const size_type newBucketCount)
   {
-    if (newBucketCount < bucketCount()) {
+    if (newBucketCount < bucketCount() || newBucketCount < size()) {
       return;
     }
+    size_type tail = 1;
+    for (size_type count = newBucketCount; count > 1; count /= 2) {
+      ++tail;
+    }
     UnorderedMap resized{};
-    resized.begin_ = new Node[newBucketCount];
-    resized.end_ = resized.begin_ + newBucketCount;
-    resized.insert(begin(), end());
+    resized.begin_ = new Node[newBucketCount + tail];
+    resized.end_ = resized.begin_ + newBucketCount + tail;
+    resized.buckets_ = newBucketCount;
+    for (Node* curr = begin_; curr != end_; ++curr) {
+      if (curr->state == Node::occupied) {
+        while (!resized.insertUnique(std::move(valueOf(curr)))) {
+          resized.growTail();
+        }
+      }
+    }
     swap(resized);
     std::swap(maxLoadFact_, resized.maxLoadFact_);
   }
@@ -565,6 +596,92 @@ namespace kizhin {
     return key_equal{};
   }
 
+  template < typename K, typename T, typename H, typename E >
+  typename UnorderedMap< K, T, H, E >::Node* UnorderedMap< K, T, H, E >::homeOf(
+      const key_type& key) const
+  {
+    return begin_ + hashFunc()(key) % bucketCount();
+  }
+
+  template < typename K, typename T, typename H, typename E >
+  void UnorderedMap< K, T, H, E >::growTail()
+  {
+    // slots keep their indices, so homes and probe distances stay valid
+    const size_type slots = end_ - begin_;
+    const size_type grownSlots = slots + std::max< size_type >(slots - buckets_, 1);
+    Node* grown = new Node[grownSlots];
+    size_type moved = 0;
+    try {
+      for (; moved != slots; ++moved) {
+        if (begin_[moved].state == Node::occupied) {
+          new (grown[moved].value) value_type(std::move(valueOf(begin_ + moved)));
+          grown[moved].distance = begin_[moved].distance;
+          grown[moved].state = Node::occupied;
+        }
+      }
+    } catch (...) {
+      for (size_type i = 0; i != moved; ++i) {
+        if (grown[i].state == Node::occupied) {
+          valueOf(grown + i).~value_type();
+        }
+      }
+      delete[] grown;
+      throw;
+    }
+    for (Node* curr = begin_; curr != end_; ++curr) {
+      if (curr->state == Node::occupied) {
+        valueOf(curr).~value_type();
+      }
+    }
+    delete[] begin_;
+    begin_ = grown;
+    end_ = grown + grownSlots;
+  }
+
+  template < typename K, typename T, typename H, typename E >
+  typename UnorderedMap< K, T, H, E >::Node* UnorderedMap< K, T, H, E >::insertUnique(
+      value_type&& value)
+  {
+    Node* curr = homeOf(value.first);
+    size_type dist = 0;
+    for (; curr != end_ && curr->state == Node::occupied && dist <= curr->distance;
+        ++dist, ++curr) {}
+    return insertAt(curr, dist, std::move(value));
+  }
+
+  template < typename K, typename T, typename H, typename E >
+  typename UnorderedMap< K, T, H, E >::Node* UnorderedMap< K, T, H, E >::insertAt(
+      Node* position, const size_type dist, value_type&& value)
+  {
+    Node* last = position;
+    while (last != end_ && last->state == Node::occupied) {
+      ++last;
+    }
+    if (last == end_) {
+      return nullptr;
+    }
+    for (; last != position; --last) {
+      Node* const source = last - 1;
+      new (last->value) value_type(std::move(valueOf(source)));
+      last->distance = source->distance + 1;
+      last->state = Node::occupied;
+      valueOf(source).~value_type();
+      source->state = Node::empty;
+    }
+    new (position->value) value_type(std::move(value));
+    position->distance = dist;
+    position->state = Node::occupied;
+    ++size_;
+    return position;
+  }
+
+  template < typename K, typename T, typename H, typename E >
+  typename UnorderedMap< K, T, H, E >::value_type& UnorderedMap< K, T, H, E >::valueOf(
+      Node* node) noexcept
+  {
+    return *reinterpret_cast< value_type* >(node->value);
+  }
+
   template < typename K, typename T, typename H, typename E >
   void swap(UnorderedMap< K, T, H, E >& lhs, UnorderedMap< K, T, H, E >& rhs) noexcept(
       noexcept(lhs.swap(rhs)))
@@ -4,7 +4,6 @@
 #include <fstream>
 
 using namespace kushekbaev;
-using dictionary_system = kushekbaev::HashTable< std::string, kushekbaev::HashTable< std::string, kushekbaev::Vector< std::string > > >;
 
 namespace
 {
@@ -40,6 +39,53 @@ namespace
     }
     return tokens;
   }
+
+  void print_entry(std::ostream& out, const std::string& word, const Vector< std::string >& translations)
+  {
+    out << "-> " << word << " : ";
+    if (translations.empty())
+    {
+      out << "<NO TRANSLATIONS>";
+    }
+    else
+    {
+      auto it = translations.begin();
+      out << *it;
+      ++it;
+      for (; it != translations.end(); ++it)
+      {
+        out << ", " << *it;
+      }
+    }
+    out << "\n";
+  }
+
+  bool print_words(std::ostream& out, const Dictionary& dict, Dictionary::index_t::cIt first, Dictionary::index_t::cIt last)
+  {
+    bool found = false;
+    for (; first != last; ++first)
+    {
+      const std::string& word = *first;
+      print_entry(out, word, dict.at(word));
+      found = true;
+    }
+    return found;
+  }
+
+  bool print_reversed_words(std::ostream& out, const Dictionary& dict, Dictionary::index_t::cIt first, Dictionary::index_t::cIt last, size_t min_size)
+  {
+    bool found = false;
+    for (; first != last; ++first)
+    {
+      if (first->size() >= min_size)
+      {
+        std::string word = reversed(*first);
+        print_entry(out, word, dict.at(word));
+        found = true;
+      }
+    }
+    return found;
+  }
 }
 
 void kushekbaev::insert(std::ostream& out, std::istream& in, dictionary_system& current_dictionary_system)
@@ -383,26 +429,9 @@ void kushekbaev::prefix_search(std::ostream& out, std::istream& in, dictionary_s
   {
     throw std::out_of_range("<DICTIONARY NOT FOUND>");
   }
-  bool found = false;
+  const Dictionary& dict = dict_it->second;
   out << "Words with prefix '" << prefix << "':\n";
-  for (const auto& word_pair: dict_it->second)
-  {
-    const std::string& word = word_pair.first;
-    if (word.rfind(prefix, 0) == 0)
-    {
-      out << "-> " << word << " : ";
-      const auto& translations = word_pair.second;
-      out << *translations.begin();
-      auto start_it = translations.begin();
-      ++start_it;
-      for (auto it = start_it; it != translations.end(); ++it)
-      {
-        out << ", " << *it;
-      }
-      out << "\n";
-      found = true;
-    }
-  }
+  bool found = print_words(out, dict, dict.prefix_begin(prefix), dict.prefix_end(prefix));
   if (!found)
   {
     out << "<NO WORDS FOUND>\n";
@@ -418,26 +447,11 @@ void kushekbaev::no_prefix_search(std::ostream& out, std::istream& in, dictionar
   {
     throw std::out_of_range("<DICTIONARY NOT FOUND>");
   }
-  bool found = false;
+  const Dictionary& dict = dict_it->second;
+  const Dictionary::index_t& index = dict.words_index();
   out << "Words without prefix '" << prefix << "':\n";
-  for (const auto& word_pair: dict_it->second)
-  {
-    const std::string& word = word_pair.first;
-    if (word.rfind(prefix, 0) != 0)
-    {
-      out << "-> " << word << " : ";
-      const auto& translations = word_pair.second;
-      out << *translations.begin();
-      auto start_it = translations.begin();
-      ++start_it;
-      for (auto it = start_it; it != translations.end(); ++it)
-      {
-        out << ", " << *it;
-      }
-      out << "\n";
-      found = true;
-    }
-  }
+  bool found = print_words(out, dict, index.cbegin(), dict.prefix_begin(prefix));
+  found = print_words(out, dict, dict.prefix_end(prefix), index.cend()) || found;
   if (!found)
   {
     out << "<NO WORDS FOUND>\n";
@@ -453,26 +467,9 @@ void kushekbaev::suffix_search(std::ostream& out, std::istream& in, dictionary_s
   {
     throw std::out_of_range("<DICTIONARY NOT FOUND>");
   }
-  bool found = false;
+  const Dictionary& dict = dict_it->second;
   out << "Words with suffix '" << suffix << "':\n";
-  for (const auto& word_pair: dict_it->second)
-  {
-    const std::string& word = word_pair.first;
-    if (word.size() >= suffix.size() && word.compare(word.size() - suffix.size(), suffix.size(), suffix) == 0)
-    {
-      out << "-> " << word << " : ";
-      const auto& translations = word_pair.second;
-      out << *translations.begin();
-      auto start_it = translations.begin();
-      ++start_it;
-      for (auto it = start_it; it != translations.end(); ++it)
-      {
-        out << ", " << *it;
-      }
-      out << "\n";
-      found = true;
-    }
-  }
+  bool found = print_reversed_words(out, dict, dict.suffix_begin(suffix), dict.suffix_end(suffix), 0);
   if (!found)
   {
     out << "<NO WORDS FOUND>\n";
@@ -487,26 +484,11 @@ void kushekbaev::no_suffix_search(std::ostream& out, std::istream& in, dictionar
   {
     throw std::out_of_range("<DICTIONARY NOT FOUND>");
   }
-  bool found = false;
+  const Dictionary& dict = dict_it->second;
+  const Dictionary::index_t& index = dict.reversed_index();
   out << "Words without suffix '" << suffix << "':\n";
-  for (const auto& word_pair: dict_it->second)
-  {
-    const std::string& word = word_pair.first;
-    if (word.size() >= suffix.size() && word.compare(word.size() - suffix.size(), suffix.size(), suffix) != 0)
-    {
-      out << "-> " << word << " : ";
-      const auto& translations = word_pair.second;
-      out << *translations.begin();
-      auto start_it = translations.begin();
-      ++start_it;
-      for (auto it = start_it; it != translations.end(); ++it)
-      {
-        out << ", " << *it;
-      }
-      out << "\n";
-      found = true;
-    }
-  }
+  bool found = print_reversed_words(out, dict, index.cbegin(), dict.suffix_begin(suffix), suffix.size());
+  found = print_reversed_words(out, dict, dict.suffix_end(suffix), index.cend(), suffix.size()) || found;
   if (!found)
   {
     out << "<NO WORDS FOUND>\n";
@@ -6,10 +6,11 @@
 #include <set>
 #include <hashtable.hpp>
 #include <vector.hpp>
+#include "dictionary.hpp"
 
 namespace kushekbaev
 {
-  using dictionary_system = HashTable< std::string, HashTable< std::string, Vector < std::string > > >;
+  using dictionary_system = HashTable< std::string, Dictionary >;
 
   void insert(std::ostream& out, std::istream& in, dictionary_system& current_dictionary_system);
   void insert_without_translation(std::ostream& out, std::istream& in, dictionary_system& current_dictionary_system);
@@ -0,0 +1,194 @@
+#include "dictionary.hpp"
+
+namespace
+{
+  using index_t = kushekbaev::Dictionary::index_t;
+
+  index_t::cIt range_end(const index_t& index, std::string prefix)
+  {
+    while (!prefix.empty() && static_cast< unsigned char >(prefix.back()) == 0xFF)
+    {
+      prefix.pop_back();
+    }
+    if (prefix.empty())
+    {
+      return index.cend();
+    }
+    prefix.back() = static_cast< char >(static_cast< unsigned char >(prefix.back()) + 1);
+    return index.lower_bound(prefix);
+  }
+}
+
+size_t kushekbaev::Dictionary::size() const noexcept
+{
+  return words_.size();
+}
+
+bool kushekbaev::Dictionary::empty() const noexcept
+{
+  return words_.empty();
+}
+
+kushekbaev::Dictionary::It kushekbaev::Dictionary::begin()
+{
+  return words_.begin();
+}
+
+kushekbaev::Dictionary::It kushekbaev::Dictionary::end()
+{
+  return words_.end();
+}
+
+kushekbaev::Dictionary::cIt kushekbaev::Dictionary::begin() const
+{
+  return words_.begin();
+}
+
+kushekbaev::Dictionary::cIt kushekbaev::Dictionary::end() const
+{
+  return words_.end();
+}
+
+kushekbaev::Dictionary::cIt kushekbaev::Dictionary::cbegin() const
+{
+  return words_.cbegin();
+}
+
+kushekbaev::Dictionary::cIt kushekbaev::Dictionary::cend() const
+{
+  return words_.cend();
+}
+
+kushekbaev::Dictionary::It kushekbaev::Dictionary::find(const std::string& word)
+{
+  return words_.find(word);
+}
+
+kushekbaev::Dictionary::cIt kushekbaev::Dictionary::find(const std::string& word) const
+{
+  return words_.find(word);
+}
+
+size_t kushekbaev::Dictionary::count(const std::string& word) const
+{
+  return words_.count(word);
+}
+
+kushekbaev::Dictionary::translations_t& kushekbaev::Dictionary::operator[](const std::string& word)
+{
+  auto position = words_.find(word);
+  if (position != words_.end())
+  {
+    return position->second;
+  }
+  auto result = words_.insert(std::make_pair(word, translations_t()));
+  try
+  {
+    index(word);
+  }
+  catch (...)
+  {
+    words_.erase(word);
+    throw;
+  }
+  return result.first->second;
+}
+
+kushekbaev::Dictionary::translations_t& kushekbaev::Dictionary::at(const std::string& word)
+{
+  return words_.at(word);
+}
+
+const kushekbaev::Dictionary::translations_t& kushekbaev::Dictionary::at(const std::string& word) const
+{
+  return words_.at(word);
+}
+
+std::pair< kushekbaev::Dictionary::It, bool > kushekbaev::Dictionary::insert(const words_t::pair& entry)
+{
+  auto result = words_.insert(entry);
+  if (result.second)
+  {
+    try
+    {
+      index(entry.first);
+    }
+    catch (...)
+    {
+      words_.erase(entry.first);
+      throw;
+    }
+  }
+  return result;
+}
+
+size_t kushekbaev::Dictionary::erase(const std::string& word)
+{
+  size_t erased = words_.erase(word);
+  if (erased)
+  {
+    unindex(word);
+  }
+  return erased;
+}
+
+kushekbaev::Dictionary::It kushekbaev::Dictionary::erase(It position)
+{
+  unindex(position->first);
+  return words_.erase(position);
+}
+
+kushekbaev::Dictionary::index_t::cIt kushekbaev::Dictionary::prefix_begin(const std::string& prefix) const
+{
+  return words_index_.lower_bound(prefix);
+}
+
+kushekbaev::Dictionary::index_t::cIt kushekbaev::Dictionary::prefix_end(const std::string& prefix) const
+{
+  return range_end(words_index_, prefix);
+}
+
+kushekbaev::Dictionary::index_t::cIt kushekbaev::Dictionary::suffix_begin(const std::string& suffix) const
+{
+  return reversed_index_.lower_bound(reversed(suffix));
+}
+
+kushekbaev::Dictionary::index_t::cIt kushekbaev::Dictionary::suffix_end(const std::string& suffix) const
+{
+  return range_end(reversed_index_, reversed(suffix));
+}
+
+const kushekbaev::Dictionary::index_t& kushekbaev::Dictionary::words_index() const noexcept
+{
+  return words_index_;
+}
+
+const kushekbaev::Dictionary::index_t& kushekbaev::Dictionary::reversed_index() const noexcept
+{
+  return reversed_index_;
+}
+
+void kushekbaev::Dictionary::index(const std::string& word)
+{
+  words_index_.insert(word);
+  try
+  {
+    reversed_index_.insert(reversed(word));
+  }
+  catch (...)
+  {
+    words_index_.erase(word);
+    throw;
+  }
+}
+
+void kushekbaev::Dictionary::unindex(const std::string& word)
+{
+  words_index_.erase(word);
+  reversed_index_.erase(reversed(word));
+}
+
+std::string kushekbaev::reversed(const std::string& word)
+{
+  return std::string(word.rbegin(), word.rend());
+}
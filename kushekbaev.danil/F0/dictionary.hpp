@@ -0,0 +1,59 @@
+#ifndef DICTIONARY_HPP
+#define DICTIONARY_HPP
+
+#include <string>
+#include <hashtable.hpp>
+#include <vector.hpp>
+#include "wordindex.hpp"
+
+namespace kushekbaev
+{
+  struct Dictionary
+  {
+    using translations_t = Vector< std::string >;
+    using words_t = HashTable< std::string, translations_t >;
+    using index_t = WordIndex;
+    using It = words_t::It;
+    using cIt = words_t::cIt;
+
+    size_t size() const noexcept;
+    bool empty() const noexcept;
+
+    It begin();
+    It end();
+    cIt begin() const;
+    cIt end() const;
+    cIt cbegin() const;
+    cIt cend() const;
+
+    It find(const std::string& word);
+    cIt find(const std::string& word) const;
+    size_t count(const std::string& word) const;
+
+    translations_t& operator[](const std::string& word);
+    translations_t& at(const std::string& word);
+    const translations_t& at(const std::string& word) const;
+
+    std::pair< It, bool > insert(const words_t::pair& entry);
+    size_t erase(const std::string& word);
+    It erase(It position);
+
+    index_t::cIt prefix_begin(const std::string& prefix) const;
+    index_t::cIt prefix_end(const std::string& prefix) const;
+    index_t::cIt suffix_begin(const std::string& suffix) const;
+    index_t::cIt suffix_end(const std::string& suffix) const;
+    const index_t& words_index() const noexcept;
+    const index_t& reversed_index() const noexcept;
+
+    private:
+      words_t words_;
+      index_t words_index_;
+      index_t reversed_index_;
+      void index(const std::string& word);
+      void unindex(const std::string& word);
+  };
+
+  std::string reversed(const std::string& word);
+}
+
+#endif
@@ -8,7 +8,6 @@
 int main()
 {
   using namespace kushekbaev;
-  using dictionary_system = HashTable< std::string, HashTable< std::string, Vector< std::string > > >;
   dictionary_system curr_ds;
   Tree< std::string, std::function< void(std::ostream&, std::istream&, dictionary_system&) > > commands;
   commands["insert"] = insert;
@@ -0,0 +1,345 @@
+#include "wordindex.hpp"
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+struct kushekbaev::WordIndex::Node
+{
+  std::string word;
+  Node* parent;
+  Node* left;
+  Node* right;
+  size_t height;
+};
+
+kushekbaev::WordIndex::cIt::cIt() noexcept:
+  node_(nullptr)
+{}
+
+kushekbaev::WordIndex::cIt::cIt(const Node* node) noexcept:
+  node_(node)
+{}
+
+kushekbaev::WordIndex::cIt::reference kushekbaev::WordIndex::cIt::operator*() const noexcept
+{
+  return node_->word;
+}
+
+kushekbaev::WordIndex::cIt::pointer kushekbaev::WordIndex::cIt::operator->() const noexcept
+{
+  return std::addressof(node_->word);
+}
+
+kushekbaev::WordIndex::cIt& kushekbaev::WordIndex::cIt::operator++() noexcept
+{
+  if (node_->right)
+  {
+    node_ = node_->right;
+    while (node_->left)
+    {
+      node_ = node_->left;
+    }
+    return *this;
+  }
+  while (node_->parent && node_->parent->right == node_)
+  {
+    node_ = node_->parent;
+  }
+  node_ = node_->parent;
+  return *this;
+}
+
+kushekbaev::WordIndex::cIt kushekbaev::WordIndex::cIt::operator++(int) noexcept
+{
+  cIt result(*this);
+  ++(*this);
+  return result;
+}
+
+bool kushekbaev::WordIndex::cIt::operator==(const cIt& rhs) const noexcept
+{
+  return node_ == rhs.node_;
+}
+
+bool kushekbaev::WordIndex::cIt::operator!=(const cIt& rhs) const noexcept
+{
+  return !(*this == rhs);
+}
+
+kushekbaev::WordIndex::WordIndex() noexcept:
+  root_(nullptr),
+  size_(0)
+{}
+
+kushekbaev::WordIndex::WordIndex(const WordIndex& rhs):
+  root_(copySubtree(rhs.root_, nullptr)),
+  size_(rhs.size_)
+{}
+
+kushekbaev::WordIndex::WordIndex(WordIndex&& rhs) noexcept:
+  root_(std::exchange(rhs.root_, nullptr)),
+  size_(std::exchange(rhs.size_, 0))
+{}
+
+kushekbaev::WordIndex::~WordIndex()
+{
+  clear();
+}
+
+kushekbaev::WordIndex& kushekbaev::WordIndex::operator=(const WordIndex& rhs)
+{
+  WordIndex copy(rhs);
+  swap(copy);
+  return *this;
+}
+
+kushekbaev::WordIndex& kushekbaev::WordIndex::operator=(WordIndex&& rhs) noexcept
+{
+  WordIndex moved(std::move(rhs));
+  swap(moved);
+  return *this;
+}
+
+size_t kushekbaev::WordIndex::size() const noexcept
+{
+  return size_;
+}
+
+bool kushekbaev::WordIndex::empty() const noexcept
+{
+  return size_ == 0;
+}
+
+kushekbaev::WordIndex::cIt kushekbaev::WordIndex::cbegin() const noexcept
+{
+  const Node* node = root_;
+  while (node && node->left)
+  {
+    node = node->left;
+  }
+  return cIt(node);
+}
+
+kushekbaev::WordIndex::cIt kushekbaev::WordIndex::cend() const noexcept
+{
+  return cIt();
+}
+
+kushekbaev::WordIndex::cIt kushekbaev::WordIndex::lower_bound(const std::string& word) const
+{
+  const Node* result = nullptr;
+  const Node* node = root_;
+  while (node)
+  {
+    if (node->word < word)
+    {
+      node = node->right;
+    }
+    else
+    {
+      result = node;
+      node = node->left;
+    }
+  }
+  return cIt(result);
+}
+
+bool kushekbaev::WordIndex::insert(const std::string& word)
+{
+  Node* parent = nullptr;
+  Node** link = &root_;
+  while (*link)
+  {
+    parent = *link;
+    if (word < parent->word)
+    {
+      link = &parent->left;
+    }
+    else if (parent->word < word)
+    {
+      link = &parent->right;
+    }
+    else
+    {
+      return false;
+    }
+  }
+  *link = new Node{ word, parent, nullptr, nullptr, 1 };
+  ++size_;
+  rebalance(parent);
+  return true;
+}
+
+bool kushekbaev::WordIndex::erase(const std::string& word)
+{
+  Node* node = root_;
+  while (node && node->word != word)
+  {
+    node = (word < node->word) ? node->left : node->right;
+  }
+  if (!node)
+  {
+    return false;
+  }
+  if (node->left && node->right)
+  {
+    Node* successor = node->right;
+    while (successor->left)
+    {
+      successor = successor->left;
+    }
+    node->word.swap(successor->word);
+    node = successor;
+  }
+  Node* child = node->left ? node->left : node->right;
+  Node* parent = node->parent;
+  if (child)
+  {
+    replaceChild(node, child);
+  }
+  else if (!parent)
+  {
+    root_ = nullptr;
+  }
+  else if (parent->left == node)
+  {
+    parent->left = nullptr;
+  }
+  else
+  {
+    parent->right = nullptr;
+  }
+  delete node;
+  --size_;
+  rebalance(parent);
+  return true;
+}
+
+void kushekbaev::WordIndex::clear() noexcept
+{
+  killSubtree(root_);
+  root_ = nullptr;
+  size_ = 0;
+}
+
+void kushekbaev::WordIndex::swap(WordIndex& rhs) noexcept
+{
+  std::swap(root_, rhs.root_);
+  std::swap(size_, rhs.size_);
+}
+
+kushekbaev::WordIndex::Node* kushekbaev::WordIndex::copySubtree(const Node* node, Node* parent)
+{
+  if (!node)
+  {
+    return nullptr;
+  }
+  Node* result = new Node{ node->word, parent, nullptr, nullptr, node->height };
+  try
+  {
+    result->left = copySubtree(node->left, result);
+    result->right = copySubtree(node->right, result);
+  }
+  catch (...)
+  {
+    killSubtree(result);
+    throw;
+  }
+  return result;
+}
+
+void kushekbaev::WordIndex::killSubtree(Node* node) noexcept
+{
+  if (!node)
+  {
+    return;
+  }
+  killSubtree(node->left);
+  killSubtree(node->right);
+  delete node;
+}
+
+size_t kushekbaev::WordIndex::heightOf(const Node* node) noexcept
+{
+  return node ? node->height : 0;
+}
+
+void kushekbaev::WordIndex::fixHeight(Node* node) noexcept
+{
+  node->height = std::max(heightOf(node->left), heightOf(node->right)) + 1;
+}
+
+void kushekbaev::WordIndex::replaceChild(Node* node, Node* child) noexcept
+{
+  Node* parent = node->parent;
+  child->parent = parent;
+  if (!parent)
+  {
+    root_ = child;
+  }
+  else if (parent->left == node)
+  {
+    parent->left = child;
+  }
+  else
+  {
+    parent->right = child;
+  }
+}
+
+void kushekbaev::WordIndex::rotateLeft(Node* node) noexcept
+{
+  Node* pivot = node->right;
+  node->right = pivot->left;
+  if (pivot->left)
+  {
+    pivot->left->parent = node;
+  }
+  replaceChild(node, pivot);
+  pivot->left = node;
+  node->parent = pivot;
+  fixHeight(node);
+  fixHeight(pivot);
+}
+
+void kushekbaev::WordIndex::rotateRight(Node* node) noexcept
+{
+  Node* pivot = node->left;
+  node->left = pivot->right;
+  if (pivot->right)
+  {
+    pivot->right->parent = node;
+  }
+  replaceChild(node, pivot);
+  pivot->right = node;
+  node->parent = pivot;
+  fixHeight(node);
+  fixHeight(pivot);
+}
+
+void kushekbaev::WordIndex::rebalance(Node* node) noexcept
+{
+  while (node)
+  {
+    fixHeight(node);
+    if (heightOf(node->right) > heightOf(node->left) + 1)
+    {
+      if (heightOf(node->right->left) > heightOf(node->right->right))
+      {
+        rotateRight(node->right);
+      }
+      rotateLeft(node);
+      node = node->parent;
+    }
+    else if (heightOf(node->left) > heightOf(node->right) + 1)
+    {
+      if (heightOf(node->left->right) > heightOf(node->left->left))
+      {
+        rotateLeft(node->left);
+      }
+      rotateRight(node);
+      node = node->parent;
+    }
+    node = node->parent;
+  }
+}
@@ -0,0 +1,71 @@
+#ifndef WORDINDEX_HPP
+#define WORDINDEX_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+
+namespace kushekbaev
+{
+  class WordIndex
+  {
+    struct Node;
+
+    public:
+      class cIt
+      {
+        public:
+          using iterator_category = std::forward_iterator_tag;
+          using value_type = std::string;
+          using difference_type = std::ptrdiff_t;
+          using pointer = const std::string*;
+          using reference = const std::string&;
+
+          cIt() noexcept;
+          reference operator*() const noexcept;
+          pointer operator->() const noexcept;
+          cIt& operator++() noexcept;
+          cIt operator++(int) noexcept;
+          bool operator==(const cIt& rhs) const noexcept;
+          bool operator!=(const cIt& rhs) const noexcept;
+
+        private:
+          friend class WordIndex;
+          const Node* node_;
+          explicit cIt(const Node* node) noexcept;
+      };
+
+      WordIndex() noexcept;
+      WordIndex(const WordIndex& rhs);
+      WordIndex(WordIndex&& rhs) noexcept;
+      ~WordIndex();
+      WordIndex& operator=(const WordIndex& rhs);
+      WordIndex& operator=(WordIndex&& rhs) noexcept;
+
+      size_t size() const noexcept;
+      bool empty() const noexcept;
+      cIt cbegin() const noexcept;
+      cIt cend() const noexcept;
+      cIt lower_bound(const std::string& word) const;
+
+      bool insert(const std::string& word);
+      bool erase(const std::string& word);
+      void clear() noexcept;
+      void swap(WordIndex& rhs) noexcept;
+
+    private:
+      Node* root_;
+      size_t size_;
+
+      static Node* copySubtree(const Node* node, Node* parent);
+      static void killSubtree(Node* node) noexcept;
+      static size_t heightOf(const Node* node) noexcept;
+      static void fixHeight(Node* node) noexcept;
+      void replaceChild(Node* node, Node* child) noexcept;
+      void rotateLeft(Node* node) noexcept;
+      void rotateRight(Node* node) noexcept;
+      void rebalance(Node* node) noexcept;
+  };
+}
+
+#endif
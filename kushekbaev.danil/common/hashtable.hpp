@@ -170,7 +170,7 @@ namespace kushekbaev
     size_t i = 1;
     while (table[currNode].occupied)
     {
-      currNode = (baseNode + i * i) % table_.size();
+      currNode = (baseNode + i * i) % table.size();
       ++i;
     }
     return currNode;
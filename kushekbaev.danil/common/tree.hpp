@@ -120,13 +120,13 @@ namespace kushekbaev
     root_(fakeroot_),
     size_(0)
   {
+    fakeroot_->left = fakeroot_;
+    fakeroot_->right = fakeroot_;
+    fakeroot_->parent = fakeroot_;
     if (other.root_ == other.fakeroot_)
     {
       return;
     }
-    fakeroot_->left = fakeroot_;
-    fakeroot_->right = fakeroot_;
-    fakeroot_->parent = fakeroot_;
     if (!other.empty())
     {
       root_ = copySubtree(other.root_, fakeroot_);
@@ -351,19 +351,47 @@ namespace kushekbaev
   {
     killChildrenOf(root_);
     root_ = fakeroot_;
+    if (fakeroot_)
+    {
+      fakeroot_->left = fakeroot_;
+      fakeroot_->right = fakeroot_;
+    }
     size_ = 0;
   }
 
   template< typename Key, typename Value, typename Cmp >
   void Tree< Key, Value, Cmp >::killChildrenOf(node_t* node)
   {
-    if (!node || node == fakeroot_)
+    node_t* current = (node == fakeroot_) ? nullptr : node;
+    while (current)
     {
-      return;
+      if (current->left)
+      {
+        current = current->left;
+      }
+      else if (current->right)
+      {
+        current = current->right;
+      }
+      else
+      {
+        node_t* parent = current->parent;
+        if (current == node)
+        {
+          parent = nullptr;
+        }
+        else if (parent->left == current)
+        {
+          parent->left = nullptr;
+        }
+        else
+        {
+          parent->right = nullptr;
+        }
+        delete current;
+        current = parent;
+      }
     }
-    killChildrenOf(node->left);
-    killChildrenOf(node->right);
-    delete node;
   }
 
   template< typename Key, typename Value, typename Cmp >
@@ -420,35 +448,7 @@ namespace kushekbaev
       return end();
     }
     node_t* todelete = position.node_;
-    node_t* parent = todelete->parent;
-    It result = It(parent);
-    if (!(todelete->left) && !(todelete->right))
-    {
-      if (parent->left == todelete)
-      {
-        parent->left = nullptr;
-      }
-      else
-      {
-        parent->right = nullptr;
-      }
-      result = It(parent);
-    }
-    else if (!(todelete->left) || !(todelete->right))
-    {
-      node_t* child = (todelete->left) ? todelete->left : todelete->right;
-      if (parent->left == todelete)
-      {
-        parent->left = child;
-      }
-      else
-      {
-        parent->right = child;
-      }
-      child->parent = parent;
-      result = It(child);
-    }
-    else
+    if (todelete->left && todelete->right)
     {
       node_t* next = todelete->right;
       while (next->left)
@@ -456,76 +456,61 @@ namespace kushekbaev
         next = next->left;
       }
       todelete->data = next->data;
-      return erase(It(next));
+      erase(It(next));
+      return It(todelete);
+    }
+    It result = position;
+    ++result;
+    node_t* parent = todelete->parent;
+    node_t* child = (todelete->left) ? todelete->left : todelete->right;
+    if (child)
+    {
+      child->parent = parent;
     }
     if (todelete == root_)
     {
-      root_ = (parent == fakeroot_) ? parent : fakeroot_;
-      result = begin();
+      root_ = (child) ? child : fakeroot_;
     }
-
+    else if (parent->left == todelete)
+    {
+      parent->left = child;
+    }
+    else
+    {
+      parent->right = child;
+    }
+    bool wasMin = (fakeroot_->left == todelete);
+    bool wasMax = (fakeroot_->right == todelete);
     delete todelete;
     --size_;
-    return result;
-  }
-
-  template< typename Key, typename Value, typename Cmp >
-  typename Tree< Key, Value, Cmp >::It Tree< Key, Value, Cmp >::erase(cIt position)
-  {
-    if (position == cend())
+    if (root_ == fakeroot_)
     {
+      fakeroot_->left = fakeroot_;
+      fakeroot_->right = fakeroot_;
       return end();
     }
-    node_t* todelete = position.node_;
-    node_t* parent = todelete->parent;
-    It result = It(parent);
-    if (!(todelete->left) && !(todelete->right))
-    {
-      if (parent->left == todelete)
-      {
-        parent->left = nullptr;
-      }
-      else
-      {
-        parent->right = nullptr;
-      }
-      result = It(parent);
-    }
-    else if (!(todelete->left) || !(todelete->right))
+    if (wasMin)
     {
-      node_t* child = (todelete->left) ? todelete->left : todelete->right;
-      if (parent->left == todelete)
-      {
-        parent->left = child;
-      }
-      else
-      {
-        parent->right = child;
-      }
-      child->parent = parent;
-      result = It(child);
+      fakeroot_->left = begin().node_;
     }
-    else
+    if (wasMax)
     {
-      node_t* next = todelete->right;
-      while (next->left)
+      node_t* maxNode = root_;
+      while (maxNode->right)
       {
-        next = next->left;
+        maxNode = maxNode->right;
       }
-      todelete->data = next->data;
-      return erase(It(next));
-    }
-    if (todelete == root_)
-    {
-      root_ = (parent == fakeroot_) ? parent : fakeroot_;
-      result = begin();
+      fakeroot_->right = maxNode;
     }
-
-    delete todelete;
-    --size_;
     return result;
   }
 
+  template< typename Key, typename Value, typename Cmp >
+  typename Tree< Key, Value, Cmp >::It Tree< Key, Value, Cmp >::erase(cIt position)
+  {
+    return erase(It(position.node_));
+  }
+
   template< typename Key, typename Value, typename Cmp >
   typename Tree< Key, Value, Cmp >::It Tree< Key, Value, Cmp >::erase(It first, It last)
   {
@@ -625,29 +610,9 @@ namespace kushekbaev
 
   template< typename Key, typename Value, typename Cmp >
   template< typename... Args >
-  typename Tree< Key, Value, Cmp >::It Tree< Key, Value, Cmp >::emplace_hint(cIt hint, Args&&... args)
+  typename Tree< Key, Value, Cmp >::It Tree< Key, Value, Cmp >::emplace_hint(cIt, Args&&... args)
   {
-    if (empty())
-    {
-      return emplace(std::forward< Args >(args)...).first;
-    }
-    std::pair< Key, Value > newData(std::forward< Args >(args)...);
-    auto newKey = newData.first;
-    if (hint != cend())
-    {
-      auto hintKey = hint->first;
-      auto nextHint = hint;
-      ++hint;
-      if ((cmp_(hintKey, newKey) && (nextHint == cend())) || (cmp_(newKey, nextHint->first)))
-      {
-        node_t* newNode = new node_t(std::move(newData));
-        node_t* hintNode = hint.node_;
-        newNode->parent = hintNode;
-        ++size_;
-        return It(newNode);
-      }
-    }
-    return emplace(std::move(newData)).first;
+    return emplace(std::forward< Args >(args)...).first;
   }
 
   template< typename Key, typename Value, typename Cmp >
@@ -719,14 +684,14 @@ namespace kushekbaev
     node_t* result = fakeroot_;
     while (current != fakeroot_ && current)
     {
-      if (cmp_(current->data.first, key))
+      if (!cmp_(current->data.first, key))
       {
         result = current;
-        current = current->right;
+        current = current->left;
       }
       else
       {
-        current = current->left;
+        current = current->right;
       }
     }
     return It(result);
@@ -735,7 +700,21 @@ namespace kushekbaev
   template< typename Key, typename Value, typename Cmp >
   typename Tree< Key, Value, Cmp >::cIt Tree< Key, Value, Cmp >::lower_bound(const Key& key) const
   {
-    return cIt(lower_bound(key));
+    node_t* current = root_;
+    node_t* result = fakeroot_;
+    while (current != fakeroot_ && current)
+    {
+      if (!cmp_(current->data.first, key))
+      {
+        result = current;
+        current = current->left;
+      }
+      else
+      {
+        current = current->right;
+      }
+    }
+    return cIt(result);
   }
 
   template< typename Key, typename Value, typename Cmp >
@@ -748,11 +727,11 @@ namespace kushekbaev
       if (cmp_(key, current->data.first))
       {
         result = current;
-        current = current->right;
+        current = current->left;
       }
       else
       {
-        current = current->left;
+        current = current->right;
       }
     }
     return It(result);
@@ -761,7 +740,21 @@ namespace kushekbaev
   template< typename Key, typename Value, typename Cmp >
   typename Tree< Key, Value, Cmp >::cIt Tree< Key, Value, Cmp >::upper_bound(const Key& key) const
   {
-    return cIt(upper_bound(key));
+    node_t* current = root_;
+    node_t* result = fakeroot_;
+    while (current != fakeroot_ && current)
+    {
+      if (cmp_(key, current->data.first))
+      {
+        result = current;
+        current = current->left;
+      }
+      else
+      {
+        current = current->right;
+      }
+    }
+    return cIt(result);
   }
 
   template< typename Key, typename Value, typename Cmp >
@@ -931,11 +924,41 @@ namespace kushekbaev
     {
       return nullptr;
     }
-    node_t* newNode = new node_t(node->data);
-    newNode->parent = parent;
-    newNode->left = copySubtree(node->left, newNode);
-    newNode->right = copySubtree(node->right, newNode);
-    return newNode;
+    node_t* result = new node_t(node->data);
+    result->parent = parent;
+    const node_t* source = node;
+    node_t* copy = result;
+    try
+    {
+      while (source)
+      {
+        if (source->left && !copy->left)
+        {
+          copy->left = new node_t(source->left->data);
+          copy->left->parent = copy;
+          source = source->left;
+          copy = copy->left;
+        }
+        else if (source->right && !copy->right)
+        {
+          copy->right = new node_t(source->right->data);
+          copy->right->parent = copy;
+          source = source->right;
+          copy = copy->right;
+        }
+        else
+        {
+          source = (source == node) ? nullptr : source->parent;
+          copy = copy->parent;
+        }
+      }
+    }
+    catch (...)
+    {
+      killChildrenOf(result);
+      throw;
+    }
+    return result;
   }
 }
 
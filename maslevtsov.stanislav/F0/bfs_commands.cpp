@@ -1,74 +1,11 @@
 #include "bfs_commands.hpp"
+#include <limits>
 #include <stack.hpp>
-#include <queue.hpp>
 #include <hash_table/definition.hpp>
+#include <vector/definition.hpp>
 
 namespace {
   using distances_t = maslevtsov::HashTable< unsigned, size_t >;
-  using parents_t = maslevtsov::HashTable< unsigned, unsigned >;
-  using node_neighbour_pair_t = std::pair< const unsigned, maslevtsov::Vector< unsigned > >;
-
-  void get_bfs_from(const maslevtsov::Graph& graph, unsigned start, distances_t& distances, parents_t& parents)
-  {
-    distances_t distances_result;
-    parents_t parents_result;
-    const maslevtsov::HashTable< unsigned, maslevtsov::Vector< unsigned > >& adj_list = graph.get_adj_list();
-    maslevtsov::Queue< unsigned > to_visit;
-    distances_result[start] = 0;
-    to_visit.push(start);
-    while (!to_visit.empty()) {
-      unsigned current_node = to_visit.front();
-      to_visit.pop();
-      auto adj_list_it = adj_list.find(current_node);
-      if (adj_list_it->second.empty()) {
-        continue;
-      }
-      maslevtsov::Vector< int > dump(adj_list_it->second.size());
-      for (auto i = adj_list_it->second.begin(); i != adj_list_it->second.end(); ++i) {
-        if (distances_result.find(*i) == distances_result.end()) {
-          distances_result[*i] = distances_result[current_node] + 1;
-          parents_result[*i] = current_node;
-          to_visit.push(*i);
-        }
-      }
-    }
-    distances = std::move(distances_result);
-    parents = std::move(parents_result);
-  }
-
-  distances_t::const_iterator find_max_distance(const distances_t& distances)
-  {
-    distances_t::const_iterator largest = distances.cbegin();
-    for (auto i = ++distances.cbegin(); i != distances.cend(); ++i) {
-      if (largest->second < i->second) {
-        largest = i;
-      }
-    }
-    return largest;
-  }
-
-  size_t get_max_distance(const maslevtsov::Graph& graph, const node_neighbour_pair_t& node_neighbour_pair)
-  {
-    distances_t distances;
-    parents_t parents;
-    get_bfs_from(graph, node_neighbour_pair.first, distances, parents);
-    auto max_el_it = find_max_distance(distances);
-    return max_el_it != distances.cend() ? max_el_it->second : 0;
-  }
-
-  void sort(maslevtsov::Vector< unsigned >& vector)
-  {
-    if (vector.empty()) {
-      return;
-    }
-    for (size_t i = 0; i < vector.size() - 1; ++i) {
-      for (size_t j = 0; j < vector.size() - i - 1; ++j) {
-        if (vector[j] > vector[j + 1]) {
-          std::swap(vector[j], vector[j + 1]);
-        }
-      }
-    }
-  }
 }
 
 void maslevtsov::traverse_breadth_first(const graphs_t& graphs, std::istream& in, std::ostream& out)
@@ -80,9 +17,15 @@ void maslevtsov::traverse_breadth_first(const graphs_t& graphs, std::istream& in
   if (gr_it == graphs.end() || gr_it->second.get_adj_list().find(start_node) == gr_it->second.get_adj_list().end()) {
     throw std::invalid_argument("non-existing graph");
   }
+  const maslevtsov::CsrSnapshot& snapshot = gr_it->second.get_snapshot();
+  maslevtsov::Vector< unsigned > order;
+  maslevtsov::Vector< size_t > distance_by_id;
+  maslevtsov::Vector< unsigned > parent_by_id;
+  snapshot.traverse(snapshot.get_id(start_node), order, distance_by_id, parent_by_id);
   distances_t distances;
-  parents_t parents;
-  get_bfs_from(gr_it->second, start_node, distances, parents);
+  for (auto i = order.cbegin(); i != order.cend(); ++i) {
+    distances[snapshot.get_vertice(*i)] = distance_by_id[*i];
+  }
   for (auto i = distances.cbegin(); i != distances.cend(); ++i) {
     out << start_node << '-' << i->first << " : " << i->second << '\n';
   }
@@ -97,25 +40,32 @@ void maslevtsov::get_min_path(const graphs_t& graphs, std::istream& in, std::ost
   if (gr_it == graphs.cend() || gr_it->second.get_adj_list().find(start_node) == gr_it->second.get_adj_list().cend()) {
     throw std::invalid_argument("non-existing graph");
   }
-  distances_t distances;
-  parents_t parents;
-  get_bfs_from(gr_it->second, start_node, distances, parents);
-  if (distances.find(goal_node) == distances.end()) {
+  const maslevtsov::CsrSnapshot& snapshot = gr_it->second.get_snapshot();
+  if (!snapshot.contains(goal_node)) {
+    throw std::invalid_argument("non-existing path");
+  }
+  maslevtsov::Vector< unsigned > order;
+  maslevtsov::Vector< size_t > distances;
+  maslevtsov::Vector< unsigned > parents;
+  unsigned start_id = snapshot.get_id(start_node);
+  unsigned goal_id = snapshot.get_id(goal_node);
+  snapshot.traverse(start_id, order, distances, parents);
+  if (distances[goal_id] == std::numeric_limits< size_t >::max()) {
     throw std::invalid_argument("non-existing path");
   }
   maslevtsov::Stack< unsigned > restored_path;
-  unsigned current_node = goal_node;
-  while (current_node != start_node) {
-    restored_path.push(current_node);
-    current_node = parents[current_node];
+  unsigned current_id = goal_id;
+  while (current_id != start_id) {
+    restored_path.push(snapshot.get_vertice(current_id));
+    current_id = parents[current_id];
   }
-  out << current_node << '-' << restored_path.top();
+  out << start_node << '-' << restored_path.top();
   restored_path.pop();
   while (!restored_path.empty()) {
     out << '-' << restored_path.top();
     restored_path.pop();
   }
-  out << ' ' << distances[goal_node] << '\n';
+  out << ' ' << distances[goal_id] << '\n';
 }
 
 void maslevtsov::get_graph_width(const graphs_t& graphs, std::istream& in, std::ostream& out)
@@ -126,16 +76,7 @@ void maslevtsov::get_graph_width(const graphs_t& graphs, std::istream& in, std::
   if (gr_it == graphs.cend()) {
     throw std::invalid_argument("non-existing graph");
   }
-  const maslevtsov::HashTable< unsigned, maslevtsov::Vector< unsigned > >& adj_list = gr_it->second.get_adj_list();
-  maslevtsov::Vector< size_t > all_distances;
-  size_t max_distance = get_max_distance(gr_it->second, *adj_list.begin());
-  for (auto i = ++adj_list.begin(); i != adj_list.end(); ++i) {
-    size_t distance = get_max_distance(gr_it->second, *i);
-    if (max_distance < distance) {
-      max_distance = distance;
-    }
-  }
-  out << max_distance << '\n';
+  out << gr_it->second.get_snapshot().get_width() << '\n';
 }
 
 void maslevtsov::get_graph_components(const graphs_t& graphs, std::istream& in, std::ostream& out)
@@ -146,34 +87,7 @@ void maslevtsov::get_graph_components(const graphs_t& graphs, std::istream& in,
   if (gr_it == graphs.cend()) {
     throw std::invalid_argument("non-existing graph");
   }
-  const maslevtsov::HashTable< unsigned, maslevtsov::Vector< unsigned > >& adj_list = gr_it->second.get_adj_list();
-  maslevtsov::HashTable< unsigned, bool > visited_vertices;
-  maslevtsov::Vector< maslevtsov::Vector< unsigned > > all_components;
-  for (auto vertice_it = adj_list.begin(); vertice_it != adj_list.end(); ++vertice_it) {
-    if (visited_vertices.find(vertice_it->first) != visited_vertices.end()) {
-      continue;
-    }
-    distances_t distances;
-    parents_t parents;
-    get_bfs_from(gr_it->second, vertice_it->first, distances, parents);
-    maslevtsov::Vector< unsigned > component;
-    for (auto parent_it = parents.begin(); parent_it != parents.end(); ++parent_it) {
-      if (visited_vertices.find(parent_it->first) == visited_vertices.end()) {
-        visited_vertices[parent_it->first] = true;
-        component.push_back(parent_it->first);
-      }
-      if (visited_vertices.find(parent_it->second) == visited_vertices.end()) {
-        visited_vertices[parent_it->second] = true;
-        component.push_back(parent_it->second);
-      }
-    }
-    if (component.empty() && visited_vertices.find(vertice_it->first) == visited_vertices.end()) {
-      component.push_back(vertice_it->first);
-      visited_vertices[vertice_it->first] = true;
-    }
-    sort(component);
-    all_components.push_back(component);
-  }
+  const maslevtsov::CsrSnapshot::components_t all_components = gr_it->second.get_snapshot().get_components();
   for (auto i = all_components.begin(); i != all_components.end(); ++i) {
     out << *i->begin();
     for (auto j = ++i->begin(); j != i->end(); ++j) {
@@ -0,0 +1,316 @@
+#include "csr_snapshot.hpp"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <hash_table/definition.hpp>
+#include <vector/definition.hpp>
+
+namespace {
+  constexpr unsigned lanes_count = 64;
+  constexpr size_t unvisited = std::numeric_limits< size_t >::max();
+}
+
+maslevtsov::CsrSnapshot::CsrSnapshot(const adjacency_list_t& adj_list):
+  vertices_(adj_list.size()),
+  ids_(),
+  offsets_(adj_list.size() + 1),
+  targets_()
+{
+  unsigned id = 0;
+  size_t edges_count = 0;
+  for (auto i = adj_list.cbegin(); i != adj_list.cend(); ++i, ++id) {
+    vertices_[id] = i->first;
+    ids_[i->first] = id;
+    edges_count += i->second.size();
+    offsets_[id + 1] = edges_count;
+  }
+  maslevtsov::Vector< unsigned > targets(edges_count);
+  size_t edge = 0;
+  for (auto i = adj_list.cbegin(); i != adj_list.cend(); ++i) {
+    for (auto j = i->second.cbegin(); j != i->second.cend(); ++j) {
+      targets[edge++] = ids_.at(*j);
+    }
+  }
+  targets_ = std::move(targets);
+}
+
+size_t maslevtsov::CsrSnapshot::size() const noexcept
+{
+  return vertices_.size();
+}
+
+bool maslevtsov::CsrSnapshot::contains(unsigned vertice) const noexcept
+{
+  return ids_.find(vertice) != ids_.cend();
+}
+
+unsigned maslevtsov::CsrSnapshot::get_id(unsigned vertice) const
+{
+  return ids_.at(vertice);
+}
+
+unsigned maslevtsov::CsrSnapshot::get_vertice(unsigned id) const noexcept
+{
+  return vertices_[id];
+}
+
+void maslevtsov::CsrSnapshot::traverse(unsigned start_id, maslevtsov::Vector< unsigned >& order,
+  maslevtsov::Vector< size_t >& distances, maslevtsov::Vector< unsigned >& parents) const
+{
+  maslevtsov::Vector< unsigned > order_result;
+  maslevtsov::Vector< size_t > distances_result(size());
+  maslevtsov::Vector< unsigned > parents_result(size());
+  for (size_t i = 0; i != size(); ++i) {
+    distances_result[i] = unvisited;
+  }
+  distances_result[start_id] = 0;
+  parents_result[start_id] = start_id;
+  order_result.push_back(start_id);
+  for (size_t head = 0; head != order_result.size(); ++head) {
+    unsigned current_id = order_result[head];
+    for (size_t i = offsets_[current_id]; i != offsets_[current_id + 1]; ++i) {
+      unsigned neighbour_id = targets_[i];
+      if (distances_result[neighbour_id] == unvisited) {
+        distances_result[neighbour_id] = distances_result[current_id] + 1;
+        parents_result[neighbour_id] = current_id;
+        order_result.push_back(neighbour_id);
+      }
+    }
+  }
+  order = std::move(order_result);
+  distances = std::move(distances_result);
+  parents = std::move(parents_result);
+}
+
+size_t maslevtsov::CsrSnapshot::get_width() const
+{
+  unsigned workers_count = std::max(std::thread::hardware_concurrency(), 1u);
+  maslevtsov::Vector< BfsLanes > lanes(workers_count);
+  for (size_t i = 0; i != workers_count; ++i) {
+    lanes[i] = BfsLanes(size());
+  }
+  maslevtsov::Vector< size_t > lower(size());
+  maslevtsov::Vector< size_t > upper(size());
+  for (size_t i = 0; i != size(); ++i) {
+    upper[i] = unvisited;
+  }
+  maslevtsov::Vector< unsigned > candidates(size());
+  size_t width = 0;
+  while (true) {
+    size_t candidates_count = 0;
+    for (unsigned id = 0; id != size(); ++id) {
+      if (upper[id] > width) {
+        candidates[candidates_count++] = id;
+      }
+    }
+    if (candidates_count == 0) {
+      return width;
+    }
+    unsigned* first = std::addressof(candidates[0]);
+    size_t sources_count = std::min< size_t >(candidates_count, workers_count * lanes_count);
+    if (sources_count != candidates_count) {
+      auto is_less_central = [&upper](unsigned lhs, unsigned rhs)
+      {
+        return upper[lhs] > upper[rhs];
+      };
+      auto is_more_central = [&lower](unsigned lhs, unsigned rhs)
+      {
+        return lower[lhs] < lower[rhs];
+      };
+      size_t half = sources_count / 2;
+      std::nth_element(first, first + half, first + candidates_count, is_less_central);
+      std::nth_element(first + half, first + sources_count, first + candidates_count, is_more_central);
+    }
+    unsigned batches_count = (sources_count + lanes_count - 1) / lanes_count;
+    maslevtsov::Vector< std::thread > workers(batches_count - 1);
+    unsigned started = 0;
+    try {
+      for (; started != batches_count - 1; ++started) {
+        size_t batch_first = (started + 1) * lanes_count;
+        size_t batch_count = std::min< size_t >(lanes_count, sources_count - batch_first);
+        workers[started] = std::thread(&CsrSnapshot::bound_eccentricities, this, first + batch_first, batch_count,
+          std::ref(lanes[started + 1]));
+      }
+    } catch (...) {
+      for (unsigned i = 0; i != started; ++i) {
+        workers[i].join();
+      }
+      throw;
+    }
+    bound_eccentricities(first, std::min< size_t >(lanes_count, sources_count), lanes[0]);
+    for (unsigned i = 0; i != started; ++i) {
+      workers[i].join();
+    }
+    for (unsigned batch = 0; batch != batches_count; ++batch) {
+      for (size_t i = 0; i != size(); ++i) {
+        lower[i] = std::max(lower[i], lanes[batch].lower[i]);
+        upper[i] = std::min(upper[i], lanes[batch].upper[i]);
+        width = std::max(width, lower[i]);
+      }
+    }
+  }
+}
+
+maslevtsov::CsrSnapshot::components_t maslevtsov::CsrSnapshot::get_components() const
+{
+  maslevtsov::Vector< unsigned > order;
+  maslevtsov::Vector< size_t > starts;
+  sweep(order, starts);
+  components_t components;
+  for (size_t i = 0; i + 1 < starts.size(); ++i) {
+    maslevtsov::Vector< unsigned > component(starts[i + 1] - starts[i]);
+    for (size_t j = 0; j != component.size(); ++j) {
+      component[j] = vertices_[order[starts[i] + j]];
+    }
+    unsigned* first = std::addressof(component[0]);
+    std::sort(first, first + component.size());
+    components.push_back(std::move(component));
+  }
+  return components;
+}
+
+void maslevtsov::CsrSnapshot::sweep(maslevtsov::Vector< unsigned >& order, maslevtsov::Vector< size_t >& starts) const
+{
+  maslevtsov::Vector< unsigned > order_result(size());
+  maslevtsov::Vector< size_t > starts_result;
+  maslevtsov::Vector< bool > visited(size());
+  size_t tail = 0;
+  for (unsigned start_id = 0; start_id != size(); ++start_id) {
+    if (visited[start_id]) {
+      continue;
+    }
+    starts_result.push_back(tail);
+    visited[start_id] = true;
+    order_result[tail++] = start_id;
+    for (size_t head = starts_result.back(); head != tail; ++head) {
+      unsigned current_id = order_result[head];
+      for (size_t i = offsets_[current_id]; i != offsets_[current_id + 1]; ++i) {
+        if (!visited[targets_[i]]) {
+          visited[targets_[i]] = true;
+          order_result[tail++] = targets_[i];
+        }
+      }
+    }
+  }
+  starts_result.push_back(tail);
+  order = std::move(order_result);
+  starts = std::move(starts_result);
+}
+
+maslevtsov::CsrSnapshot::BfsLanes::BfsLanes(size_t vertices_count):
+  seen(vertices_count),
+  frontier(vertices_count),
+  next(vertices_count),
+  current(vertices_count),
+  touched(vertices_count),
+  eccentricities(lanes_count),
+  lower(vertices_count),
+  upper(vertices_count)
+{}
+
+template< class Visitor >
+void maslevtsov::CsrSnapshot::expand_lanes(const unsigned* sources, size_t sources_count, BfsLanes& lanes,
+  Visitor visit) const noexcept
+{
+  std::uint64_t* seen = std::addressof(lanes.seen[0]);
+  std::uint64_t* frontier = std::addressof(lanes.frontier[0]);
+  std::uint64_t* next = std::addressof(lanes.next[0]);
+  unsigned* current = std::addressof(lanes.current[0]);
+  unsigned* touched = std::addressof(lanes.touched[0]);
+  const size_t* offsets = std::addressof(offsets_[0]);
+  const unsigned* targets = targets_.empty() ? nullptr : std::addressof(targets_[0]);
+  for (size_t i = 0; i != size(); ++i) {
+    seen[i] = 0;
+  }
+  size_t current_count = 0;
+  for (size_t i = 0; i != sources_count; ++i) {
+    std::uint64_t lane = std::uint64_t(1) << i;
+    seen[sources[i]] = lane;
+    frontier[sources[i]] = lane;
+    current[current_count++] = sources[i];
+  }
+  for (size_t i = 0; i != sources_count; ++i) {
+    lanes.eccentricities[i] = 0;
+  }
+  for (size_t level = 0; current_count != 0; ++level) {
+    std::uint64_t level_lanes = 0;
+    size_t touched_count = 0;
+    for (size_t i = 0; i != current_count; ++i) {
+      unsigned id = current[i];
+      std::uint64_t lanes_mask = frontier[id];
+      frontier[id] = 0;
+      level_lanes |= lanes_mask;
+      visit(id, lanes_mask, level);
+      for (const unsigned* j = targets + offsets[id]; j != targets + offsets[id + 1]; ++j) {
+        if (next[*j] == 0) {
+          touched[touched_count++] = *j;
+        }
+        next[*j] |= lanes_mask;
+      }
+    }
+    for (size_t lane = 0; level_lanes != 0; ++lane, level_lanes >>= 1) {
+      if (level_lanes & 1) {
+        lanes.eccentricities[lane] = level;
+      }
+    }
+    current_count = 0;
+    for (size_t i = 0; i != touched_count; ++i) {
+      unsigned id = touched[i];
+      std::uint64_t reached = next[id] & ~seen[id];
+      next[id] = 0;
+      if (reached != 0) {
+        seen[id] |= reached;
+        frontier[id] = reached;
+        current[current_count++] = id;
+      }
+    }
+  }
+}
+
+void maslevtsov::CsrSnapshot::bound_eccentricities(const unsigned* sources, size_t sources_count,
+  BfsLanes& lanes) const noexcept
+{
+  expand_lanes(sources, sources_count, lanes, [](unsigned, std::uint64_t, size_t)
+  {});
+  size_t groups_count = 0;
+  std::uint64_t groups[lanes_count] = {};
+  size_t group_eccentricities[lanes_count] = {};
+  for (size_t i = 0; i != sources_count; ++i) {
+    size_t eccentricity = lanes.eccentricities[i];
+    size_t group = 0;
+    while (group != groups_count && group_eccentricities[group] < eccentricity) {
+      ++group;
+    }
+    if (group == groups_count || group_eccentricities[group] != eccentricity) {
+      for (size_t j = groups_count; j != group; --j) {
+        groups[j] = groups[j - 1];
+        group_eccentricities[j] = group_eccentricities[j - 1];
+      }
+      groups[group] = 0;
+      group_eccentricities[group] = eccentricity;
+      ++groups_count;
+    }
+    groups[group] |= std::uint64_t(1) << i;
+  }
+  maslevtsov::Vector< size_t >& lower = lanes.lower;
+  maslevtsov::Vector< size_t >& upper = lanes.upper;
+  for (size_t i = 0; i != size(); ++i) {
+    lower[i] = 0;
+    upper[i] = unvisited;
+  }
+  expand_lanes(sources, sources_count, lanes, [&](unsigned id, std::uint64_t lanes_mask, size_t level)
+  {
+    size_t nearest = 0;
+    while ((groups[nearest] & lanes_mask) == 0) {
+      ++nearest;
+    }
+    size_t farthest = groups_count - 1;
+    while ((groups[farthest] & lanes_mask) == 0) {
+      --farthest;
+    }
+    upper[id] = std::min(upper[id], group_eccentricities[nearest] + level);
+    lower[id] = std::max(lower[id], std::max(level, group_eccentricities[farthest] - level));
+  });
+}
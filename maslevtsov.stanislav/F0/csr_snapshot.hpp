@@ -0,0 +1,55 @@
+#ifndef CSR_SNAPSHOT_HPP
+#define CSR_SNAPSHOT_HPP
+
+#include <cstdint>
+#include <hash_table/declaration.hpp>
+#include <vector/declaration.hpp>
+
+namespace maslevtsov {
+  class CsrSnapshot
+  {
+  public:
+    using adjacency_list_t = maslevtsov::HashTable< unsigned, maslevtsov::Vector< unsigned > >;
+    using components_t = maslevtsov::Vector< maslevtsov::Vector< unsigned > >;
+
+    explicit CsrSnapshot(const adjacency_list_t& adj_list);
+
+    size_t size() const noexcept;
+    bool contains(unsigned vertice) const noexcept;
+    unsigned get_id(unsigned vertice) const;
+    unsigned get_vertice(unsigned id) const noexcept;
+
+    void traverse(unsigned start_id, maslevtsov::Vector< unsigned >& order, maslevtsov::Vector< size_t >& distances,
+      maslevtsov::Vector< unsigned >& parents) const;
+    size_t get_width() const;
+    components_t get_components() const;
+
+  private:
+    struct BfsLanes
+    {
+      BfsLanes() = default;
+      explicit BfsLanes(size_t vertices_count);
+
+      maslevtsov::Vector< std::uint64_t > seen;
+      maslevtsov::Vector< std::uint64_t > frontier;
+      maslevtsov::Vector< std::uint64_t > next;
+      maslevtsov::Vector< unsigned > current;
+      maslevtsov::Vector< unsigned > touched;
+      maslevtsov::Vector< size_t > eccentricities;
+      maslevtsov::Vector< size_t > lower;
+      maslevtsov::Vector< size_t > upper;
+    };
+
+    maslevtsov::Vector< unsigned > vertices_;
+    maslevtsov::HashTable< unsigned, unsigned > ids_;
+    maslevtsov::Vector< size_t > offsets_;
+    maslevtsov::Vector< unsigned > targets_;
+
+    void sweep(maslevtsov::Vector< unsigned >& order, maslevtsov::Vector< size_t >& starts) const;
+    template< class Visitor >
+    void expand_lanes(const unsigned* sources, size_t sources_count, BfsLanes& lanes, Visitor visit) const noexcept;
+    void bound_eccentricities(const unsigned* sources, size_t sources_count, BfsLanes& lanes) const noexcept;
+  };
+}
+
+#endif
@@ -80,11 +80,20 @@ const maslevtsov::Graph::adjacency_list_t& maslevtsov::Graph::get_adj_list() con
   return adjacency_list_;
 }
 
+const maslevtsov::CsrSnapshot& maslevtsov::Graph::get_snapshot() const
+{
+  if (!snapshot_) {
+    snapshot_ = std::make_shared< const CsrSnapshot >(adjacency_list_);
+  }
+  return *snapshot_;
+}
+
 void maslevtsov::Graph::add_vertice(unsigned vertice)
 {
   if (adjacency_list_.find(vertice) != adjacency_list_.end()) {
     throw std::invalid_argument("vertice already exist");
   }
+  snapshot_.reset();
   adjacency_list_[vertice];
 }
 
@@ -96,6 +105,7 @@ void maslevtsov::Graph::add_edge(unsigned vertice1, unsigned vertice2)
       throw std::invalid_argument("edge already exist");
     }
   }
+  snapshot_.reset();
   adjacency_list_[vertice1].push_back(vertice2);
   adjacency_list_[vertice2].push_back(vertice1);
 }
@@ -105,6 +115,7 @@ void maslevtsov::Graph::delete_vertice(unsigned vertice)
   if (adjacency_list_.find(vertice) == adjacency_list_.end()) {
     throw std::invalid_argument("non-existing vertice");
   }
+  snapshot_.reset();
   auto neighbours_it = adjacency_list_.find(vertice)->second;
   for (auto i = neighbours_it.begin(); i != neighbours_it.end(); ++i) {
     auto neighbour_it = adjacency_list_.find(*i);
@@ -123,6 +134,7 @@ void maslevtsov::Graph::delete_edge(unsigned vertice1, unsigned vertice2)
   if (find_neighbour(vertice1_it->second, vertice2) == vertice1_it->second.cend()) {
     throw std::invalid_argument("non-existing edge");
   }
+  snapshot_.reset();
   vertice1_it->second.erase(find_neighbour(vertice1_it->second, vertice2));
   auto vertice2_it = adjacency_list_.find(vertice2);
   vertice2_it->second.erase(find_neighbour(vertice2_it->second, vertice1));
@@ -2,8 +2,10 @@
 #define GRAPH_HPP
 
 #include <hash_table/declaration.hpp>
+#include <memory>
 #include <string>
 #include <vector/declaration.hpp>
+#include "csr_snapshot.hpp"
 
 namespace maslevtsov {
   class Graph
@@ -16,6 +18,7 @@ namespace maslevtsov {
     Graph(const Graph& src, const maslevtsov::Vector< unsigned >& vertices);
 
     const adjacency_list_t& get_adj_list() const;
+    const CsrSnapshot& get_snapshot() const;
 
     void add_vertice(unsigned vertice);
     void add_edge(unsigned vertice1, unsigned vertice2);
@@ -24,6 +27,7 @@ namespace maslevtsov {
 
   private:
     adjacency_list_t adjacency_list_;
+    mutable std::shared_ptr< const CsrSnapshot > snapshot_;
 
     friend std::istream& operator>>(std::istream& in, Graph& gr);
     friend std::ostream& operator<<(std::ostream& out, const Graph& gr);
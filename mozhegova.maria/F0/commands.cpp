@@ -25,9 +25,9 @@ namespace
     void operator()(constWord & word) const
     {
       out << std::left << std::setw(width) << word.first;
-      for (size_t i = 0; i < word.second.size(); ++i)
+      for (auto it = word.second.begin(); it != word.second.end(); ++it)
       {
-        PrintWordPos{out}(word.second[i]);
+        PrintWordPos{out}(*it);
       }
       out << '\n';
     }
@@ -61,9 +61,9 @@ namespace
     mozhegova::DynamicArray< std::pair< mozhegova::WordPos, std::string > > sortedWords;
     for (auto it1 = text.cbegin(); it1 != text.cend(); ++it1)
     {
-      for (size_t i = 0; i < it1->second.size(); ++i)
+      for (auto it2 = it1->second.begin(); it2 != it1->second.end(); ++it2)
       {
-        sortedWords.push_back({it1->second[i], it1->first});
+        sortedWords.push_back({*it2, it1->first});
       }
     }
     bubbleSort(sortedWords);
@@ -113,17 +113,16 @@ namespace
 
   size_t getMaxLineNumWord(constWord & word)
   {
-    mozhegova::Xrefs xrefs = word.second;
-    if (xrefs.empty())
+    if (word.second.empty())
     {
       return 0;
     }
     size_t maxNumWord = 1;
-    for (size_t i = 0; i < word.second.size(); ++i)
+    for (auto it = word.second.begin(); it != word.second.end(); ++it)
     {
-      if (maxNumWord < word.second[i].first)
+      if (maxNumWord < it->first)
       {
-        maxNumWord = word.second[i].first;
+        maxNumWord = it->first;
       }
     }
     return maxNumWord;
@@ -144,17 +143,16 @@ namespace
 
   size_t getMaxNumWord(constWord & word)
   {
-    mozhegova::Xrefs xrefs = word.second;
-    if (xrefs.empty())
+    if (word.second.empty())
     {
       return 0;
     }
     size_t maxNumWord = 1;
-    for (size_t i = 0; i < word.second.size(); ++i)
+    for (auto it = word.second.begin(); it != word.second.end(); ++it)
     {
-      if (maxNumWord < word.second[i].second)
+      if (maxNumWord < it->second)
       {
-        maxNumWord = word.second[i].second;
+        maxNumWord = it->second;
       }
     }
     return maxNumWord;
@@ -179,11 +177,11 @@ namespace
     for (auto it1 = text.cbegin(); it1 != text.cend(); ++it1)
     {
       mozhegova::Xrefs newXrefs;
-      for (size_t i = 0; i < it1->second.size(); ++i)
+      for (auto it2 = it1->second.begin(); it2 != it1->second.end(); ++it2)
       {
-        if (it1->second[i].first >= begin && it1->second[i].first < end)
+        if (it2->first >= begin && it2->first < end)
         {
-          newXrefs.push_back(it1->second[i]);
+          newXrefs.push_back(*it2);
         }
       }
       if (!newXrefs.empty())
@@ -194,24 +192,94 @@ namespace
     return result;
   }
 
+  template< typename F >
+  void rewriteXrefs(mozhegova::Xrefs & xrefs, F f)
+  {
+    mozhegova::Xrefs result;
+    for (auto it = xrefs.begin(); it != xrefs.end(); ++it)
+    {
+      result.push_back(f(*it));
+    }
+    xrefs = std::move(result);
+  }
+
+  struct ShiftLinesDown
+  {
+    size_t from;
+    size_t count;
+    mozhegova::WordPos operator()(mozhegova::WordPos pos) const
+    {
+      if (pos.first >= from)
+      {
+        pos.first += count;
+      }
+      return pos;
+    }
+  };
+
+  struct ShiftLinesUp
+  {
+    size_t from;
+    size_t count;
+    mozhegova::WordPos operator()(mozhegova::WordPos pos) const
+    {
+      if (pos.first >= from)
+      {
+        pos.first -= count;
+      }
+      return pos;
+    }
+  };
+
+  struct InvertLine
+  {
+    size_t maxLine;
+    mozhegova::WordPos operator()(mozhegova::WordPos pos) const
+    {
+      pos.first = maxLine - pos.first + 1;
+      return pos;
+    }
+  };
+
+  struct InvertWord
+  {
+    size_t maxLine;
+    size_t maxNum;
+    mozhegova::WordPos operator()(mozhegova::WordPos pos) const
+    {
+      if (pos.first >= 1 && pos.first <= maxLine)
+      {
+        pos.second = maxNum - pos.second + 1;
+      }
+      return pos;
+    }
+  };
+
+  bool hasLineInRange(const mozhegova::Xrefs & xrefs, size_t begin, size_t end)
+  {
+    for (auto it = xrefs.begin(); it != xrefs.end(); ++it)
+    {
+      if (it->first >= begin && it->first < end)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
   void insertTextTo(mozhegova::Text & text1, const mozhegova::Text & text2, size_t n, size_t begin, size_t end)
   {
     mozhegova::Text temp = extractSubstring(text2, begin, end);
     for (auto it1 = text1.begin(); it1 != text1.end(); ++it1)
     {
-      for (size_t i = 0; i < it1->second.size(); ++i)
-      {
-        if (it1->second[i].first >= n)
-        {
-          it1->second[i].first += (end - begin);
-        }
-      }
+      rewriteXrefs(it1->second, ShiftLinesDown{n, end - begin});
     }
     for (auto it2 = temp.cbegin(); it2 != temp.cend(); ++it2)
     {
-      for (size_t i = 0; i < it2->second.size(); ++i)
+      mozhegova::Xrefs & xrefs = text1[it2->first];
+      for (auto it3 = it2->second.begin(); it3 != it2->second.end(); ++it3)
       {
-        text1[it2->first].push_back({it2->second[i].first + n - begin, it2->second[i].second});
+        xrefs.push_back({it3->first + n - begin, it3->second});
       }
     }
   }
@@ -220,26 +288,93 @@ namespace
   {
     for (auto it1 = text.begin(); it1 != text.end();)
     {
-      bool isDeleted = false;
-      for (size_t i = 0; i < it1->second.size(); ++i)
+      if (hasLineInRange(it1->second, begin, end))
       {
-        if (it1->second[i].first >= begin && it1->second[i].first < end)
-        {
-          it1 = text.erase(it1);
-          isDeleted = true;
-          break;
-        }
-        else if (it1->second[i].first >= end)
-        {
-          it1->second[i].first -= (end - begin);
-        }
+        it1 = text.erase(it1);
       }
-      if (!isDeleted)
+      else
       {
+        rewriteXrefs(it1->second, ShiftLinesUp{end, end - begin});
         ++it1;
       }
     }
   }
+
+  class LinksScanner
+  {
+  public:
+    explicit LinksScanner(mozhegova::Text & text);
+    void feed(const char * data, size_t size);
+    void finish();
+  private:
+    mozhegova::Text & text_;
+    std::string word_;
+    size_t line_;
+    size_t num_;
+    bool lineBreakAllowed_;
+    void flushWord();
+  };
+
+  bool isSpace(char c)
+  {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+  }
+
+  LinksScanner::LinksScanner(mozhegova::Text & text):
+    text_(text),
+    word_(),
+    line_(1),
+    num_(0),
+    lineBreakAllowed_(true)
+  {}
+
+  void LinksScanner::feed(const char * data, size_t size)
+  {
+    size_t i = 0;
+    while (i < size)
+    {
+      size_t start = i;
+      while (i < size && !isSpace(data[i]))
+      {
+        ++i;
+      }
+      word_.append(data + start, i - start);
+      if (i == size)
+      {
+        break;
+      }
+      if (!word_.empty())
+      {
+        flushWord();
+      }
+      if (data[i] == '\n' && lineBreakAllowed_)
+      {
+        ++line_;
+        num_ = 0;
+      }
+      else
+      {
+        lineBreakAllowed_ = false;
+      }
+      ++i;
+    }
+  }
+
+  void LinksScanner::finish()
+  {
+    if (!word_.empty())
+    {
+      flushWord();
+    }
+  }
+
+  void LinksScanner::flushWord()
+  {
+    ++num_;
+    text_[word_].push_back({line_, num_});
+    word_.clear();
+    lineBreakAllowed_ = true;
+  }
 }
 
 void mozhegova::generateLinks(std::istream & in, Texts & texts)
@@ -256,19 +391,14 @@ void mozhegova::generateLinks(std::istream & in, Texts & texts)
     throw std::runtime_error("<INVALID COMMAND>");
   }
   Text text{};
-  size_t line = 0;
-  while (!file.eof())
+  LinksScanner scanner(text);
+  constexpr size_t chunkSize = 1 << 16;
+  char chunk[chunkSize];
+  while (file.read(chunk, chunkSize) || file.gcount() > 0)
   {
-    ++line;
-    std::string word;
-    size_t num = 0;
-    while (file.peek() != '\n' && file >> word)
-    {
-      ++num;
-      text[word].push_back({line, num});
-    }
-    file.ignore();
+    scanner.feed(chunk, static_cast< size_t >(file.gcount()));
   }
+  scanner.finish();
   texts[textName] = std::move(text);
 }
 
@@ -426,19 +556,17 @@ void mozhegova::sideMergeTexts(std::istream & in, Texts & texts)
   const Text & text1 = it1->second;
   const Text & text2 = it2->second;
   Text temp1 = text1;
-  Text temp2 = text2;
   size_t maxLines = std::max(getMaxLineNum(text1), getMaxLineNum(text2));
   size_t maxNum = getMaxNum(text1);
   for (size_t line = 1; line <= maxLines; ++line)
   {
-    for (auto it1 = temp2.begin(); it1 != temp2.end(); ++it1)
+    for (auto it1 = text2.cbegin(); it1 != text2.cend(); ++it1)
     {
-      for (size_t i = 0; i < it1->second.size(); ++i)
+      for (auto it2 = it1->second.begin(); it2 != it1->second.end(); ++it2)
       {
-        if (it1->second[i].first == line)
+        if (it2->first == line)
         {
-          it1->second[i].second += maxNum;
-          temp1[it1->first].push_back(it1->second[i]);
+          temp1[it1->first].push_back({it2->first, it2->second + maxNum});
         }
       }
     }
@@ -482,10 +610,7 @@ void mozhegova::invertLines(std::istream & in, Texts & texts)
   size_t maxLine = getMaxLineNum(text);
   for (auto it1 = text.begin(); it1 != text.end(); ++it1)
   {
-    for (size_t i = 0; i < it1->second.size(); ++i)
-    {
-      it1->second[i].first = maxLine - it1->second[i].first + 1;
-    }
+    rewriteXrefs(it1->second, InvertLine{maxLine});
   }
 }
 
@@ -501,18 +626,9 @@ void mozhegova::invertWords(std::istream & in, Texts & texts)
   Text & text = it->second;
   size_t maxLines = getMaxLineNum(text);
   size_t maxNum = getMaxNum(text);
-  for (size_t line = 1; line <= maxLines; ++line)
+  for (auto it1 = text.begin(); it1 != text.end(); ++it1)
   {
-    for (auto it1 = text.begin(); it1 != text.end(); ++it1)
-    {
-      for (size_t i = 0; i < it1->second.size(); ++i)
-      {
-        if (it1->second[i].first == line)
-        {
-          it1->second[i].second = maxNum - it1->second[i].second + 1;
-        }
-      }
-    }
+    rewriteXrefs(it1->second, InvertWord{maxLines, maxNum});
   }
 }
 
@@ -4,11 +4,11 @@
 #include <iostream>
 #include <hashTable.hpp>
 #include <dynamicArray.hpp>
+#include "postings.hpp"
 
 namespace mozhegova
 {
-  using WordPos = std::pair< size_t, size_t >;
-  using Xrefs = DynamicArray< WordPos >;
+  using Xrefs = Postings;
   using Text = HashTable< std::string, Xrefs >;
   using Texts = HashTable< std::string, Text >;
 
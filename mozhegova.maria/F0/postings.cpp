@@ -0,0 +1,189 @@
+#include "postings.hpp"
+#include <memory>
+
+namespace
+{
+  unsigned long long zigzag(long long value)
+  {
+    return (static_cast< unsigned long long >(value) << 1) ^ static_cast< unsigned long long >(value >> 63);
+  }
+
+  long long unzigzag(unsigned long long value)
+  {
+    return static_cast< long long >(value >> 1) ^ -static_cast< long long >(value & 1);
+  }
+
+  long long delta(size_t to, size_t from)
+  {
+    return static_cast< long long >(to) - static_cast< long long >(from);
+  }
+
+  size_t shift(size_t from, long long delta)
+  {
+    return static_cast< size_t >(static_cast< long long >(from) + delta);
+  }
+
+  void writeVarint(mozhegova::DynamicArray< unsigned char > & bytes, unsigned long long value)
+  {
+    while (value >= 0x80)
+    {
+      bytes.push_back(static_cast< unsigned char >(value | 0x80));
+      value >>= 7;
+    }
+    bytes.push_back(static_cast< unsigned char >(value));
+  }
+
+  unsigned long long readVarint(const unsigned char *& it)
+  {
+    unsigned long long value = 0;
+    int bits = 0;
+    while (*it & 0x80)
+    {
+      value |= static_cast< unsigned long long >(*it++ & 0x7F) << bits;
+      bits += 7;
+    }
+    value |= static_cast< unsigned long long >(*it++) << bits;
+    return value;
+  }
+}
+
+mozhegova::Postings::ConstIterator::ConstIterator():
+  entry_(nullptr),
+  next_(nullptr),
+  end_(nullptr),
+  pos_(0, 0)
+{}
+
+mozhegova::Postings::ConstIterator::ConstIterator(const unsigned char * begin, const unsigned char * end):
+  entry_(begin),
+  next_(begin),
+  end_(end),
+  pos_(0, 0)
+{
+  if (entry_ != end_)
+  {
+    decode();
+  }
+}
+
+void mozhegova::Postings::ConstIterator::decode()
+{
+  next_ = entry_;
+  long long lineDelta = unzigzag(readVarint(next_));
+  long long numDelta = unzigzag(readVarint(next_));
+  pos_.second = shift(lineDelta == 0 ? pos_.second : 0, numDelta);
+  pos_.first = shift(pos_.first, lineDelta);
+}
+
+const mozhegova::WordPos & mozhegova::Postings::ConstIterator::operator*() const
+{
+  return pos_;
+}
+
+const mozhegova::WordPos * mozhegova::Postings::ConstIterator::operator->() const
+{
+  return std::addressof(pos_);
+}
+
+mozhegova::Postings::ConstIterator & mozhegova::Postings::ConstIterator::operator++()
+{
+  entry_ = next_;
+  if (entry_ != end_)
+  {
+    decode();
+  }
+  return *this;
+}
+
+mozhegova::Postings::ConstIterator mozhegova::Postings::ConstIterator::operator++(int)
+{
+  ConstIterator result(*this);
+  ++(*this);
+  return result;
+}
+
+bool mozhegova::Postings::ConstIterator::operator==(const ConstIterator & rhs) const
+{
+  return entry_ == rhs.entry_;
+}
+
+bool mozhegova::Postings::ConstIterator::operator!=(const ConstIterator & rhs) const
+{
+  return !(*this == rhs);
+}
+
+mozhegova::Postings::Postings():
+  bytes_(),
+  size_(0),
+  last_(0, 0)
+{}
+
+mozhegova::Postings::Postings(Postings && other) noexcept:
+  bytes_(std::move(other.bytes_)),
+  size_(other.size_),
+  last_(other.last_)
+{
+  other.size_ = 0;
+  other.last_ = {0, 0};
+}
+
+mozhegova::Postings & mozhegova::Postings::operator=(const Postings & other)
+{
+  if (this != std::addressof(other))
+  {
+    Postings copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+mozhegova::Postings & mozhegova::Postings::operator=(Postings && other) noexcept
+{
+  if (this != std::addressof(other))
+  {
+    Postings copy(std::move(other));
+    swap(copy);
+  }
+  return *this;
+}
+
+void mozhegova::Postings::swap(Postings & other) noexcept
+{
+  bytes_.swap(other.bytes_);
+  std::swap(size_, other.size_);
+  std::swap(last_, other.last_);
+}
+
+void mozhegova::Postings::push_back(const WordPos & pos)
+{
+  long long lineDelta = delta(pos.first, last_.first);
+  writeVarint(bytes_, zigzag(lineDelta));
+  writeVarint(bytes_, zigzag(delta(pos.second, lineDelta == 0 ? last_.second : 0)));
+  last_ = pos;
+  ++size_;
+}
+
+bool mozhegova::Postings::empty() const noexcept
+{
+  return size_ == 0;
+}
+
+size_t mozhegova::Postings::size() const noexcept
+{
+  return size_;
+}
+
+const unsigned char * mozhegova::Postings::data() const
+{
+  return bytes_.empty() ? nullptr : std::addressof(bytes_[0]);
+}
+
+mozhegova::Postings::ConstIterator mozhegova::Postings::begin() const
+{
+  return ConstIterator(data(), data() + bytes_.size());
+}
+
+mozhegova::Postings::ConstIterator mozhegova::Postings::end() const
+{
+  return ConstIterator(data() + bytes_.size(), data() + bytes_.size());
+}
@@ -0,0 +1,55 @@
+#ifndef POSTINGS_HPP
+#define POSTINGS_HPP
+
+#include <cstddef>
+#include <utility>
+#include <dynamicArray.hpp>
+
+namespace mozhegova
+{
+  using WordPos = std::pair< size_t, size_t >;
+
+  class Postings
+  {
+  public:
+    class ConstIterator
+    {
+    public:
+      ConstIterator();
+      const WordPos & operator*() const;
+      const WordPos * operator->() const;
+      ConstIterator & operator++();
+      ConstIterator operator++(int);
+      bool operator==(const ConstIterator & rhs) const;
+      bool operator!=(const ConstIterator & rhs) const;
+    private:
+      friend class Postings;
+      const unsigned char * entry_;
+      const unsigned char * next_;
+      const unsigned char * end_;
+      WordPos pos_;
+      ConstIterator(const unsigned char * begin, const unsigned char * end);
+      void decode();
+    };
+
+    Postings();
+    Postings(const Postings & other) = default;
+    Postings(Postings && other) noexcept;
+    ~Postings() = default;
+    Postings & operator=(const Postings & other);
+    Postings & operator=(Postings && other) noexcept;
+    void swap(Postings & other) noexcept;
+    void push_back(const WordPos & pos);
+    bool empty() const noexcept;
+    size_t size() const noexcept;
+    ConstIterator begin() const;
+    ConstIterator end() const;
+  private:
+    DynamicArray< unsigned char > bytes_;
+    size_t size_;
+    WordPos last_;
+    const unsigned char * data() const;
+  };
+}
+
+#endif
@@ -226,7 +226,7 @@ namespace mozhegova
     {
       return 0.0;
     }
-    return size_ / table_.size();
+    return static_cast< float >(size_) / table_.size();
   }
 
   template< class Key, class Value, class Hash, class Equal >
@@ -276,7 +276,7 @@ namespace mozhegova
       if (table_[i].occupied)
       {
         size_t newId = findIndexIn(table_[i].data.first, temp);
-        temp[newId].data = table_[i].data;
+        temp[newId].data = std::move(table_[i].data);
         temp[newId].occupied = true;
         temp[newId].deleted = false;
       }
@@ -354,7 +354,7 @@ namespace mozhegova
   template< class... Args >
   std::pair< HashIter< Key, Value, Hash, Equal >, bool > HashTable< Key, Value, Hash, Equal >::emplace(Args &&... args)
   {
-    if ((size_ + 1) / table_.size() > max_load_factor_)
+    if (static_cast< float >(size_ + 1) / table_.size() > max_load_factor_)
     {
       rehash(table_.size() * 2);
     }
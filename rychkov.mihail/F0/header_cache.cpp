@@ -0,0 +1,99 @@
+#include "header_cache.hpp"
+
+#include <utility>
+
+constexpr size_t rychkov::Preprocessor::HeaderRecord::npos;
+
+void rychkov::Preprocessor::HeaderRecord::append(const CParseContext& context, size_t epoch, State kind,
+    std::string text)
+{
+  // no line was read and no frame was entered since the last token, so the whole chain is unchanged
+  if ((&context == last_context) && (epoch == last_epoch))
+  {
+    // plain characters are merged while their positions stay put (flushed buffers) or advance by one
+    Token& last = tokens.back();
+    if ((kind == NO_STATE) && (last.kind == NO_STATE))
+    {
+      if (last.text.length() == 1)
+      {
+        last.advancing = (context.symbol == last.symbol + 1);
+      }
+      if (context.symbol == last.symbol + (last.advancing ? last.text.length() : 0))
+      {
+        last.text += text;
+        return;
+      }
+    }
+    tokens.push_back({kind, std::move(text), last.frame, context.symbol});
+    return;
+  }
+  last_context = &context;
+  last_epoch = epoch;
+  std::vector< const CParseContext* > chain;
+  for (const CParseContext* level = &context; level != root; level = level->base)
+  {
+    chain.push_back(level);
+  }
+  chain.push_back(root);
+
+  size_t parent = npos;
+  size_t depth = 0;
+  for (std::vector< const CParseContext* >::reverse_iterator i = chain.rbegin(); i != chain.rend(); ++i, depth++)
+  {
+    const CParseContext& level = **i;
+    size_t symbol = (&level == &context) ? 0 : level.symbol;
+    if (depth < last_path.size())
+    {
+      const Frame& frame = frames[last_path[depth]];
+      if ((frame.parent == parent) && (frame.line == level.line) && (frame.symbol == symbol)
+          && (frame.macro_expansion == level.macro_expansion) && (frame.file == level.file)
+          && (frame.last_line == level.last_line))
+      {
+        parent = last_path[depth];
+        continue;
+      }
+      last_path.resize(depth);
+    }
+    frames.push_back({level.file, level.macro_expansion, level.line, symbol, level.last_line, parent});
+    parent = frames.size() - 1;
+    last_path.push_back(parent);
+  }
+  last_path.resize(depth);
+  tokens.push_back({kind, std::move(text), parent, context.symbol});
+}
+void rychkov::Preprocessor::HeaderRecord::depend(const std::string& name, const Macro* macro)
+{
+  if (changed.contains(name))
+  {
+    return;
+  }
+  if (macro == nullptr)
+  {
+    absent_macros.insert(name);
+  }
+  else if (!present_macros.contains(name))
+  {
+    present_macros.emplace(name, *macro);
+  }
+}
+void rychkov::Preprocessor::HeaderRecord::change(bool define, const Macro& macro)
+{
+  changed.insert(macro.name);
+  changes.push_back({define, macro});
+}
+
+std::vector< rychkov::HeaderCache::record_pointer > rychkov::HeaderCache::find(const std::string& file) const
+{
+  std::lock_guard< std::mutex > lock(mutex_);
+  decltype(records_)::const_iterator records_p = records_.find(file);
+  if (records_p == records_.end())
+  {
+    return {};
+  }
+  return records_p->second;
+}
+void rychkov::HeaderCache::insert(const std::string& file, record_pointer record)
+{
+  std::lock_guard< std::mutex > lock(mutex_);
+  records_[file].push_back(std::move(record));
+}
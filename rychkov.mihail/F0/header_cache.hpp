@@ -0,0 +1,79 @@
+#ifndef HEADER_CACHE_HPP
+#define HEADER_CACHE_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stack.hpp>
+#include <unordered_set.hpp>
+#include <map.hpp>
+
+#include "log.hpp"
+#include "content.hpp"
+#include "preprocessor.hpp"
+
+namespace rychkov
+{
+  struct Preprocessor::HeaderRecord
+  {
+    static constexpr size_t npos = -1;
+
+    struct MacroChange
+    {
+      bool define;
+      Macro macro;
+    };
+    struct Frame
+    {
+      std::string file;
+      bool macro_expansion;
+      size_t line, symbol;
+      std::string last_line;
+      size_t parent;
+    };
+    struct Token
+    {
+      State kind;
+      std::string text;
+      size_t frame;
+      size_t symbol;
+      bool advancing = false;
+    };
+
+    ScanState entry, exit;
+    Stack< IfStage > entry_conditions, exit_conditions;
+    UnorderedSet< std::string, StringHash > absent_macros;
+    Map< std::string, Macro > present_macros;
+    std::vector< MacroChange > changes;
+    std::vector< Frame > frames;
+    std::deque< Token > tokens;
+
+    const CParseContext* root = nullptr;
+    UnorderedSet< std::string, StringHash > changed;
+    std::vector< size_t > last_path;
+    const CParseContext* last_context = nullptr;
+    size_t last_epoch = 0;
+
+    void append(const CParseContext& context, size_t epoch, State kind, std::string text);
+    void depend(const std::string& name, const Macro* macro);
+    void change(bool define, const Macro& macro);
+  };
+
+  class HeaderCache
+  {
+  public:
+    using record_pointer = std::shared_ptr< const Preprocessor::HeaderRecord >;
+
+    std::vector< record_pointer > find(const std::string& file) const;
+    void insert(const std::string& file, record_pointer record);
+
+  private:
+    mutable std::mutex mutex_;
+    Map< std::string, std::vector< record_pointer > > records_;
+  };
+}
+
+#endif
@@ -6,22 +6,76 @@
 #include "cparser.hpp"
 #include "print_content.hpp"
 
+namespace
+{
+  struct Keyword
+  {
+    const char* name;
+    size_t length;
+    rychkov::CParser::TypeKeyword type;
+    void(rychkov::CParser::*parse)(rychkov::CParseContext&);
+  };
+  constexpr Keyword keywords[] = {
+        {"const", 5, rychkov::CParser::CONST, nullptr},
+        {"volatile", 8, rychkov::CParser::VOLATILE, nullptr},
+        {"signed", 6, rychkov::CParser::SIGNED, nullptr},
+        {"unsigned", 8, rychkov::CParser::UNSIGNED, nullptr},
+        {"long", 4, rychkov::CParser::LONG, nullptr},
+        {"typedef", 7, {}, &rychkov::CParser::parse_typedef},
+        {"struct", 6, {}, &rychkov::CParser::parse_struct},
+        {"return", 6, {}, &rychkov::CParser::parse_return},
+        {"if", 2, {}, &rychkov::CParser::parse_if},
+        {"while", 5, {}, &rychkov::CParser::parse_while}
+      };
+  constexpr size_t nkeywords = sizeof(keywords) / sizeof(keywords[0]);
+  constexpr size_t nslots = 32;
+
+  // length and both edge letters are enough to tell all keywords apart
+  constexpr size_t keyword_hash(const char* name, size_t length)
+  {
+    return (length * 3 + static_cast< unsigned char >(name[0])
+        + static_cast< unsigned char >(name[length - 1])) % nslots;
+  }
+  struct KeywordSlots
+  {
+    size_t index[nslots];
+    bool perfect;
+  };
+  constexpr KeywordSlots make_keyword_slots()
+  {
+    KeywordSlots result{{}, true};
+    for (size_t i = 0; i < nslots; i++)
+    {
+      result.index[i] = nkeywords;
+    }
+    for (size_t i = 0; i < nkeywords; i++)
+    {
+      size_t& slot = result.index[keyword_hash(keywords[i].name, keywords[i].length)];
+      result.perfect = result.perfect && (slot == nkeywords);
+      slot = i;
+    }
+    return result;
+  }
+  constexpr KeywordSlots keyword_slots = make_keyword_slots();
+  static_assert(keyword_slots.perfect, "keyword hash has collisions");
+
+  const Keyword* find_keyword(const std::string& name)
+  {
+    if (name.empty())
+    {
+      return nullptr;
+    }
+    size_t index = keyword_slots.index[keyword_hash(name.data(), name.length())];
+    if ((index == nkeywords) || (name.compare(keywords[index].name) != 0))
+    {
+      return nullptr;
+    }
+    return keywords + index;
+  }
+}
+
 rychkov::Lexer::Lexer(std::unique_ptr< CParser > cparser):
-  next{std::move(cparser)},
-  type_keywords_{
-        {"const", CParser::CONST},
-        {"volatile", CParser::VOLATILE},
-        {"signed", CParser::SIGNED},
-        {"unsigned", CParser::UNSIGNED},
-        {"long", CParser::LONG}
-      },
-  keywords_{
-        {"typedef", &CParser::parse_typedef},
-        {"struct", &CParser::parse_struct},
-        {"return", &CParser::parse_return},
-        {"if", &CParser::parse_if},
-        {"while", &CParser::parse_while}
-      }
+  next{std::move(cparser)}
 {}
 
 const rychkov::Set< std::vector< rychkov::Operator >, rychkov::NameCompare > rychkov::Lexer::cases{
@@ -83,29 +137,20 @@ const rychkov::Set< std::vector< rychkov::Operator >, rychkov::NameCompare > ryc
 void rychkov::Lexer::append_name(CParseContext& context, std::string name)
 {
   flush(context);
-  decltype(type_keywords_)::const_iterator type_keyword_p = type_keywords_.find(name);
-  if (type_keyword_p != type_keywords_.end())
+  const Keyword* keyword = find_keyword(name);
+  if (keyword != nullptr)
   {
     if (next == nullptr)
     {
       context.out << "<keyw> " << name << '\n';
     }
-    else
+    else if (keyword->parse == nullptr)
     {
-      next->append(context, type_keyword_p->second);
-    }
-    return;
-  }
-  decltype(keywords_)::const_iterator keyword_p = keywords_.find(name);
-  if (keyword_p != keywords_.cend())
-  {
-    if (next == nullptr)
-    {
-      context.out << "<keyw> " << name << '\n';
+      next->append(context, keyword->type);
     }
     else
     {
-      ((*next).*(keyword_p->second))(context);
+      ((*next).*(keyword->parse))(context);
     }
     return;
   }
@@ -264,23 +309,31 @@ void rychkov::Lexer::append(CParseContext& context, char c)
 }
 void rychkov::Lexer::append_new(CParseContext& context, char c)
 {
+  if (std::isspace(c))
+  {
+    return;
+  }
   decltype(cases)::const_iterator oper_p = cases.find(std::string{c});
   if (oper_p != cases.end())
   {
     buf_ = &*oper_p;
   }
-  else if (!std::isspace(c))
+  else if (next == nullptr)
+  {
+    context.out << "<spec> " << c << '\n';
+  }
+  else
   {
-    if (next == nullptr)
-    {
-      context.out << "<spec> " << c << '\n';
-      return;
-    }
     next->append(context, c);
   }
 }
 void rychkov::Lexer::append_operator(CParseContext& context, char c)
 {
+  if (std::isspace(c))
+  {
+    flush(context);
+    return;
+  }
   operator_value& oper = get< operator_value >(buf_);
   decltype(cases)::const_iterator oper_p = cases.find((*oper)[0].token + c);
   if (oper_p != cases.cend())
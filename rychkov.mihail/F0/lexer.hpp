@@ -5,7 +5,6 @@
 #include <vector>
 #include <memory>
 #include <set.hpp>
-#include <map.hpp>
 #include <variant.hpp>
 
 #include "content.hpp"
@@ -33,9 +32,6 @@ namespace rychkov
   private:
     using operator_value = const std::vector< Operator >*;
 
-    Map< std::string, CParser::TypeKeyword > type_keywords_;
-    Map< std::string, void(CParser::*)(CParseContext&) > keywords_;
-
     Variant< Monostate, operator_value, entities::Literal > buf_;
 
     void append_new(CParseContext& context, char c);
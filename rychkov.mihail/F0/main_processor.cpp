@@ -6,6 +6,7 @@
 #include <cctype>
 #include <utility>
 #include <algorithm.hpp>
+#include "header_cache.hpp"
 
 rychkov::Parser::map_type< rychkov::MainProcessor > rychkov::MainProcessor::call_map = {
       {"save", &rychkov::MainProcessor::save},
@@ -55,6 +56,7 @@ bool rychkov::MainProcessor::parse(ParserContext& context)
     return true;
   }
   ParseCell cell = {{context.out, context.err, filename}, last_stage_, include_dirs_};
+  cell.preproc.header_cache = std::make_shared< HeaderCache >();
   context.out << "<--PARSE: \"" << filename << "\"-->\n";
   if (!cell.parse(in))
   {
@@ -72,29 +74,41 @@ bool rychkov::MainProcessor::reload(ParserContext& context)
   {
     return false;
   }
-  Map< std::string, ParseCell > new_parsed;
+  std::vector< std::string > files;
   for (const std::pair< const std::string, ParseCell >& file: parsed_)
   {
-    if (!file.second.real_file)
+    if (file.second.real_file)
     {
-      continue;
+      files.push_back(file.first);
     }
-    std::ifstream in(file.first);
-    if (!in)
+  }
+  std::vector< ParseJob > jobs(files.size());
+  for (size_t i = 0; i < files.size(); i++)
+  {
+    jobs[i].file = std::move(files[i]);
+  }
+  parse_all(jobs);
+
+  Map< std::string, ParseCell > new_parsed;
+  for (ParseJob& job: jobs)
+  {
+    if (!job.opened)
     {
-      context.err << "failed to reopen source file: \"" << file.first << "\"\n";
+      context.err << "failed to reopen source file: \"" << job.file << "\"\n";
     }
-    std::pair< decltype(new_parsed)::iterator, bool > cell_p = new_parsed.emplace(file.first,
-          ParseCell{{context.out, context.err, file.first}, last_stage_, include_dirs_});
-    if (cell_p.second)
+    context.out << "<--PARSE: \"" << job.file << "\"-->\n";
+    context.out << job.out.str();
+    context.err << job.err.str();
+    if (job.error)
     {
-      context.out << "<--PARSE: \"" << file.first << "\"-->\n";
-      if (!cell_p.first->second.parse(in))
-      {
-        context.err << "failed to parse file \"" << file.first << "\" - stopping\n";
-        return true;
-      }
+      std::rethrow_exception(job.error);
+    }
+    if (!job.parsed)
+    {
+      context.err << "failed to parse file \"" << job.file << "\" - stopping\n";
+      return true;
     }
+    new_parsed.emplace(job.file, std::move(*job.cell));
   }
   context.out << "<--DONE-->\n";
   parsed_ = std::move(new_parsed);
@@ -110,7 +124,7 @@ bool rychkov::MainProcessor::parse_after(ParserContext& context)
   {
     std::string after;
     context.in >> after;
-    const CParser& src_parser = *parsed_.at(after).preproc.next->next;
+    const CParser& src_parser = *unpacked(after).preproc.next->next;
     if (!context.in || !eol(context.in))
     {
       return false;
@@ -210,7 +224,7 @@ bool rychkov::MainProcessor::unopen_defines(ParserContext& context)
   {
     return false;
   }
-  const ParseCell& cell = parsed_.at(filename);
+  const ParseCell& cell = unpacked(filename);
   if (!eol(context.in))
   {
     return false;
@@ -2,8 +2,11 @@
 #define PROCESSORS_HPP
 
 #include <iosfwd>
+#include <sstream>
 #include <string>
 #include <vector>
+#include <memory>
+#include <exception>
 
 #include <map.hpp>
 #include <parser.hpp>
@@ -19,6 +22,7 @@ namespace rychkov
     LEXER,
     CPARSER
   };
+  struct SnapshotReader;
   struct ParseCell
   {
     ParseCell(CParseContext context, Stage last_stage, std::vector< std::string > include_dirs);
@@ -27,6 +31,20 @@ namespace rychkov
     Preprocessor preproc;
     bool real_file = true;
     std::string cache;
+
+    // set for files loaded from a snapshot until their record is decoded on first use
+    std::shared_ptr< SnapshotReader > snapshot;
+    const char* snapshot_record = nullptr;
+  };
+  struct ParseJob
+  {
+    std::string file;
+    std::ostringstream out;
+    std::ostringstream err;
+    std::unique_ptr< ParseCell > cell;
+    bool opened = false;
+    bool parsed = false;
+    std::exception_ptr error;
   };
 
   class MainProcessor
@@ -36,9 +54,10 @@ namespace rychkov
     static Parser::map_type< MainProcessor > call_map;
 
     void help(std::ostream& out);
-    bool parse(CParseContext file_context, bool overwrite);
     bool load(std::ostream& out, std::ostream& err, std::string filename);
-    bool save(std::ostream& err, std::string filename) const;
+    bool save(std::ostream& err, std::string filename);
+    bool import_json(std::ostream& out, std::ostream& err, std::string filename);
+    bool export_json(std::ostream& err, std::string filename) const;
 
     bool init(ParserContext& context, int argc, char** argv);
     bool save(ParserContext& context);
@@ -65,6 +84,11 @@ namespace rychkov
     Map< std::string, ParseCell > parsed_;
     std::string save_file_ = "save.json";
     size_t generated_files = 0;
+
+    void parse_all(std::vector< ParseJob >& jobs) const;
+    void unpack(ParseCell& cell);
+    void unpack_all();
+    ParseCell& unpacked(const std::string& filename);
   };
 }
 
@@ -44,7 +44,7 @@ bool rychkov::MainProcessor::dependencies(ParserContext& context)
   {
     return false;
   }
-  const CParser& parser = *parsed_.at(filename).preproc.next->next;
+  const CParser& parser = *unpacked(filename).preproc.next->next;
   if (!eol(context.in))
   {
     return false;
@@ -70,7 +70,7 @@ bool rychkov::MainProcessor::uses(ParserContext& context)
   {
     return false;
   }
-  const CParser& parser = *parsed_.at(filename).preproc.next->next;
+  const CParser& parser = *unpacked(filename).preproc.next->next;
   if (!eol(context.in))
   {
     return false;
@@ -104,6 +104,7 @@ bool rychkov::MainProcessor::intersections(ParserContext& context)
   {
     return false;
   }
+  unpack_all();
   DiffVisitor visitor = for_each(parsed_.begin(), parsed_.end(), DiffVisitor{});
   bool empty = true;
   for (const decltype(visitor.appearances)::value_type& list: visitor.appearances)
@@ -143,6 +144,17 @@ bool rychkov::MainProcessor::diff(ParserContext& context)
     context.in >> name;
     files.insert(name);
   }
+  if (files.empty())
+  {
+    unpack_all();
+  }
+  for (const std::string& name: files)
+  {
+    if (parsed_.find(name) != parsed_.end())
+    {
+      unpacked(name);
+    }
+  }
   DiffVisitor visitor = for_each(parsed_.begin(), parsed_.end(), DiffVisitor{std::move(files)});
   bool empty = true;
   using MacroIter = decltype(visitor.macros)::const_iterator;
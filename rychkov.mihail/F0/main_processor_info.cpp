@@ -34,7 +34,7 @@ bool rychkov::MainProcessor::tree(ParserContext& context)
   {
     return false;
   }
-  const CParser& parser = *parsed_.at(filename).preproc.next->next;
+  const CParser& parser = *unpacked(filename).preproc.next->next;
   if (!eol(context.in))
   {
     return false;
@@ -48,6 +48,7 @@ bool rychkov::MainProcessor::external(ParserContext& context)
   {
     return false;
   }
+  unpack_all();
   ContentPrinter printer{context.out};
   bool no_external = true;
   for (const std::pair< const std::string, ParseCell >& cell: parsed_)
@@ -78,7 +79,7 @@ bool rychkov::MainProcessor::exposition(ParserContext& context)
   {
     return false;
   }
-  const CParser& parser = *parsed_.at(filename).preproc.next->next;
+  const CParser& parser = *unpacked(filename).preproc.next->next;
   if (!eol(context.in))
   {
     return false;
@@ -112,7 +113,7 @@ bool rychkov::MainProcessor::defines(ParserContext& context)
   {
     return false;
   }
-  const Preprocessor& preproc = parsed_.at(filename).preproc;
+  const Preprocessor& preproc = unpacked(filename).preproc;
   if (!eol(context.in))
   {
     return false;
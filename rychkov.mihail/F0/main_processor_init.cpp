@@ -5,10 +5,40 @@
 #include <utility>
 #include <stdexcept>
 #include <algorithm>
+#include <atomic>
+#include <thread>
+#include <functional>
 #include <algorithm.hpp>
+#include "header_cache.hpp"
 
 using namespace std::literals::string_literals;
 
+namespace
+{
+  void run_jobs(std::vector< rychkov::ParseJob >& jobs, std::atomic< size_t >& next_job)
+  {
+    for (size_t i = next_job++; i < jobs.size(); i = next_job++)
+    {
+      rychkov::ParseJob& job = jobs[i];
+      try
+      {
+        std::ifstream in(job.file);
+        job.opened = static_cast< bool >(in);
+        job.parsed = job.cell->parse(in);
+      }
+      catch (...)
+      {
+        job.error = std::current_exception();
+      }
+      if (job.error || !job.parsed)
+      {
+        // results are consumed in order and stop at the first failure
+        next_job = jobs.size();
+      }
+    }
+  }
+}
+
 bool rychkov::MainProcessor::init(ParserContext& context, int argc, char** argv)
 {
   bool sources = false;
@@ -86,9 +116,17 @@ bool rychkov::MainProcessor::init(ParserContext& context, int argc, char** argv)
   std::sort(files.begin(), files.end());
   files.erase(rychkov::unique(files.begin(), files.end()), files.end());
 
+  std::vector< ParseJob > jobs(files.size());
+  for (size_t i = 0; i < files.size(); i++)
+  {
+    jobs[i].file = files[i];
+  }
+  parse_all(jobs);
+
   std::string ext = (last_stage_ == PREPROCESSOR ? ".i" : (last_stage_ == LEXER ? ".lex" : ".json"));
-  for (const std::string& filename: files)
+  for (ParseJob& job: jobs)
   {
+    const std::string& filename = job.file;
     std::ostream* output = &context.out;
     std::ofstream ostream;
     std::string output_filename;
@@ -111,9 +149,20 @@ bool rychkov::MainProcessor::init(ParserContext& context, int argc, char** argv)
       }
       output = &ostream;
     }
-    CParseContext parse_context{*output, context.err, filename};
     context.out << "<--PARSE: \"" << filename << "\"-->\n";
-    if (!parse(parse_context, true))
+    if (!job.opened)
+    {
+      throw std::invalid_argument("failed to open source file: \"" + filename + '"');
+    }
+    *output << job.out.str();
+    context.err << job.err.str();
+    if (job.error)
+    {
+      std::rethrow_exception(job.error);
+    }
+    parsed_.erase(filename);
+    parsed_.emplace(filename, std::move(*job.cell));
+    if (!job.parsed)
     {
       throw std::runtime_error("failed to parse file \"" + filename + "\" - stopping");
     }
@@ -127,22 +176,36 @@ bool rychkov::MainProcessor::init(ParserContext& context, int argc, char** argv)
   return !out;
 }
 
-bool rychkov::MainProcessor::parse(CParseContext file_context, bool overwrite)
+void rychkov::MainProcessor::parse_all(std::vector< ParseJob >& jobs) const
 {
-  if (overwrite)
+  std::shared_ptr< HeaderCache > header_cache = std::make_shared< HeaderCache >();
+  for (ParseJob& job: jobs)
   {
-    parsed_.erase(file_context.file);
+    job.cell.reset(new ParseCell{{job.out, job.err, job.file}, last_stage_, include_dirs_});
+    job.cell->preproc.header_cache = header_cache;
   }
-  std::pair< decltype(parsed_)::iterator, bool > cell = parsed_.emplace(file_context.file,
-    ParseCell{file_context, last_stage_, include_dirs_});
-  if (!cell.second)
+  size_t nworkers = std::min< size_t >(std::max(std::thread::hardware_concurrency(), 1U), jobs.size());
+  std::atomic< size_t > next_job{0};
+  std::vector< std::thread > workers;
+  try
   {
-    return true;
+    for (size_t i = 1; i < nworkers; i++)
+    {
+      workers.emplace_back(run_jobs, std::ref(jobs), std::ref(next_job));
+    }
+  }
+  catch (...)
+  {
+    next_job = jobs.size();
+    for (std::thread& worker: workers)
+    {
+      worker.join();
+    }
+    throw;
   }
-  std::ifstream in(cell.first->first);
-  if (!in)
+  run_jobs(jobs, next_job);
+  for (std::thread& worker: workers)
   {
-    throw std::invalid_argument("failed to open source file: \"" + file_context.file + '"');
+    worker.join();
   }
-  return cell.first->second.parse(in);
 }
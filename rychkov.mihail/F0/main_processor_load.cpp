@@ -39,7 +39,7 @@ namespace rychkov
   };
 }
 
-bool rychkov::MainProcessor::load(std::ostream& out, std::ostream& err, std::string filename)
+bool rychkov::MainProcessor::import_json(std::ostream& out, std::ostream& err, std::string filename)
 {
   std::ifstream in(filename);
   if (!in)
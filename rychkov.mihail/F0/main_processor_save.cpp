@@ -32,7 +32,7 @@ namespace rychkov
   };
 }
 
-bool rychkov::MainProcessor::save(std::ostream& err, std::string filename) const
+bool rychkov::MainProcessor::export_json(std::ostream& err, std::string filename) const
 {
   std::ofstream out(filename);
   if (!out)
@@ -0,0 +1,896 @@
+#include "main_processor.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include <map.hpp>
+#include "lexer.hpp"
+
+namespace rychkov
+{
+  namespace snapshot
+  {
+    constexpr char magic[8] = {'R', 'Y', 'C', 'S', 'N', 'A', 'P', '2'};
+    constexpr uint32_t npos = -1;
+
+    // all offsets are absolute positions in the file, integers are stored in host byte order
+    struct Header
+    {
+      char magic[8];
+      uint32_t nstrings, ntypes, nfiles, reserved;
+      uint64_t strings, types, files;
+    };
+  }
+
+  class MappedFile
+  {
+  public:
+    MappedFile(const std::string& filename);
+    MappedFile(const MappedFile&) = delete;
+    ~MappedFile();
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool is_open() const noexcept;
+    const char* data() const noexcept;
+    size_t size() const noexcept;
+
+  private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool opened_ = false;
+#ifdef _WIN32
+    std::string buffer_;
+#endif
+  };
+
+  struct SnapshotWriter
+  {
+    std::string strings_data;
+    std::vector< uint64_t > strings;
+    Map< std::string, uint32_t > string_ids;
+    std::string types_data;
+    std::vector< uint64_t > types;
+    Map< std::string, uint32_t > type_ids;
+
+    template< class T >
+    static void put(std::string& out, T value);
+    uint32_t intern(const std::string& str);
+    uint32_t intern(const typing::Type& type);
+    std::string assemble(const std::vector< std::string >& files) const;
+
+    void write(std::string& out, const std::string& str);
+    void write(std::string& out, const Macro& macro);
+    void write(std::string& out, const typing::Type& type);
+    void write(std::string& out, const entities::Variable& var);
+    void write(std::string& out, const entities::Function& func);
+    void write(std::string& out, const entities::Struct& structure);
+    void write(std::string& out, const entities::Enum& structure);
+    void write(std::string& out, const entities::Union& structure);
+    void write(std::string& out, const entities::Alias& alias);
+    void write(std::string& out, const entities::Statement& statement);
+    void write(std::string& out, const entities::Declaration& decl);
+    void write(std::string& out, const entities::Literal& lit);
+    void write(std::string& out, const entities::CastOperation& cast);
+    void write(std::string& out, const entities::Body& body);
+    void write(std::string& out, const entities::Expression& expr);
+    void write(std::string& out, const DynMemWrapper< entities::Expression >& ptr);
+    template< class T, class C >
+    void write(std::string& out, const std::pair< T, C >& pair);
+    void write(std::string& out, size_t depth);
+    template< class Container >
+    void write_all(std::string& out, const Container& range);
+  };
+  struct SnapshotOperandWriter
+  {
+    SnapshotWriter& writer;
+    std::string& out;
+    template< class T >
+    void operator()(const T& value)
+    {
+      writer.write(out, value);
+    }
+  };
+
+  struct SnapshotReader
+  {
+    MappedFile file;
+    const char* begin;
+    const char* end;
+    snapshot::Header header;
+    std::vector< typing::Type > types;
+    std::vector< bool > decoded;
+
+    SnapshotReader(const std::string& filename);
+
+    bool is_snapshot() const noexcept;
+    void read_header();
+    void read_file(const char* pos, Preprocessor& preproc, std::string& cache);
+
+    const char* at(uint64_t offset, uint64_t length) const;
+    template< class T >
+    T get(const char*& pos) const;
+    std::string string(uint32_t id) const;
+    const typing::Type& type(uint32_t id);
+
+    std::string read_string(const char*& pos) const;
+    Macro read_macro(const char*& pos) const;
+    entities::Variable read_var(const char*& pos);
+    entities::Function read_func(const char*& pos);
+    entities::Struct read_struct(const char*& pos);
+    entities::Enum read_enum(const char*& pos);
+    entities::Union read_union(const char*& pos);
+    entities::Alias read_alias(const char*& pos);
+    entities::Statement read_statement(const char*& pos);
+    entities::Declaration read_decl(const char*& pos);
+    entities::Literal read_lit(const char*& pos);
+    entities::CastOperation read_cast(const char*& pos);
+    entities::Body read_body(const char*& pos);
+    entities::Expression read_expr(const char*& pos);
+    DynMemWrapper< entities::Expression > read_expr_ptr(const char*& pos);
+    entities::Expression::operand read_operand(const char*& pos);
+    static const Operator* find_operator(const std::string& token, Operator::Type type, bool right_align);
+  };
+}
+
+bool rychkov::MainProcessor::save(std::ostream& err, std::string filename)
+{
+  unpack_all();
+  std::string::size_type ext_p = filename.rfind(".json");
+  if ((ext_p != std::string::npos) && (ext_p + 5 == filename.length()))
+  {
+    return export_json(err, std::move(filename));
+  }
+  SnapshotWriter writer;
+  std::vector< std::string > files;
+  files.reserve(parsed_.size());
+  for (const std::pair< const std::string, ParseCell >& file: parsed_)
+  {
+    const Preprocessor& preproc = file.second.preproc;
+    const CParser& src = *preproc.next->next;
+    std::string out;
+    writer.write(out, file.first);
+    SnapshotWriter::put< uint8_t >(out, file.second.real_file);
+    writer.write(out, file.second.cache);
+    writer.write_all(out, preproc.macros);
+    writer.write_all(out, preproc.legacy_macros);
+    writer.write_all(out, src);
+    writer.write_all(out, src.aliases);
+    writer.write_all(out, src.variables);
+    writer.write_all(out, src.defined_functions);
+    writer.write_all(out, src.structs);
+    writer.write_all(out, src.unions);
+    writer.write_all(out, src.enums);
+    writer.write_all(out, src.base_types);
+    files.push_back(std::move(out));
+  }
+
+  std::ofstream out(filename, std::ios::binary);
+  if (!out)
+  {
+    err << "failed to open save file on write - \"" << filename << "\"\n";
+    return false;
+  }
+  out << writer.assemble(files);
+  return out.good();
+}
+bool rychkov::MainProcessor::load(std::ostream& out, std::ostream& err, std::string filename)
+{
+  std::shared_ptr< SnapshotReader > reader = std::make_shared< SnapshotReader >(filename);
+  if (!reader->file.is_open())
+  {
+    err << "failed to open save file on read - \"" << filename << "\"\n";
+    return false;
+  }
+  if (!reader->is_snapshot())
+  {
+    return import_json(out, err, std::move(filename));
+  }
+
+  reader->read_header();
+  Map< std::string, ParseCell > new_parsed;
+  size_t ngenerated = 0;
+  const char* offsets = reader->at(reader->header.files, (reader->header.nfiles + uint64_t{1}) * sizeof(uint64_t));
+  uint64_t to = reader->get< uint64_t >(offsets);
+  for (uint32_t i = 0; i < reader->header.nfiles; i++)
+  {
+    // records are decoded on first use, so only their bounds are checked here
+    uint64_t from = to;
+    to = reader->get< uint64_t >(offsets);
+    const char* pos = reader->at(from, to - from);
+    std::string name = reader->read_string(pos);
+    std::pair< decltype(new_parsed)::iterator, bool > cell_p = new_parsed.emplace(name,
+          ParseCell{{out, err, name}, last_stage_, include_dirs_});
+    if (!cell_p.second)
+    {
+      continue;
+    }
+    ParseCell& cell = cell_p.first->second;
+    out << "<--LOAD: \"" << name << "\"-->\n";
+    cell.real_file = reader->get< uint8_t >(pos) != 0;
+    ngenerated += !cell.real_file;
+    cell.snapshot = reader;
+    cell.snapshot_record = pos;
+  }
+  parsed_ = std::move(new_parsed);
+  generated_files = ngenerated;
+  return true;
+}
+void rychkov::MainProcessor::unpack(ParseCell& cell)
+{
+  if (cell.snapshot == nullptr)
+  {
+    return;
+  }
+  ParseCell result{cell.base_context, last_stage_, include_dirs_};
+  cell.snapshot->read_file(cell.snapshot_record, result.preproc, result.cache);
+  cell.preproc = std::move(result.preproc);
+  cell.cache = std::move(result.cache);
+  cell.snapshot = nullptr;
+  cell.snapshot_record = nullptr;
+}
+void rychkov::MainProcessor::unpack_all()
+{
+  for (std::pair< const std::string, ParseCell >& cell: parsed_)
+  {
+    unpack(cell.second);
+  }
+}
+rychkov::ParseCell& rychkov::MainProcessor::unpacked(const std::string& filename)
+{
+  ParseCell& cell = parsed_.at(filename);
+  unpack(cell);
+  return cell;
+}
+
+rychkov::MappedFile::MappedFile(const std::string& filename)
+{
+#ifndef _WIN32
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd == -1)
+  {
+    return;
+  }
+  struct stat info;
+  if ((::fstat(fd, &info) == 0) && S_ISREG(info.st_mode))
+  {
+    opened_ = true;
+    size_ = info.st_size;
+    if (size_ != 0)
+    {
+      void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr == MAP_FAILED)
+      {
+        opened_ = false;
+        size_ = 0;
+      }
+      else
+      {
+        data_ = static_cast< const char* >(addr);
+      }
+    }
+  }
+  ::close(fd);
+#else
+  std::ifstream in(filename, std::ios::binary);
+  if (!in)
+  {
+    return;
+  }
+  buffer_.assign(std::istreambuf_iterator< char >{in}, std::istreambuf_iterator< char >{});
+  if (in.bad())
+  {
+    return;
+  }
+  opened_ = true;
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+#endif
+}
+rychkov::MappedFile::~MappedFile()
+{
+#ifndef _WIN32
+  if (data_ != nullptr)
+  {
+    ::munmap(const_cast< char* >(data_), size_);
+  }
+#endif
+}
+bool rychkov::MappedFile::is_open() const noexcept
+{
+  return opened_;
+}
+const char* rychkov::MappedFile::data() const noexcept
+{
+  return data_;
+}
+size_t rychkov::MappedFile::size() const noexcept
+{
+  return size_;
+}
+
+template< class T >
+void rychkov::SnapshotWriter::put(std::string& out, T value)
+{
+  out.append(reinterpret_cast< const char* >(&value), sizeof(value));
+}
+uint32_t rychkov::SnapshotWriter::intern(const std::string& str)
+{
+  std::pair< decltype(string_ids)::iterator, bool > id_p = string_ids.emplace(str, strings.size());
+  if (id_p.second)
+  {
+    strings.push_back(strings_data.size());
+    strings_data += str;
+  }
+  return id_p.first->second;
+}
+uint32_t rychkov::SnapshotWriter::intern(const typing::Type& type)
+{
+  // children are interned first, so a record only refers to types with smaller ids
+  std::string record;
+  put< uint32_t >(record, intern(type.name));
+  put< uint8_t >(record, type.category);
+  put< uint8_t >(record, type.is_const | (type.is_volatile << 1) | (type.is_signed << 2)
+        | (type.is_unsigned << 3) | (type.array_has_length << 4));
+  put< uint8_t >(record, type.length_category);
+  put< uint32_t >(record, type.base == nullptr ? snapshot::npos : intern(*type.base));
+  put< uint64_t >(record, type.array_length);
+  put< uint32_t >(record, type.function_parameters.size());
+  for (const typing::Type& parameter: type.function_parameters)
+  {
+    put< uint32_t >(record, intern(parameter));
+  }
+  std::pair< decltype(type_ids)::iterator, bool > id_p = type_ids.emplace(record, types.size());
+  if (id_p.second)
+  {
+    types.push_back(types_data.size());
+    types_data += record;
+  }
+  return id_p.first->second;
+}
+std::string rychkov::SnapshotWriter::assemble(const std::vector< std::string >& files) const
+{
+  snapshot::Header header{};
+  std::memcpy(header.magic, snapshot::magic, sizeof(snapshot::magic));
+  header.nstrings = strings.size();
+  header.ntypes = types.size();
+  header.nfiles = files.size();
+  header.strings = sizeof(header);
+  header.types = header.strings + (strings.size() + 1) * sizeof(uint64_t) + strings_data.size();
+  header.files = header.types + types.size() * sizeof(uint64_t) + types_data.size();
+
+  std::string result;
+  put(result, header);
+  uint64_t strings_base = header.strings + (strings.size() + 1) * sizeof(uint64_t);
+  for (uint64_t offset: strings)
+  {
+    put< uint64_t >(result, strings_base + offset);
+  }
+  put< uint64_t >(result, strings_base + strings_data.size());
+  result += strings_data;
+  uint64_t types_base = header.types + types.size() * sizeof(uint64_t);
+  for (uint64_t offset: types)
+  {
+    put< uint64_t >(result, types_base + offset);
+  }
+  result += types_data;
+  uint64_t file_offset = header.files + (files.size() + 1) * sizeof(uint64_t);
+  for (const std::string& file: files)
+  {
+    put< uint64_t >(result, file_offset);
+    file_offset += file.size();
+  }
+  put< uint64_t >(result, file_offset);
+  for (const std::string& file: files)
+  {
+    result += file;
+  }
+  return result;
+}
+void rychkov::SnapshotWriter::write(std::string& out, const std::string& str)
+{
+  put< uint32_t >(out, intern(str));
+}
+void rychkov::SnapshotWriter::write(std::string& out, const Macro& macro)
+{
+  write(out, macro.name);
+  write(out, macro.body);
+  put< uint8_t >(out, macro.func_style);
+  write_all(out, macro.parameters);
+}
+void rychkov::SnapshotWriter::write(std::string& out, const typing::Type& type)
+{
+  put< uint32_t >(out, intern(type));
+}
+void rychkov::SnapshotWriter::write(std::string& out, const entities::Variable& var)
+{
+  write(out, var.type);
+  write(out, var.name);
+}
+void rychkov::SnapshotWriter::write(std::string& out, const entities::Function& func)
+{
+  write(out, func.type);
+  write(out, func.name);
+  write_all(out, func.parameters);
+}
+void rychkov::SnapshotWriter::write(std::string& out, const entities::Struct& structure)
+{
+  write(out, structure.name);
+  write_all(out, structure.fields);
+}
+void rychkov::SnapshotWriter::write(std::string& out, const entities::Enum& structure)
+{
+  write(out, structure.name);
+  put< uint32_t >(out, structure.fields.size());
+  for (const std::pair< const std::string, int >& field: structure.fields)
+  {
+    write(out, field.first);
+    put< int32_t >(out, field.second);
+  }
+}
+void rychkov::SnapshotWriter::write(std::string& out, const entities::Union& structure)
+{
+  write(out, structure.name);
+  write_all(out, structure.fields);
+}
+void rychkov::SnapshotWriter::write(std::string& out, const entities::Alias& alias)
+{
+  write(out, alias.type);
+  write(out, alias.name);
+}
+void rychkov::SnapshotWriter::write(std::string& out, const entities::Statement& statement)
+{
+  put< uint8_t >(out, statement.type);
+  write_all(out, statement.conditions);
+}
+void rychkov::SnapshotWriter::write(std::string& out, const entities::Declaration& decl)
+{
+  put< uint8_t >(out, decl.data.index());
+  visit(SnapshotOperandWriter{*this, out}, decl.data);
+  write(out, decl.value);
+  put< uint8_t >(out, decl.scope);
+}
+void rychkov::SnapshotWriter::write(std::string& out, const entities::Literal& lit)
+{
+  write(out, lit.literal);
+  write(out, lit.suffix);
+  put< uint8_t >(out, lit.type);
+  write(out, lit.result_type);
+}
+void rychkov::SnapshotWriter::write(std::string& out, const entities::CastOperation& cast)
+{
+  write(out, cast.to);
+  put< uint8_t >(out, cast.is_explicit);
+  write(out, cast.expr);
+}
+void rychkov::SnapshotWriter::write(std::string& out, const entities::Body& body)
+{
+  write_all(out, body.data);
+}
+void rychkov::SnapshotWriter::write(std::string& out, const entities::Expression& expr)
+{
+  put< uint8_t >(out, expr.operation != nullptr);
+  if (expr.operation != nullptr)
+  {
+    write(out, expr.operation->token);
+    put< int8_t >(out, expr.operation->type);
+    put< uint8_t >(out, expr.operation->right_align);
+  }
+  write(out, expr.result_type);
+  put< uint32_t >(out, expr.operands.size());
+  for (const entities::Expression::operand& operand: expr.operands)
+  {
+    put< uint8_t >(out, operand.index());
+    visit(SnapshotOperandWriter{*this, out}, operand);
+  }
+}
+void rychkov::SnapshotWriter::write(std::string& out, const DynMemWrapper< entities::Expression >& ptr)
+{
+  put< uint8_t >(out, ptr != nullptr);
+  if (ptr != nullptr)
+  {
+    write(out, *ptr);
+  }
+}
+template< class T, class C >
+void rychkov::SnapshotWriter::write(std::string& out, const std::pair< T, C >& pair)
+{
+  write(out, pair.first);
+  write(out, pair.second);
+}
+void rychkov::SnapshotWriter::write(std::string& out, size_t depth)
+{
+  put< uint64_t >(out, depth);
+}
+template< class Container >
+void rychkov::SnapshotWriter::write_all(std::string& out, const Container& range)
+{
+  put< uint32_t >(out, std::distance(range.begin(), range.end()));
+  for (const typename Container::value_type& value: range)
+  {
+    write(out, value);
+  }
+}
+
+rychkov::SnapshotReader::SnapshotReader(const std::string& filename):
+  file(filename),
+  begin(file.data()),
+  end(file.data() + file.size()),
+  header{}
+{}
+bool rychkov::SnapshotReader::is_snapshot() const noexcept
+{
+  return (file.size() >= sizeof(snapshot::magic))
+      && (std::memcmp(begin, snapshot::magic, sizeof(snapshot::magic)) == 0);
+}
+void rychkov::SnapshotReader::read_header()
+{
+  std::memcpy(&header, at(0, sizeof(header)), sizeof(header));
+  at(header.strings, (header.nstrings + uint64_t{1}) * sizeof(uint64_t));
+  at(header.types, header.ntypes * uint64_t{sizeof(uint64_t)});
+  types.resize(header.ntypes);
+  decoded.resize(header.ntypes);
+}
+void rychkov::SnapshotReader::read_file(const char* pos, Preprocessor& preproc, std::string& cache)
+{
+  cache = read_string(pos);
+  for (uint32_t n = get< uint32_t >(pos); n > 0; n--)
+  {
+    preproc.macros.insert(read_macro(pos));
+  }
+  for (uint32_t n = get< uint32_t >(pos); n > 0; n--)
+  {
+    preproc.legacy_macros.insert(read_macro(pos));
+  }
+  CParser& parser = *preproc.next->next;
+  parser.prepare_to_rewrite();
+  for (uint32_t n = get< uint32_t >(pos); n > 0; n--)
+  {
+    parser.push_back(read_expr(pos));
+  }
+  for (uint32_t n = get< uint32_t >(pos); n > 0; n--)
+  {
+    parser.aliases.insert(read_alias(pos));
+  }
+  for (uint32_t n = get< uint32_t >(pos); n > 0; n--)
+  {
+    entities::Variable var = read_var(pos);
+    parser.variables.insert({std::move(var), get< uint64_t >(pos)});
+  }
+  for (uint32_t n = get< uint32_t >(pos); n > 0; n--)
+  {
+    parser.defined_functions.insert(read_var(pos));
+  }
+  for (uint32_t n = get< uint32_t >(pos); n > 0; n--)
+  {
+    entities::Struct structure = read_struct(pos);
+    parser.structs.insert({std::move(structure), get< uint64_t >(pos)});
+  }
+  for (uint32_t n = get< uint32_t >(pos); n > 0; n--)
+  {
+    entities::Union structure = read_union(pos);
+    parser.unions.insert({std::move(structure), get< uint64_t >(pos)});
+  }
+  for (uint32_t n = get< uint32_t >(pos); n > 0; n--)
+  {
+    entities::Enum structure = read_enum(pos);
+    parser.enums.insert({std::move(structure), get< uint64_t >(pos)});
+  }
+  parser.base_types.clear();
+  for (uint32_t n = get< uint32_t >(pos); n > 0; n--)
+  {
+    typing::Type type = this->type(get< uint32_t >(pos));
+    parser.base_types.insert({std::move(type), get< uint64_t >(pos)});
+  }
+}
+const char* rychkov::SnapshotReader::at(uint64_t offset, uint64_t length) const
+{
+  uint64_t size = end - begin;
+  if ((offset > size) || (length > size - offset))
+  {
+    throw std::invalid_argument{"corrupted snapshot"};
+  }
+  return begin + offset;
+}
+template< class T >
+T rychkov::SnapshotReader::get(const char*& pos) const
+{
+  T result;
+  std::memcpy(&result, at(pos - begin, sizeof(T)), sizeof(T));
+  pos += sizeof(T);
+  return result;
+}
+std::string rychkov::SnapshotReader::string(uint32_t id) const
+{
+  if (id >= header.nstrings)
+  {
+    throw std::invalid_argument{"corrupted snapshot"};
+  }
+  const char* offsets = begin + header.strings + id * uint64_t{sizeof(uint64_t)};
+  uint64_t from = get< uint64_t >(offsets);
+  uint64_t to = get< uint64_t >(offsets);
+  if (to < from)
+  {
+    throw std::invalid_argument{"corrupted snapshot"};
+  }
+  return {at(from, to - from), to - from};
+}
+const rychkov::typing::Type& rychkov::SnapshotReader::type(uint32_t id)
+{
+  if (id >= header.ntypes)
+  {
+    throw std::invalid_argument{"corrupted snapshot"};
+  }
+  if (decoded[id])
+  {
+    return types[id];
+  }
+  const char* pos = begin + header.types + id * uint64_t{sizeof(uint64_t)};
+  pos = at(get< uint64_t >(pos), 0);
+  typing::Type result;
+  result.name = string(get< uint32_t >(pos));
+  result.category = static_cast< typing::Category >(get< uint8_t >(pos));
+  uint8_t flags = get< uint8_t >(pos);
+  result.is_const = flags & 1;
+  result.is_volatile = flags & 2;
+  result.is_signed = flags & 4;
+  result.is_unsigned = flags & 8;
+  result.array_has_length = flags & 16;
+  result.length_category = static_cast< typing::LengthCategory >(get< uint8_t >(pos));
+  uint32_t base = get< uint32_t >(pos);
+  if ((base != snapshot::npos) && (base >= id))
+  {
+    throw std::invalid_argument{"corrupted snapshot"};
+  }
+  result.base = base == snapshot::npos ? nullptr : new typing::Type{type(base)};
+  result.array_length = get< uint64_t >(pos);
+  uint32_t nparameters = get< uint32_t >(pos);
+  result.function_parameters.reserve(nparameters);
+  for (; nparameters > 0; nparameters--)
+  {
+    uint32_t parameter = get< uint32_t >(pos);
+    if (parameter >= id)
+    {
+      throw std::invalid_argument{"corrupted snapshot"};
+    }
+    result.function_parameters.push_back(type(parameter));
+  }
+  types[id] = std::move(result);
+  decoded[id] = true;
+  return types[id];
+}
+std::string rychkov::SnapshotReader::read_string(const char*& pos) const
+{
+  return string(get< uint32_t >(pos));
+}
+rychkov::Macro rychkov::SnapshotReader::read_macro(const char*& pos) const
+{
+  Macro result;
+  result.name = read_string(pos);
+  result.body = read_string(pos);
+  result.func_style = get< uint8_t >(pos) != 0;
+  uint32_t nparameters = get< uint32_t >(pos);
+  result.parameters.reserve(nparameters);
+  for (; nparameters > 0; nparameters--)
+  {
+    result.parameters.push_back(read_string(pos));
+  }
+  return result;
+}
+rychkov::entities::Variable rychkov::SnapshotReader::read_var(const char*& pos)
+{
+  entities::Variable result;
+  result.type = type(get< uint32_t >(pos));
+  result.name = read_string(pos);
+  return result;
+}
+rychkov::entities::Function rychkov::SnapshotReader::read_func(const char*& pos)
+{
+  entities::Function result;
+  result.type = type(get< uint32_t >(pos));
+  result.name = read_string(pos);
+  uint32_t nparameters = get< uint32_t >(pos);
+  result.parameters.reserve(nparameters);
+  for (; nparameters > 0; nparameters--)
+  {
+    result.parameters.push_back(read_string(pos));
+  }
+  return result;
+}
+rychkov::entities::Struct rychkov::SnapshotReader::read_struct(const char*& pos)
+{
+  entities::Struct result{read_string(pos)};
+  for (uint32_t n = get< uint32_t >(pos); n > 0; n--)
+  {
+    result.fields.insert(read_var(pos));
+  }
+  return result;
+}
+rychkov::entities::Enum rychkov::SnapshotReader::read_enum(const char*& pos)
+{
+  entities::Enum result{read_string(pos)};
+  for (uint32_t n = get< uint32_t >(pos); n > 0; n--)
+  {
+    std::string name = read_string(pos);
+    result.fields.emplace(std::move(name), get< int32_t >(pos));
+  }
+  return result;
+}
+rychkov::entities::Union rychkov::SnapshotReader::read_union(const char*& pos)
+{
+  entities::Union result{read_string(pos)};
+  for (uint32_t n = get< uint32_t >(pos); n > 0; n--)
+  {
+    result.fields.insert(read_var(pos));
+  }
+  return result;
+}
+rychkov::entities::Alias rychkov::SnapshotReader::read_alias(const char*& pos)
+{
+  entities::Alias result;
+  result.type = type(get< uint32_t >(pos));
+  result.name = read_string(pos);
+  return result;
+}
+rychkov::entities::Statement rychkov::SnapshotReader::read_statement(const char*& pos)
+{
+  entities::Statement result{static_cast< entities::Statement::Type >(get< uint8_t >(pos))};
+  if (result.type >= entities::Statement::TYPE_LAST)
+  {
+    throw std::invalid_argument{"wrong statement type"};
+  }
+  uint32_t nconditions = get< uint32_t >(pos);
+  result.conditions.reserve(nconditions);
+  for (; nconditions > 0; nconditions--)
+  {
+    result.conditions.push_back(read_expr(pos));
+  }
+  return result;
+}
+rychkov::entities::Declaration rychkov::SnapshotReader::read_decl(const char*& pos)
+{
+  entities::Declaration result;
+  switch (get< uint8_t >(pos))
+  {
+  case 0:
+    result.data = read_var(pos);
+    break;
+  case 1:
+    result.data = read_struct(pos);
+    break;
+  case 2:
+    result.data = read_enum(pos);
+    break;
+  case 3:
+    result.data = read_union(pos);
+    break;
+  case 4:
+    result.data = read_alias(pos);
+    break;
+  case 5:
+    result.data = read_func(pos);
+    break;
+  case 6:
+    result.data = read_statement(pos);
+    break;
+  default:
+    throw std::invalid_argument{"unknown declared"};
+  }
+  result.value = read_expr_ptr(pos);
+  result.scope = static_cast< entities::ScopeType >(get< uint8_t >(pos));
+  if (result.scope > entities::UNSPECIFIED)
+  {
+    throw std::invalid_argument{"wrong scope type"};
+  }
+  return result;
+}
+rychkov::entities::Literal rychkov::SnapshotReader::read_lit(const char*& pos)
+{
+  entities::Literal result;
+  result.literal = read_string(pos);
+  result.suffix = read_string(pos);
+  result.type = static_cast< entities::Literal::Type >(get< uint8_t >(pos));
+  if (result.type > entities::Literal::Number)
+  {
+    throw std::invalid_argument{"wrong literal type"};
+  }
+  result.result_type = type(get< uint32_t >(pos));
+  return result;
+}
+rychkov::entities::CastOperation rychkov::SnapshotReader::read_cast(const char*& pos)
+{
+  entities::CastOperation result;
+  result.to = type(get< uint32_t >(pos));
+  result.is_explicit = get< uint8_t >(pos) != 0;
+  result.expr = read_expr_ptr(pos);
+  return result;
+}
+rychkov::entities::Body rychkov::SnapshotReader::read_body(const char*& pos)
+{
+  entities::Body result;
+  uint32_t nexpressions = get< uint32_t >(pos);
+  result.data.clear();
+  result.data.reserve(nexpressions);
+  for (; nexpressions > 0; nexpressions--)
+  {
+    result.data.push_back(read_expr(pos));
+  }
+  return result;
+}
+rychkov::entities::Expression rychkov::SnapshotReader::read_expr(const char*& pos)
+{
+  entities::Expression result;
+  if (get< uint8_t >(pos) != 0)
+  {
+    std::string token = read_string(pos);
+    Operator::Type oper_type = static_cast< Operator::Type >(get< int8_t >(pos));
+    result.operation = find_operator(token, oper_type, get< uint8_t >(pos) != 0);
+  }
+  result.result_type = type(get< uint32_t >(pos));
+  uint32_t noperands = get< uint32_t >(pos);
+  result.operands.reserve(noperands);
+  for (; noperands > 0; noperands--)
+  {
+    result.operands.push_back(read_operand(pos));
+  }
+  return result;
+}
+rychkov::DynMemWrapper< rychkov::entities::Expression > rychkov::SnapshotReader::read_expr_ptr(const char*& pos)
+{
+  if (get< uint8_t >(pos) == 0)
+  {
+    return nullptr;
+  }
+  return new entities::Expression{read_expr(pos)};
+}
+rychkov::entities::Expression::operand rychkov::SnapshotReader::read_operand(const char*& pos)
+{
+  switch (get< uint8_t >(pos))
+  {
+  case 0:
+    return read_expr_ptr(pos);
+  case 1:
+    return read_var(pos);
+  case 2:
+    return read_decl(pos);
+  case 3:
+    return read_lit(pos);
+  case 4:
+    return read_cast(pos);
+  case 5:
+    return read_body(pos);
+  default:
+    throw std::invalid_argument{"unknown expression operand"};
+  }
+}
+const rychkov::Operator* rychkov::SnapshotReader::find_operator(const std::string& token, Operator::Type type,
+    bool right_align)
+{
+  decltype(Lexer::cases)::const_iterator cases = Lexer::cases.find(token);
+  if (cases != Lexer::cases.end())
+  {
+    for (const Operator& i: *cases)
+    {
+      if ((i.right_align == right_align) && (i.type == type))
+      {
+        return &i;
+      }
+    }
+  }
+  for (const Operator* special: {&CParser::parentheses, &CParser::brackets, &CParser::comma, &CParser::inline_if})
+  {
+    if ((special->token == token) && (special->type == type) && (special->right_align == right_align))
+    {
+      return special;
+    }
+  }
+  throw std::invalid_argument{"unknown operator"};
+}
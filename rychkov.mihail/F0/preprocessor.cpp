@@ -5,6 +5,7 @@
 #include <cctype>
 #include <utility>
 #include "lexer.hpp"
+#include "header_cache.hpp"
 
 rychkov::Preprocessor::Preprocessor():
   next{nullptr}
@@ -47,14 +48,44 @@ void rychkov::Preprocessor::flush(CParseContext& context, char c)
   }
   else if (!skip_all())
   {
-    if (next == nullptr)
-    {
-      context.out << c;
-    }
-    else
-    {
-      next->append(context, c);
-    }
+    emit(context, c);
+  }
+}
+void rychkov::Preprocessor::emit(CParseContext& context, char c)
+{
+  for (HeaderRecord* record: recorders_)
+  {
+    record->append(context, line_epoch_, NO_STATE, std::string(1, c));
+  }
+  if (next == nullptr)
+  {
+    context.out << c;
+  }
+  else
+  {
+    next->append(context, c);
+  }
+}
+void rychkov::Preprocessor::emit(CParseContext& context, State kind, std::string token)
+{
+  for (HeaderRecord* record: recorders_)
+  {
+    record->append(context, line_epoch_, kind, token);
+  }
+  switch (kind)
+  {
+  case rychkov::Preprocessor::STRING_LITERAL:
+    next->append_string_literal(context, std::move(token));
+    break;
+  case rychkov::Preprocessor::CHAR_LITERAL:
+    next->append_char_literal(context, std::move(token));
+    break;
+  case rychkov::Preprocessor::NAME:
+    next->append_name(context, std::move(token));
+    break;
+  default:
+    next->append_number(context, std::move(token));
+    break;
   }
 }
 void rychkov::Preprocessor::flush_buf(CParseContext& context)
@@ -93,7 +124,7 @@ void rychkov::Preprocessor::flush_buf(CParseContext& context)
     {
       if (state_ == NAME)
       {
-        decltype(macros)::iterator macro_p = macros.find(buf_);
+        decltype(macros)::iterator macro_p = find_macro(buf_);
         if (macro_p != macros.end())
         {
           if (macro_p->func_style)
@@ -134,16 +165,10 @@ void rychkov::Preprocessor::flush_buf(CParseContext& context)
           switch (prev)
           {
           case rychkov::Preprocessor::STRING_LITERAL:
-            next->append_string_literal(context, buf_);
-            break;
           case rychkov::Preprocessor::CHAR_LITERAL:
-            next->append_char_literal(context, buf_);
-            break;
           case rychkov::Preprocessor::NAME:
-            next->append_name(context, buf_);
-            break;
           case rychkov::Preprocessor::NUMBER:
-            next->append_number(context, buf_);
+            emit(context, prev, buf_);
             break;
           default:
             for (char c: buf_)
@@ -185,11 +210,8 @@ void rychkov::Preprocessor::parse(CParseContext& context, std::istream& in, bool
     not_first_line = true;
     context.symbol = 0;
     std::getline(in, context.last_line);
-    for (char c: context.last_line)
-    {
-      append(context, c);
-      context.symbol++;
-    }
+    line_epoch_++;
+    scan(context, context.last_line.data(), context.last_line.data() + context.last_line.length());
   }
   if (need_flush)
   {
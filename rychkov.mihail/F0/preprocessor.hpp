@@ -17,13 +17,17 @@
 
 namespace rychkov
 {
+  class HeaderCache;
   class Preprocessor
   {
   public:
+    struct HeaderRecord;
+
     std::vector< std::string > include_paths;
     std::unique_ptr< Lexer > next;
     Set< Macro, NameCompare > macros;
     MultiSet< Macro, NameCompare > legacy_macros;
+    std::shared_ptr< HeaderCache > header_cache;
 
     Preprocessor();
     Preprocessor(std::unique_ptr< Lexer > lexer, std::vector< std::string > search_dirs);
@@ -54,6 +58,15 @@ namespace rychkov
       ELSE_BODY,
       SKIP_ELSE
     };
+    struct ScanState
+    {
+      char prev;
+      bool screened;
+      bool empty_line;
+      State state;
+      State prev_state;
+      size_t parentheses_depth;
+    };
 
     Map< std::string, void(Preprocessor::*)(std::istream&, CParseContext&) > directives_ = {
           {"include", &rychkov::Preprocessor::include},
@@ -78,11 +91,27 @@ namespace rychkov
 
     std::string buf_;
     rychkov::Stack< IfStage > conditional_pairs_;
+    std::vector< HeaderRecord* > recorders_;
+    size_t line_epoch_ = 0;
 
     static void remove_whitespaces(std::string& str);
     bool skip_all() const noexcept;
     void flush_buf(CParseContext& context);
     void expanse_macro(CParseContext& context);
+    void emit(CParseContext& context, char c);
+    void emit(CParseContext& context, State kind, std::string token);
+    const char* consume_run(const char* begin, const char* end);
+    void scan(CParseContext& context, const char* begin, const char* end);
+
+    decltype(macros)::iterator find_macro(const std::string& name);
+    void define_macro(Macro macro);
+    void undef_macro(const std::string& name);
+
+    ScanState scan_state() const noexcept;
+    bool resumable() const noexcept;
+    bool matches(const HeaderRecord& record) const;
+    bool replay_header(CParseContext& file_context);
+    void record_header(CParseContext& file_context, std::istream& in);
 
     void include(std::istream& in, CParseContext& context);
     void define(std::istream& in, CParseContext& context);
@@ -56,7 +56,10 @@ void rychkov::Preprocessor::include(std::istream& in, CParseContext& context)
     return;
   }
   CParseContext file_context = {context.out, context.err, filename, &context};
-  parse(file_context, file, false);
+  if (!replay_header(file_context))
+  {
+    record_header(file_context, file);
+  }
   context.nerrors += file_context.nerrors;
 }
 void rychkov::Preprocessor::define(std::istream& in, CParseContext& context)
@@ -103,8 +106,7 @@ void rychkov::Preprocessor::define(std::istream& in, CParseContext& context)
   }
   std::getline(in >> std::ws, macro.body);
   remove_whitespaces(macro.body);
-  macros.erase(macro);
-  macros.insert(std::move(macro));
+  define_macro(std::move(macro));
 }
 void rychkov::Preprocessor::pragma(std::istream&, CParseContext& context)
 {
@@ -115,12 +117,7 @@ void rychkov::Preprocessor::undef(std::istream& in, CParseContext& context)
   std::string name;
   if (eol(in >> std::ws >> name) && !name.empty())
   {
-    decltype(macros)::iterator temp = macros.find(name);
-    if (temp != macros.end())
-    {
-      legacy_macros.insert(*temp);
-      macros.erase(temp);
-    }
+    undef_macro(name);
     return;
   }
   log(context, "wrong #undef format");
@@ -133,7 +130,7 @@ void rychkov::Preprocessor::ifdef(std::istream& in, CParseContext& context)
     log(context, "wrong macro name format");
     return;
   }
-  conditional_pairs_.push(macros.find(name) == macros.end() ? WAIT_ELSE : IF_BODY);
+  conditional_pairs_.push(find_macro(name) == macros.end() ? WAIT_ELSE : IF_BODY);
 }
 void rychkov::Preprocessor::ifndef(std::istream& in, CParseContext& context)
 {
@@ -143,7 +140,7 @@ void rychkov::Preprocessor::ifndef(std::istream& in, CParseContext& context)
     log(context, "wrong macro name format");
     return;
   }
-  conditional_pairs_.push(macros.find(name) != macros.end() ? WAIT_ELSE : IF_BODY);
+  conditional_pairs_.push(find_macro(name) != macros.end() ? WAIT_ELSE : IF_BODY);
 }
 void rychkov::Preprocessor::else_cmd(std::istream& in, CParseContext& context)
 {
@@ -0,0 +1,246 @@
+#include "preprocessor.hpp"
+
+#include <deque>
+#include <algorithm>
+#include <utility>
+#include "header_cache.hpp"
+
+namespace
+{
+  bool same_macro(const rychkov::Macro& lhs, const rychkov::Macro& rhs)
+  {
+    return (lhs.name == rhs.name) && (lhs.body == rhs.body) && (lhs.func_style == rhs.func_style)
+        && (lhs.parameters == rhs.parameters);
+  }
+}
+
+decltype(rychkov::Preprocessor::macros)::iterator rychkov::Preprocessor::find_macro(const std::string& name)
+{
+  decltype(macros)::iterator result = macros.find(name);
+  for (HeaderRecord* record: recorders_)
+  {
+    record->depend(name, result == macros.end() ? nullptr : &*result);
+  }
+  return result;
+}
+void rychkov::Preprocessor::define_macro(Macro macro)
+{
+  for (HeaderRecord* record: recorders_)
+  {
+    record->change(true, macro);
+  }
+  macros.erase(macro);
+  macros.insert(std::move(macro));
+}
+void rychkov::Preprocessor::undef_macro(const std::string& name)
+{
+  decltype(macros)::iterator temp = find_macro(name);
+  if (temp != macros.end())
+  {
+    for (HeaderRecord* record: recorders_)
+    {
+      record->change(false, *temp);
+    }
+    legacy_macros.insert(*temp);
+    macros.erase(temp);
+  }
+}
+
+rychkov::Preprocessor::ScanState rychkov::Preprocessor::scan_state() const noexcept
+{
+  return {prev_, screened_, empty_line_, state_, prev_state_, parentheses_depth_};
+}
+bool rychkov::Preprocessor::resumable() const noexcept
+{
+  return buf_.empty() && (expansion_ == nullptr) && expansion_list_.empty();
+}
+bool rychkov::Preprocessor::matches(const HeaderRecord& record) const
+{
+  const ScanState& entry = record.entry;
+  if ((prev_ != entry.prev) || (screened_ != entry.screened) || (empty_line_ != entry.empty_line)
+      || (state_ != entry.state) || (prev_state_ != entry.prev_state)
+      || (parentheses_depth_ != entry.parentheses_depth))
+  {
+    return false;
+  }
+  if (conditional_pairs_.size() != record.entry_conditions.size())
+  {
+    return false;
+  }
+  for (size_t i = 0; i < conditional_pairs_.size(); i++)
+  {
+    if (conditional_pairs_[i] != record.entry_conditions[i])
+    {
+      return false;
+    }
+  }
+  for (const std::string& name: record.absent_macros)
+  {
+    if (macros.contains(name))
+    {
+      return false;
+    }
+  }
+  for (const std::pair< const std::string, Macro >& dependency: record.present_macros)
+  {
+    decltype(macros)::const_iterator macro_p = macros.find(dependency.first);
+    if ((macro_p == macros.end()) || !same_macro(*macro_p, dependency.second))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool rychkov::Preprocessor::replay_header(CParseContext& file_context)
+{
+  if ((header_cache == nullptr) || !resumable())
+  {
+    return false;
+  }
+  std::vector< HeaderCache::record_pointer > candidates = header_cache->find(file_context.file);
+  const HeaderRecord* record = nullptr;
+  for (const HeaderCache::record_pointer& candidate: candidates)
+  {
+    if (matches(*candidate))
+    {
+      record = candidate.get();
+      break;
+    }
+  }
+  if (record == nullptr)
+  {
+    return false;
+  }
+
+  // enclosing headers being recorded must see the lookups this header made
+  if (!recorders_.empty())
+  {
+    for (const std::string& name: record->absent_macros)
+    {
+      find_macro(name);
+    }
+    for (const std::pair< const std::string, Macro >& dependency: record->present_macros)
+    {
+      find_macro(dependency.first);
+    }
+  }
+
+  // active[0] is the header itself, deeper frames live in contexts
+  std::vector< size_t > path;
+  std::vector< size_t > active;
+  std::deque< CParseContext > contexts;
+  for (const HeaderRecord::Token& token: record->tokens)
+  {
+    if (active.empty() || (active.back() != token.frame))
+    {
+      line_epoch_++;
+      path.clear();
+      for (size_t frame = token.frame; frame != HeaderRecord::npos; frame = record->frames[frame].parent)
+      {
+        path.push_back(frame);
+      }
+      std::reverse(path.begin(), path.end());
+      size_t common = 0;
+      while ((common < active.size()) && (common < path.size()) && (active[common] == path[common]))
+      {
+        common++;
+      }
+      for (; active.size() > common; active.pop_back())
+      {
+        if (!contexts.empty())
+        {
+          (contexts.size() == 1 ? file_context : contexts[contexts.size() - 2]).nerrors += contexts.back().nerrors;
+          contexts.pop_back();
+        }
+      }
+      for (size_t i = active.size(); i < path.size(); i++)
+      {
+        const HeaderRecord::Frame& frame = record->frames[path[i]];
+        if (i == 0)
+        {
+          file_context.line = frame.line;
+          file_context.symbol = frame.symbol;
+          file_context.last_line = frame.last_line;
+        }
+        else
+        {
+          CParseContext& base = contexts.empty() ? file_context : contexts.back();
+          contexts.push_back({base.out, base.err, frame.file, &base, frame.macro_expansion,
+                frame.line, frame.symbol, frame.last_line});
+        }
+        active.push_back(path[i]);
+      }
+    }
+    CParseContext& context = contexts.empty() ? file_context : contexts.back();
+    context.symbol = token.symbol;
+    if (token.kind != NO_STATE)
+    {
+      emit(context, token.kind, token.text);
+      continue;
+    }
+    for (char c: token.text)
+    {
+      emit(context, c);
+      context.symbol += token.advancing;
+    }
+  }
+  for (; !contexts.empty(); contexts.pop_back())
+  {
+    (contexts.size() == 1 ? file_context : contexts[contexts.size() - 2]).nerrors += contexts.back().nerrors;
+  }
+
+  for (const HeaderRecord::MacroChange& change: record->changes)
+  {
+    if (change.define)
+    {
+      define_macro(change.macro);
+    }
+    else
+    {
+      undef_macro(change.macro.name);
+    }
+  }
+  prev_ = record->exit.prev;
+  screened_ = record->exit.screened;
+  empty_line_ = record->exit.empty_line;
+  state_ = record->exit.state;
+  prev_state_ = record->exit.prev_state;
+  parentheses_depth_ = record->exit.parentheses_depth;
+  conditional_pairs_ = record->exit_conditions;
+  return true;
+}
+void rychkov::Preprocessor::record_header(CParseContext& file_context, std::istream& in)
+{
+  if ((header_cache == nullptr) || !resumable())
+  {
+    parse(file_context, in, false);
+    return;
+  }
+  std::shared_ptr< HeaderRecord > record = std::make_shared< HeaderRecord >();
+  record->entry = scan_state();
+  record->entry_conditions = conditional_pairs_;
+  record->root = &file_context;
+  recorders_.push_back(record.get());
+  try
+  {
+    parse(file_context, in, false);
+  }
+  catch (...)
+  {
+    recorders_.pop_back();
+    throw;
+  }
+  recorders_.pop_back();
+  if ((file_context.nerrors != 0) || !resumable())
+  {
+    return;
+  }
+  record->exit = scan_state();
+  record->exit_conditions = conditional_pairs_;
+  record->root = nullptr;
+  record->changed.clear();
+  record->last_path.clear();
+  record->last_context = nullptr;
+  header_cache->insert(file_context.file, std::move(record));
+}
@@ -1,8 +1,113 @@
 #include "preprocessor.hpp"
 
 #include <iostream>
+#include <cstring>
+#include <cctype>
 #include <utility>
 
+namespace
+{
+  enum CharClass: unsigned char
+  {
+    NAME_CHAR = 1,
+    NUMBER_CHAR = 2
+  };
+  struct CharTable
+  {
+    unsigned char flags[256];
+  };
+  constexpr CharTable make_char_table()
+  {
+    CharTable result{};
+    for (int c = 0; c < 256; c++)
+    {
+      bool alnum = ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) || ((c >= '0') && (c <= '9'));
+      if (alnum || (c == '_'))
+      {
+        result.flags[c] |= NAME_CHAR | NUMBER_CHAR;
+      }
+      if ((c == '.') || (c == '\''))
+      {
+        result.flags[c] |= NUMBER_CHAR;
+      }
+    }
+    return result;
+  }
+  constexpr CharTable char_table = make_char_table();
+
+  const char* skip_class(const char* begin, const char* end, CharClass mask)
+  {
+    for (; (begin != end) && (char_table.flags[static_cast< unsigned char >(*begin)] & mask); ++begin)
+    {}
+    return begin;
+  }
+  const char* find_char(const char* begin, const char* end, char c)
+  {
+    const void* found = std::memchr(begin, c, end - begin);
+    return found == nullptr ? end : static_cast< const char* >(found);
+  }
+  const char* find_any(const char* begin, const char* end, char lhs, char rhs)
+  {
+    return find_char(begin, find_char(begin, end, lhs), rhs);
+  }
+}
+
+void rychkov::Preprocessor::scan(CParseContext& context, const char* begin, const char* end)
+{
+  while (begin != end)
+  {
+    const char* run_end = consume_run(begin, end);
+    context.symbol += run_end - begin;
+    begin = run_end;
+    if (begin != end)
+    {
+      append(context, *begin++);
+      context.symbol++;
+    }
+  }
+}
+const char* rychkov::Preprocessor::consume_run(const char* begin, const char* end)
+{
+  // swallows the longest prefix that append would only accumulate or ignore, emitting nothing
+  const char* run_end = begin;
+  switch (state_)
+  {
+  case SINGLE_LINE_COMMENT:
+    if (find_char(begin, end, '\\') != end)
+    {
+      screened_ = true;
+    }
+    return end;
+  case MULTI_LINE_COMMENT:
+    run_end = screened_ ? find_char(begin, end, '/') : find_any(begin, end, '/', '\\');
+    if (run_end != begin)
+    {
+      prev_ = run_end[-1];
+    }
+    return run_end;
+  case STRING_LITERAL:
+  case CHAR_LITERAL:
+    if (screened_)
+    {
+      return begin;
+    }
+    run_end = find_any(begin, end, state_ == STRING_LITERAL ? '"' : '\'', '\\');
+    break;
+  case NAME:
+  case NUMBER:
+    if (screened_)
+    {
+      return begin;
+    }
+    run_end = skip_class(begin, end, state_ == NAME ? NAME_CHAR : NUMBER_CHAR);
+    break;
+  default:
+    return begin;
+  }
+  buf_.append(begin, run_end);
+  return run_end;
+}
+
 void rychkov::Preprocessor::append(CParseContext& context, char c)
 {
   if (screened_ && (c == '\n'))
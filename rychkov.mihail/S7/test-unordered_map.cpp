@@ -1,5 +1,6 @@
 #include <stdexcept>
 #include <iterator>
+#include <string>
 #include <boost/test/unit_test.hpp>
 #include <mem_checker.hpp>
 #include <unordered_map.hpp>
@@ -92,6 +93,31 @@ BOOST_AUTO_TEST_CASE(map_test)
   BOOST_CHECK_THROW(map.at(3), std::out_of_range);
   BOOST_CHECK_THROW(map.at(8), std::out_of_range);
 }
+BOOST_AUTO_TEST_CASE(string_hash_test)
+{
+  rychkov::UnorderedMap< std::string, int, rychkov::StringHash > map;
+  constexpr int input_size = 500;
+  const std::string prefix = "long key prefix shared by every vertex name ";
+  for (int i = 0; i < input_size; i++)
+  {
+    BOOST_TEST(map.emplace(prefix + std::to_string(i), i).second);
+  }
+  BOOST_TEST(!map.emplace(prefix + "7", 0).second);
+  for (int i = 0; i < input_size; i += 2)
+  {
+    BOOST_TEST(map.erase(prefix + std::to_string(i)) == 1);
+  }
+  map.rehash(map.bucket_count() * 3);
+  rychkov::UnorderedMap< std::string, int, rychkov::StringHash > copy = map;
+  for (int i = 0; i < input_size; i++)
+  {
+    BOOST_TEST(copy.contains(prefix + std::to_string(i)) == (i % 2 == 1));
+  }
+  BOOST_TEST(copy.size() == input_size / 2);
+  BOOST_TEST(copy.at((prefix + "7").c_str()) == 7);
+  BOOST_TEST(rychkov::StringHash{}("vertex") == rychkov::StringHash{}(std::string{"vertex"}));
+  BOOST_TEST(rychkov::StringHash{}("vertex") != rychkov::StringHash{}("vertey"));
+}
 BOOST_AUTO_TEST_CASE(traverse_stability_test)
 {
   struct Wrapper
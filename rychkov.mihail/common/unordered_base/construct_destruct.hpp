@@ -43,7 +43,13 @@ template< class K, class T, class H, class E, bool IsSet, bool IsMulti >
 rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::UnorderedBase(const UnorderedBase& rhs):
   UnorderedBase(rhs.capacity_, rhs.hash_, rhs.equal_)
 {
-  insert(rhs.begin(), rhs.end());
+  for (size_type i = 0; i < rhs.capacity_; i++)
+  {
+    if (rhs.data_[i].first != ~0ULL)
+    {
+      insert_hashed(rhs.data_[i].hash, rhs.data_[i].second);
+    }
+  }
 }
 template< class K, class T, class H, class E, bool IsSet, bool IsMulti >
 rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::UnorderedBase
@@ -2,6 +2,9 @@
 #define UNORDERED_BASE_DECLARATION_HPP
 
 #include <utility>
+#include <cstring>
+#include <cstdint>
+#include <string>
 
 #include <boost/hash2/fnv1a.hpp>
 #include <boost/hash2/hash_append.hpp>
@@ -34,6 +37,39 @@ namespace rychkov
       return boost::hash2::get_integral_result< size_t >(hasher);
     }
   };
+  struct StringHash
+  {
+    using is_transparent = void;
+    size_t operator()(const std::string& str) const noexcept
+    {
+      return (*this)(str.data(), str.length());
+    }
+    size_t operator()(const char* str) const noexcept
+    {
+      return (*this)(str, std::strlen(str));
+    }
+    size_t operator()(const char* data, size_t length) const noexcept
+    {
+      // consumes 8 bytes per step instead of fnv1a's single byte, the final mix spreads them over all bits
+      std::uint64_t result = 0x9e3779b97f4a7c15ULL ^ length;
+      std::uint64_t word = 0;
+      for (; length >= sizeof(word); data += sizeof(word), length -= sizeof(word))
+      {
+        std::memcpy(&word, data, sizeof(word));
+        result = ((result << 5) | (result >> 59)) ^ word;
+        result *= 0x517cc1b727220a95ULL;
+      }
+      word = 0;
+      std::memcpy(&word, data, length);
+      result = (((result << 5) | (result >> 59)) ^ word) * 0x517cc1b727220a95ULL;
+      result ^= result >> 33;
+      result *= 0xff51afd7ed558ccdULL;
+      result ^= result >> 33;
+      result *= 0xc4ceb9fe1a85ec53ULL;
+      result ^= result >> 33;
+      return result;
+    }
+  };
   namespace details
   {
     template< class R, class K1, class H, class E, class... Exclude >
@@ -188,9 +224,9 @@ namespace rychkov
         try_emplace(const_iterator hint, K1&& key, Args&&... args);
 
   private:
-    using stored_value = std::pair< size_type, value_type >;
+    using stored_value = details::UnorderedSlot< value_type >;
     using temp_value = std::conditional_t< IsSet, key_type, std::pair< key_type, mapped_type > >;
-    using temp_stored = std::pair< size_type, temp_value >;
+    using temp_stored = details::UnorderedSlot< temp_value >;
     static constexpr float default_max_factor = 0.5;
 
     size_type capacity_, size_;
@@ -210,11 +246,14 @@ namespace rychkov
     const_iterator find_impl(const K1& key) const;
 
     template< class K1 >
-    std::pair< const_iterator, bool > find_hint_pair(const K1& key) const;
+    std::pair< const_iterator, bool > find_hint_pair(const K1& key, size_type hash) const;
     template< class K1 >
-    std::pair< const_iterator, bool > correct_hint(const_iterator hint, const K1& key);
+    std::pair< const_iterator, bool > correct_hint(const_iterator hint, const K1& key, size_type hash);
     template< class... Args >
-    std::pair< iterator, bool > emplace_hint_impl(std::pair< const_iterator, bool > hint, Args&&... args);
+    std::pair< iterator, bool > emplace_hint_impl(std::pair< const_iterator, bool > hint, size_type hash,
+        Args&&... args);
+    template< class V >
+    void insert_hashed(size_type hash, V&& value);
 
     template< class V = value_type >
     static const key_type& get_key(const V& value);
@@ -7,6 +7,16 @@
 
 namespace rychkov
 {
+  namespace details
+  {
+    template< class V >
+    struct UnorderedSlot
+    {
+      size_t first;
+      size_t hash;
+      V second;
+    };
+  }
   template< class V, bool IsConst >
   class UnorderedBaseIterator
   {
@@ -85,7 +95,7 @@ namespace rychkov
     friend class UnorderedBase;
     friend class UnorderedBaseIterator< V, true >;
 
-    using stored_value = std::pair< size_t, value_type >;
+    using stored_value = details::UnorderedSlot< value_type >;
 
     stored_value* data_;
     stored_value* end_;
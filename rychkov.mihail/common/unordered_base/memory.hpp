@@ -56,17 +56,25 @@ void rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::rehash(size_type cnt)
   {
     if (data_[i].first != ~0ULL)
     {
-      temp.insert(std::move_if_noexcept(*reinterpret_cast< temp_value* >(std::addressof(data_[i].second))));
+      temp.insert_hashed(data_[i].hash,
+            std::move_if_noexcept(*reinterpret_cast< temp_value* >(std::addressof(data_[i].second))));
     }
   }
   swap(temp);
 }
+template< class K, class T, class H, class E, bool IsSet, bool IsMulti >
+template< class V >
+void rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::insert_hashed(size_type hash, V&& value)
+{
+  extend(size_ + 1);
+  emplace_hint_impl(find_hint_pair(get_key(value), hash), hash, std::forward< V >(value));
+}
 
 template< class K, class T, class H, class E, bool IsSet, bool IsMulti >
 template< class... Args >
 std::pair< typename rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::iterator, bool >
     rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::emplace_hint_impl
-    (std::pair< const_iterator, bool > hint, Args&&... args)
+    (std::pair< const_iterator, bool > hint, size_type hash, Args&&... args)
 {
   static_assert(is_nothrow_swappable_v< temp_value >, "");
   iterator result = {hint.first.data_, hint.first.end_};
@@ -75,8 +83,8 @@ std::pair< typename rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::iterat
     return {result, false};
   }
 
-  temp_stored temp = {0, {std::forward< Args >(args)...}};
-  size_type slot = hash_(get_key(temp.second)) % capacity_, id = hint.first.data_ - data_;
+  temp_stored temp = {0, hash, {std::forward< Args >(args)...}};
+  size_type slot = hash % capacity_, id = hint.first.data_ - data_;
   temp.first = (id >= slot ? id - slot : id + capacity_ - slot);
 
   while (hint.first.data_->first != ~0ULL)
@@ -90,6 +98,7 @@ std::pair< typename rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::iterat
   }
   new(reinterpret_cast< temp_value* >(std::addressof(hint.first.data_->second))) temp_value{std::move(temp.second)};
   hint.first.data_->first = temp.first;
+  hint.first.data_->hash = temp.hash;
   if ((cached_begin_ == nullptr) || (hint.first.data_ < cached_begin_))
   {
     cached_begin_ = hint.first.data_;
@@ -119,9 +128,13 @@ typename rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::iterator
 
     if ((pos.data_->first != expected_psl + shift) || (pos.data_->first == ~0ULL))
     {
-      new(std::addressof(erased->second)) value_type(std::move(reinterpret_cast< temp_stored* >(prev)->second));
-      prev->second.~value_type();
-      erased->first = expected_psl;
+      if (prev != erased)
+      {
+        new(std::addressof(erased->second)) value_type(std::move(reinterpret_cast< temp_stored* >(prev)->second));
+        prev->second.~value_type();
+        erased->first = expected_psl;
+        erased->hash = prev->hash;
+      }
       prev->first = ~0ULL;
 
       if ((pos.data_->first == ~0ULL) || (pos.data_->first == 0))
@@ -140,7 +153,7 @@ typename rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::iterator
 
       erased = prev;
       expected_psl = pos.data_->first - 1;
-      shift = 0;
+      shift = 1;
     }
     prev = pos.data_;
   }
@@ -9,13 +9,13 @@
 template< class K, class T, class H, class E, bool IsSet, bool IsMulti >
 template< class K1 >
 std::pair< typename rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::const_iterator, bool >
-    rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::find_hint_pair(const K1& key) const
+    rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::find_hint_pair(const K1& key, size_type hash) const
 {
-  size_type slot = hash_(key) % capacity_;
+  size_type slot = hash % capacity_;
   for (size_type i = 0; (data_[slot].first != ~0ULL) && (data_[slot].first >= i); i++,
         slot = (++slot < capacity_ ? slot : slot - capacity_))
   {
-    if ((data_[slot].first == i) && equal_(get_key(data_[slot].second), key))
+    if ((data_[slot].first == i) && (data_[slot].hash == hash) && equal_(get_key(data_[slot].second), key))
     {
       return {{data_ + slot, data_ + capacity_}, IsMulti};
     }
@@ -26,24 +26,25 @@ std::pair< typename rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::const_
 template< class K, class T, class H, class E, bool IsSet, bool IsMulti >
 template< class K1 >
 std::pair< typename rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::const_iterator, bool >
-    rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::correct_hint(const_iterator hint, const K1& key)
+    rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::correct_hint(const_iterator hint, const K1& key,
+      size_type hash)
 {
   if (extend(size_ + 1))
   {
-    return find_hint_pair(key);
+    return find_hint_pair(key, hash);
   }
   if (hint.data_ == hint.end_)
   {
     hint.data_--;
   }
-  size_type slot = hash_(key) % capacity_, psl = hint.data_ - data_;
+  size_type slot = hash % capacity_, psl = hint.data_ - data_;
   psl = (psl >= slot ? psl - slot : psl + capacity_ - slot);
   if ((hint.data_->first != ~0ULL) && (hint.data_->first >= psl))
   {
     for (; (hint.data_->first != ~0ULL) && (hint.data_->first >= psl); psl++,
           hint.data_ = (++hint.data_ == hint.end_ ? data_ : hint.data_))
     {
-      if ((hint.data_->first == psl) && equal_(get_key(hint.data_->second), key))
+      if ((hint.data_->first == psl) && (hint.data_->hash == hash) && equal_(get_key(hint.data_->second), key))
       {
         return {hint, IsMulti};
       }
@@ -56,7 +57,7 @@ std::pair< typename rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::const_
     hint.data_ = (hint.data_ == data_ ? hint.end_ - 1 : hint.data_ - 1);
     --psl;
     prev = ((hint.data_->first < psl) || (hint.data_->first == ~0ULL) ? hint.data_ : prev);
-    if ((hint.data_->first == psl) && equal_(get_key(hint.data_->second), key))
+    if ((hint.data_->first == psl) && (hint.data_->hash == hash) && equal_(get_key(hint.data_->second), key))
     {
       return {hint, IsMulti};
     }
@@ -71,7 +72,8 @@ std::pair< typename rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::iterat
 {
   extend(size_ + 1);
   temp_value temp{std::forward< Args >(args)...};
-  return emplace_hint_impl(find_hint_pair(get_key(temp)), std::move(temp));
+  size_type hash = hash_(get_key(temp));
+  return emplace_hint_impl(find_hint_pair(get_key(temp), hash), hash, std::move(temp));
 }
 template< class K, class T, class H, class E, bool IsSet, bool IsMulti >
 template< class... Args >
@@ -79,7 +81,8 @@ typename rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::iterator
     rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::emplace_hint(const_iterator hint, Args&&... args)
 {
   temp_value temp{std::forward< Args >(args)...};
-  return emplace_hint_impl(correct_hint(hint, get_key(temp)), std::move(temp)).first;
+  size_type hash = hash_(get_key(temp));
+  return emplace_hint_impl(correct_hint(hint, get_key(temp), hash), hash, std::move(temp)).first;
 }
 
 template< class K, class T, class H, class E, bool IsSet, bool IsMulti >
@@ -89,7 +92,8 @@ std::enable_if_t< !IsSet && !IsSet2,
     rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::try_emplace(const key_type& key, Args&&... args)
 {
   extend(size_ + 1);
-  return emplace_hint_impl(find_hint_pair(key), std::piecewise_construct,
+  size_type hash = hash_(key);
+  return emplace_hint_impl(find_hint_pair(key, hash), hash, std::piecewise_construct,
         std::forward_as_tuple(key), std::forward_as_tuple(std::forward< Args >(args)...));
 }
 template< class K, class T, class H, class E, bool IsSet, bool IsMulti >
@@ -99,7 +103,8 @@ std::enable_if_t< !IsSet && !IsSet2,
     rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::try_emplace(key_type&& key, Args&&... args)
 {
   extend(size_ + 1);
-  return emplace_hint_impl(find_hint_pair(key), std::piecewise_construct,
+  size_type hash = hash_(key);
+  return emplace_hint_impl(find_hint_pair(key, hash), hash, std::piecewise_construct,
         std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward< Args >(args)...));
 }
 template< class K, class T, class H, class E, bool IsSet, bool IsMulti >
@@ -110,7 +115,8 @@ typename rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::transparent_hash_
     rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::try_emplace(K1&& key, Args&&... args)
 {
   extend(size_ + 1);
-  return emplace_hint_impl(find_hint_pair(key), std::piecewise_construct,
+  size_type hash = hash_(key);
+  return emplace_hint_impl(find_hint_pair(key, hash), hash, std::piecewise_construct,
         std::forward_as_tuple(std::forward< K1 >(key)), std::forward_as_tuple(std::forward< Args >(args)...));
 }
 template< class K, class T, class H, class E, bool IsSet, bool IsMulti >
@@ -119,7 +125,8 @@ std::enable_if_t< !IsSet && !IsSet2, typename rychkov::UnorderedBase< K, T, H, E
     rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::try_emplace(const_iterator hint,
       const key_type& key, Args&&... args)
 {
-  return emplace_hint_impl(correct_hint(hint, key), key, std::forward< Args >(args)...).first;
+  size_type hash = hash_(key);
+  return emplace_hint_impl(correct_hint(hint, key, hash), hash, key, std::forward< Args >(args)...).first;
 }
 template< class K, class T, class H, class E, bool IsSet, bool IsMulti >
 template< bool IsSet2, class... Args >
@@ -127,7 +134,8 @@ std::enable_if_t< !IsSet && !IsSet2, typename rychkov::UnorderedBase< K, T, H, E
     rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::try_emplace(const_iterator hint,
       key_type&& key, Args&&... args)
 {
-  return emplace_hint_impl(correct_hint(hint, key), std::move(key), std::forward< Args >(args)...).first;
+  size_type hash = hash_(key);
+  return emplace_hint_impl(correct_hint(hint, key, hash), hash, std::move(key), std::forward< Args >(args)...).first;
 }
 template< class K, class T, class H, class E, bool IsSet, bool IsMulti >
 template< bool IsSet2, class K1, class... Args >
@@ -136,7 +144,9 @@ typename rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::transparent_hash_
         std::pair< typename rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::iterator, bool > >, K1 >
     rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::try_emplace(const_iterator hint, K1&& key, Args&&... args)
 {
-  return emplace_hint_impl(correct_hint(hint, key), std::forward< K1 >(key), std::forward< Args >(args)...).first;
+  size_type hash = hash_(key);
+  return emplace_hint_impl(correct_hint(hint, key, hash), hash, std::forward< K1 >(key),
+        std::forward< Args >(args)...).first;
 }
 
 template< class K, class T, class H, class E, bool IsSet, bool IsMulti >
@@ -144,14 +154,16 @@ std::pair< typename rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::iterat
     rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::insert(const value_type& value)
 {
   extend(size_ + 1);
-  return emplace_hint_impl(find_hint_pair(get_key(value)), value);
+  size_type hash = hash_(get_key(value));
+  return emplace_hint_impl(find_hint_pair(get_key(value), hash), hash, value);
 }
 template< class K, class T, class H, class E, bool IsSet, bool IsMulti >
 std::pair< typename rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::iterator, bool >
     rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::insert(value_type&& value)
 {
   extend(size_ + 1);
-  return emplace_hint_impl(find_hint_pair(get_key(value)), std::move(value));
+  size_type hash = hash_(get_key(value));
+  return emplace_hint_impl(find_hint_pair(get_key(value), hash), hash, std::move(value));
 }
 template< class K, class T, class H, class E, bool IsSet, bool IsMulti >
 template< class V >
@@ -167,13 +179,15 @@ template< class K, class T, class H, class E, bool IsSet, bool IsMulti >
 typename rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::iterator
     rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::insert(const_iterator hint, const value_type& value)
 {
-  return emplace_hint_impl(correct_hint(hint, get_key(value)), value).first;
+  size_type hash = hash_(get_key(value));
+  return emplace_hint_impl(correct_hint(hint, get_key(value), hash), hash, value).first;
 }
 template< class K, class T, class H, class E, bool IsSet, bool IsMulti >
 typename rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::iterator
     rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::insert(const_iterator hint, value_type&& value)
 {
-  return emplace_hint_impl(correct_hint(hint, get_key(value)), std::move(value)).first;
+  size_type hash = hash_(get_key(value));
+  return emplace_hint_impl(correct_hint(hint, get_key(value), hash), hash, std::move(value)).first;
 }
 template< class K, class T, class H, class E, bool IsSet, bool IsMulti >
 template< class V >
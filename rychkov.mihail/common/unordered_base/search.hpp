@@ -26,11 +26,11 @@ typename rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::const_iterator
   {
     return end();
   }
-  size_type slot = hash_(key) % capacity_;
+  size_type hash = hash_(key), slot = hash % capacity_;
   for (size_type i = 0; (data_[slot].first != ~0ULL) && (data_[slot].first >= i); i++,
         slot = (++slot < capacity_ ? slot : slot - capacity_))
   {
-    if ((data_[slot].first == i) && equal_(get_key(data_[slot].second), key))
+    if ((data_[slot].first == i) && (data_[slot].hash == hash) && equal_(get_key(data_[slot].second), key))
     {
       return {data_ + slot, data_ + capacity_};
     }
@@ -46,11 +46,11 @@ typename rychkov::UnorderedBase< K, T, H, E, IsSet, IsMulti >::size_type
   {
     return 0;
   }
-  size_type slot = hash_(key) % capacity_, result = 0;
+  size_type hash = hash_(key), slot = hash % capacity_, result = 0;
   for (size_type i = 0; (data_[slot].first != ~0ULL) && (data_[slot].first >= i); i++,
         slot = (++slot < capacity_ ? slot : slot - capacity_))
   {
-    if ((data_[slot].first == i) && equal_(get_key(data_[slot].second), key))
+    if ((data_[slot].first == i) && (data_[slot].hash == hash) && equal_(get_key(data_[slot].second), key))
     {
       result++;
     }
@@ -3,8 +3,13 @@
 #include <random>
 #include <algorithm>
 #include <functional>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <thread>
 #include <boost/gil.hpp>
 #include <boost/gil/extension/io/bmp.hpp>
+#include <dynamic-array.hpp>
 #include <shape-utils.hpp>
 #include "project-body.hpp"
 
@@ -20,33 +25,50 @@ namespace savintsev
       gil::rgb8_image_t image(w, h);
       auto view = gil::view(image);
 
-      gil::fill_pixels(view, gil::rgb8_pixel_t(255, 255, 255));
-      struct RenderWrapper
+      Array< PreparedShape > shapes;
+      struct PrepareWrapper
       {
-        RenderWrapper(Renderer * r, gil::rgb8_view_t & v):
+        PrepareWrapper(Renderer * r, Array< PreparedShape > & s, int h):
           renderer(r),
-          view(v)
+          shapes(s),
+          height(h)
         {}
         void operator()(const savintsev::Layer & layer)
         {
-          renderer->render_shape(view, layer.second);
+          PreparedShape prepared;
+          if (renderer->prepare_shape(prepared, layer.second, height))
+          {
+            shapes.push_back(prepared);
+          }
         }
         Renderer * renderer;
-        gil::rgb8_view_t & view;
+        Array< PreparedShape > & shapes;
+        int height;
       };
 
-      std::for_each(proj.begin(), proj.end(), RenderWrapper(this, view));
+      std::for_each(proj.begin(), proj.end(), PrepareWrapper(this, shapes, h));
+      render_tiles(view, shapes);
 
       gil::write_view(name + ".bmp", view, gil::bmp_tag{});
     }
   private:
-    private:
-    void render_shape(gil::rgb8_view_t & view, const savintsev::Shape * shape)
+    static constexpr int tile_rows = 32;
+
+    struct PreparedShape
+    {
+      savintsev::point_t points[4];
+      size_t count;
+      int first_row;
+      int last_row;
+      gil::rgb8_pixel_t color;
+    };
+
+    bool prepare_shape(PreparedShape & prepared, const savintsev::Shape * shape, int height)
     {
       std::mt19937 rng(std::random_device{}());
       std::uniform_int_distribution<int> dist(50, 240);
 
-      gil::rgb8_pixel_t color
+      prepared.color = gil::rgb8_pixel_t
       (
         static_cast< uint8_t >(dist(rng)),
         static_cast< uint8_t >(dist(rng)),
@@ -54,62 +76,149 @@ namespace savintsev
       );
 
       savintsev::point_t points[4];
-      size_t point_count = shape->get_all_points(points);
+      prepared.count = shape->get_all_points(points);
 
-      if (point_count == 2)
+      if (prepared.count == 2)
       {
-        savintsev::point_t rect_points[4];
-        rect_points[0] = {points[0].x, points[0].y};
-        rect_points[1] = {points[1].x, points[0].y};
-        rect_points[2] = {points[1].x, points[1].y};
-        rect_points[3] = {points[0].x, points[1].y};
-        fill_shape(view, rect_points, 4, color);
+        prepared.points[0] = {points[0].x, points[0].y};
+        prepared.points[1] = {points[1].x, points[0].y};
+        prepared.points[2] = {points[1].x, points[1].y};
+        prepared.points[3] = {points[0].x, points[1].y};
+        prepared.count = 4;
       }
       else
       {
-        fill_shape(view, points, point_count, color);
+        std::copy(points, points + prepared.count, prepared.points);
       }
+      if (prepared.count < 3)
+      {
+        return false;
+      }
+
+      // rows are sampled at fy + 0.5, so the frame is widened by a row on each side to absorb rounding
+      rectangle_t frame = shape->get_frame_rect();
+      double top = height / 2.0 + 0.5 - (frame.pos.y + std::abs(frame.height) / 2.0);
+      double bottom = height / 2.0 + 0.5 - (frame.pos.y - std::abs(frame.height) / 2.0);
+      prepared.first_row = clamp_row(std::floor(top) - 1.0, height);
+      prepared.last_row = clamp_row(std::ceil(bottom) + 2.0, height);
+      return prepared.first_row < prepared.last_row;
     }
-    void fill_shape(gil::rgb8_view_t & view, const savintsev::point_t * points, size_t count, gil::rgb8_pixel_t c)
+
+    static int clamp_row(double row, int height)
     {
-      if (count < 3)
+      if (!(row > 0.0))
       {
-        return;
+        return 0;
       }
+      return row < height ? static_cast< int >(row) : height;
+    }
 
-      int width = view.width();
-      int height = view.height();
+    void render_tiles(gil::rgb8_view_t & view, const Array< PreparedShape > & shapes)
+    {
+      int tiles_count = (view.height() + tile_rows - 1) / tile_rows;
+      unsigned workers_count = std::max(std::thread::hardware_concurrency(), 1u);
+      workers_count = std::min(workers_count, static_cast< unsigned >(std::max(tiles_count, 1)));
 
-      for (int y = 0; y < height; ++y)
+      std::atomic< int > next_tile(0);
+      Array< std::thread > workers(workers_count - 1);
+      try
       {
-        for (int x = 0; x < width; ++x)
+        for (unsigned i = 1; i < workers_count; ++i)
         {
-          double fx = x - width / 2.0;
-          double fy = height / 2.0 - y;
+          workers.push_back(std::thread(&Renderer::render_worker, this, std::ref(view), std::cref(shapes),
+            std::ref(next_tile)));
+        }
+      }
+      catch (...)
+      {
+        std::for_each(workers.begin(), workers.end(), std::mem_fn(&std::thread::join));
+        throw;
+      }
+      render_worker(view, shapes, next_tile);
+      std::for_each(workers.begin(), workers.end(), std::mem_fn(&std::thread::join));
+    }
 
-          if (is_point_in_polygon(points, count, fx + 0.5, fy + 0.5))
+    void render_worker(gil::rgb8_view_t & view, const Array< PreparedShape > & shapes, std::atomic< int > & next_tile)
+    {
+      int height = view.height();
+      for (int tile = next_tile++; tile * tile_rows < height; tile = next_tile++)
+      {
+        int first_row = tile * tile_rows;
+        int last_row = std::min(first_row + tile_rows, height);
+        for (int y = first_row; y < last_row; ++y)
+        {
+          std::fill(view.row_begin(y), view.row_end(y), gil::rgb8_pixel_t(255, 255, 255));
+        }
+        for (size_t i = 0; i < shapes.size(); ++i)
+        {
+          const PreparedShape & shape = shapes[i];
+          int shape_last = std::min(last_row, shape.last_row);
+          for (int y = std::max(first_row, shape.first_row); y < shape_last; ++y)
           {
-            view(x, y) = c;
+            fill_row(view, shape, y);
           }
         }
       }
     }
 
-    bool is_point_in_polygon(const savintsev::point_t * points, size_t point_count, double x, double y)
+    void fill_row(gil::rgb8_view_t & view, const PreparedShape & shape, int y)
     {
-      bool inside = false;
-      for (size_t i = 0, j = point_count - 1; i < point_count; j = i++)
+      int width = view.width();
+      double fy = view.height() / 2.0 - y;
+      double py = fy + 0.5;
+
+      double crossings[4];
+      size_t crossings_count = 0;
+      for (size_t i = 0, j = shape.count - 1; i < shape.count; j = i++)
       {
-        double xi = points[i].x, yi = points[i].y;
-        double xj = points[j].x, yj = points[j].y;
+        double xi = shape.points[i].x, yi = shape.points[i].y;
+        double xj = shape.points[j].x, yj = shape.points[j].y;
 
-        bool intersect = ((yi > y) != (yj > y)) && (x < (xj - xi) * (y - yi) / (yj - yi + 1e-15) + xi);
-        if (intersect)
+        if ((yi > py) != (yj > py))
         {
-          inside = !inside;
+          double cx = (xj - xi) * (py - yi) / (yj - yi + 1e-15) + xi;
+          crossings[crossings_count++] = std::isnan(cx) ? -std::numeric_limits< double >::infinity() : cx;
         }
       }
-      return inside;
+      std::sort(crossings, crossings + crossings_count);
+
+      // a sample is inside when an odd number of crossings lie at or left of it
+      auto row = view.row_begin(y);
+      for (size_t i = 0; i + 1 < crossings_count; i += 2)
+      {
+        int first = first_column_from(crossings[i], width);
+        int last = first_column_from(crossings[i + 1], width);
+        std::fill(row + first, row + last, shape.color);
+      }
+    }
+
+    static double column_sample(int x, int width)
+    {
+      double fx = x - width / 2.0;
+      return fx + 0.5;
+    }
+
+    static int first_column_from(double crossing, int width)
+    {
+      double guess = std::ceil(crossing + width / 2.0 - 0.5);
+      int x = 0;
+      if (guess >= width)
+      {
+        x = width;
+      }
+      else if (guess > 0.0)
+      {
+        x = static_cast< int >(guess);
+      }
+      while (x > 0 && column_sample(x - 1, width) >= crossing)
+      {
+        --x;
+      }
+      while (x < width && column_sample(x, width) < crossing)
+      {
+        ++x;
+      }
+      return x;
     }
   };
 }
@@ -3,6 +3,10 @@
 #include <initializer_list>
 #include <iterator>
 #include <iostream>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 #include <boost/hash2/xxhash.hpp>
 #include <dynamic-array.hpp>
@@ -38,15 +42,13 @@ namespace savintsev
       FwdIter() = default;
       FwdIter(const FwdConstIter & other):
         parent_(const_cast< HashMap * >(other.parent_)),
-        pos_(other.pos_),
-        first_(other.first_)
+        pos_(other.pos_)
       {
         skip_empty();
       }
-      FwdIter(HashMap * parent, size_t pos, bool in_table1):
+      FwdIter(HashMap * parent, size_t pos):
         parent_(parent),
-        pos_(pos),
-        first_(in_table1)
+        pos_(pos)
       {
         skip_empty();
       }
@@ -69,7 +71,6 @@ namespace savintsev
     private:
       HashMap * parent_ = nullptr;
       size_t pos_ = 0;
-      bool first_ = true;
       void skip_empty();
     };
 
@@ -88,15 +89,13 @@ namespace savintsev
       FwdConstIter() = default;
       FwdConstIter(const FwdIter & it):
         parent_(it.parent_),
-        pos_(it.pos_),
-        first_(it.first_)
+        pos_(it.pos_)
       {
         skip_empty();
       }
-      FwdConstIter(const HashMap * parent, size_t pos, bool in_table1):
+      FwdConstIter(const HashMap * parent, size_t pos):
         parent_(parent),
-        pos_(pos),
-        first_(in_table1)
+        pos_(pos)
       {
         skip_empty();
       }
@@ -117,7 +116,6 @@ namespace savintsev
     private:
       const HashMap * parent_ = nullptr;
       size_t pos_ = 0;
-      bool first_ = true;
       void skip_empty();
     };
 
@@ -133,13 +131,19 @@ namespace savintsev
     template< class InputIterator >
     HashMap(InputIterator first, InputIterator last);
     HashMap(std::initializer_list< std::pair< Key, T > > il);
+    HashMap(const HashMap & rhs);
+    HashMap(HashMap && rhs) noexcept;
+    ~HashMap();
+
+    HashMap & operator=(const HashMap & rhs);
+    HashMap & operator=(HashMap && rhs) noexcept;
 
     size_t size() const;
     size_t capacity() const;
     bool empty() const noexcept;
 
     void clear() noexcept;
-    void swap(HashMap & rhs);
+    void swap(HashMap & rhs) noexcept;
 
     T & at(const Key & k);
     const T & at(const Key & k) const;
@@ -179,18 +183,46 @@ namespace savintsev
     void rehash(size_t n);
 
   private:
+    struct Slot
+    {
+      alignas(val_type) unsigned char data[sizeof(val_type)];
+    };
+
+    struct Probe
+    {
+      size_t first;
+      size_t second;
+      unsigned char tag;
+    };
 
-    std::vector< std::pair< std::pair< Key, T >, bool > > t1_;
-    std::vector< std::pair< std::pair< Key, T >, bool > > t2_;
+    // tags_[i] is the fingerprint of slots_[i], 0 marks an empty slot.
+    // Both tables are laid out as buckets of BUCKET_SIZE slots, followed by the stash.
+    std::vector< unsigned char > tags_;
+    std::vector< Slot > slots_;
 
-    size_t capacity_;
+    size_t buckets_;
     size_t size_;
+    size_t stashed_;
 
+    static constexpr size_t BUCKET_SIZE = 4;
+    static constexpr size_t STASH_SIZE = 8;
     static constexpr size_t MAX_ITERATIONS = 100;
 
     double max_load_factor_ = 0.75;
 
-    T & insert_data(const Key & k);
+    val_type & value(size_t pos) noexcept;
+    const val_type & value(size_t pos) const noexcept;
+
+    size_t slot_count() const noexcept;
+    size_t stash_begin() const noexcept;
+    size_t bucket(size_t table, size_t hash) const noexcept;
+    size_t free_slot(size_t first, size_t last) const noexcept;
+
+    Probe probe(const Key & k) const;
+    size_t find_slot(const Key & k) const;
+    size_t place(val_type && val);
+    size_t place(const val_type & val);
+    void destroy(size_t pos) noexcept;
   };
 
   template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
@@ -199,15 +231,16 @@ namespace savintsev
   {}
   template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
   HashMap< Key, T, HS1, HS2, EQ >::HashMap(size_t size):
-    t1_(size),
-    t2_(size),
-    capacity_(size),
-    size_(0)
+    tags_(),
+    slots_(),
+    buckets_((size + 2 * BUCKET_SIZE - 1) / (2 * BUCKET_SIZE)),
+    size_(0),
+    stashed_(0)
   {
-    for (size_t i = 0; i < capacity_; ++i)
+    if (buckets_ != 0)
     {
-      t1_[i].second = false;
-      t2_[i].second = false;
+      tags_.resize(2 * buckets_ * BUCKET_SIZE + STASH_SIZE);
+      slots_.resize(tags_.size());
     }
   }
   template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
@@ -222,6 +255,70 @@ namespace savintsev
     HashMap(il.begin(), il.end())
   {}
   template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
+  HashMap< Key, T, HS1, HS2, EQ >::HashMap(const HashMap & rhs):
+    tags_(rhs.tags_.size()),
+    slots_(rhs.slots_.size()),
+    buckets_(rhs.buckets_),
+    size_(0),
+    stashed_(rhs.stashed_),
+    max_load_factor_(rhs.max_load_factor_)
+  {
+    try
+    {
+      for (size_t i = 0; i < slot_count(); ++i)
+      {
+        if (rhs.tags_[i])
+        {
+          new (slots_[i].data) val_type(rhs.value(i));
+          tags_[i] = rhs.tags_[i];
+          ++size_;
+        }
+      }
+    }
+    catch (...)
+    {
+      clear();
+      throw;
+    }
+  }
+  template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
+  HashMap< Key, T, HS1, HS2, EQ >::HashMap(HashMap && rhs) noexcept:
+    tags_(std::move(rhs.tags_)),
+    slots_(std::move(rhs.slots_)),
+    buckets_(std::exchange(rhs.buckets_, 0)),
+    size_(std::exchange(rhs.size_, 0)),
+    stashed_(std::exchange(rhs.stashed_, 0)),
+    max_load_factor_(rhs.max_load_factor_)
+  {
+    rhs.tags_.clear();
+    rhs.slots_.clear();
+  }
+  template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
+  HashMap< Key, T, HS1, HS2, EQ >::~HashMap()
+  {
+    clear();
+  }
+  template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
+  HashMap< Key, T, HS1, HS2, EQ > & HashMap< Key, T, HS1, HS2, EQ >::operator=(const HashMap & rhs)
+  {
+    if (this != std::addressof(rhs))
+    {
+      HashMap temp(rhs);
+      swap(temp);
+    }
+    return *this;
+  }
+  template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
+  HashMap< Key, T, HS1, HS2, EQ > & HashMap< Key, T, HS1, HS2, EQ >::operator=(HashMap && rhs) noexcept
+  {
+    if (this != std::addressof(rhs))
+    {
+      HashMap temp(std::move(rhs));
+      swap(temp);
+    }
+    return *this;
+  }
+  template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
   size_t HashMap< Key, T, HS1, HS2, EQ >::size() const
   {
     return size_;
@@ -229,7 +326,7 @@ namespace savintsev
   template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
   size_t HashMap< Key, T, HS1, HS2, EQ >::capacity() const
   {
-    return capacity_;
+    return 2 * buckets_ * BUCKET_SIZE;
   }
   template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
   bool HashMap< Key, T, HS1, HS2, EQ >::empty() const noexcept
@@ -239,27 +336,22 @@ namespace savintsev
   template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
   void HashMap< Key, T, HS1, HS2, EQ >::clear() noexcept
   {
-    for (size_t i = 0; i < capacity_; ++i)
+    for (size_t i = 0; size_ != 0 && i < slot_count(); ++i)
     {
-      if (t1_[i].second)
-      {
-        t1_[i].second = false;
-      }
-      if (t2_[i].second)
+      if (tags_[i])
       {
-        t2_[i].second = false;
+        destroy(i);
       }
     }
-
-    size_ = 0;
   }
   template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
-  void HashMap< Key, T, HS1, HS2, EQ >::swap(HashMap< Key, T, HS1, HS2, EQ > & rhs)
+  void HashMap< Key, T, HS1, HS2, EQ >::swap(HashMap< Key, T, HS1, HS2, EQ > & rhs) noexcept
   {
-    t1_.swap(rhs.t1_);
-    t2_.swap(rhs.t2_);
-    std::swap(capacity_, rhs.capacity_);
+    tags_.swap(rhs.tags_);
+    slots_.swap(rhs.slots_);
+    std::swap(buckets_, rhs.buckets_);
     std::swap(size_, rhs.size_);
+    std::swap(stashed_, rhs.stashed_);
     std::swap(max_load_factor_, rhs.max_load_factor_);
   }
   template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
@@ -285,99 +377,71 @@ namespace savintsev
   template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
   T & HashMap< Key, T, HS1, HS2, EQ >::operator[](const Key & k)
   {
-    auto data = find(k);
-    if (data != end())
+    size_t pos = find_slot(k);
+    if (pos == slot_count())
     {
-      return data->second;
+      pos = place(val_type(k, T{}));
     }
-    return insert_data(k);
+    return value(pos).second;
   }
   template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
   T & HashMap< Key, T, HS1, HS2, EQ >::operator[](Key && k)
   {
-    auto data = find(k);
-    if (data != end())
+    size_t pos = find_slot(k);
+    if (pos == slot_count())
     {
-      return data->second;
+      pos = place(val_type(std::move(k), T{}));
     }
-    return insert_data(k);
+    return value(pos).second;
   }
   template< typename K, typename T, typename HS1, typename HS2, typename EQ >
   typename HashMap< K, T, HS1, HS2, EQ >::iterator HashMap< K, T, HS1, HS2, EQ >::begin() noexcept
   {
-    return iterator(this, 0, true);
+    return iterator(this, 0);
   }
   template< typename K, typename T, typename HS1, typename HS2, typename EQ >
   typename HashMap< K, T, HS1, HS2, EQ >::const_iterator HashMap< K, T, HS1, HS2, EQ >::begin() const noexcept
   {
-    return const_iterator(this, 0, true);
+    return const_iterator(this, 0);
   }
   template< typename K, typename T, typename HS1, typename HS2, typename EQ >
   typename HashMap< K, T, HS1, HS2, EQ >::const_iterator HashMap< K, T, HS1, HS2, EQ >::cbegin() const noexcept
   {
-    return const_iterator(this, 0, true);
+    return const_iterator(this, 0);
   }
   template< typename K, typename T, typename HS1, typename HS2, typename EQ >
   typename HashMap< K, T, HS1, HS2, EQ >::iterator HashMap< K, T, HS1, HS2, EQ >::end() noexcept
   {
-    return iterator(this, capacity_, false);
+    return iterator(this, slot_count());
   }
   template< typename K, typename T, typename HS1, typename HS2, typename EQ >
   typename HashMap< K, T, HS1, HS2, EQ >::const_iterator HashMap< K, T, HS1, HS2, EQ >::end() const noexcept
   {
-    return const_iterator(this, capacity_, false);
+    return const_iterator(this, slot_count());
   }
   template< typename K, typename T, typename HS1, typename HS2, typename EQ >
   typename HashMap< K, T, HS1, HS2, EQ >::const_iterator HashMap< K, T, HS1, HS2, EQ >::cend() const noexcept
   {
-    return const_iterator(this, capacity_, false);
+    return const_iterator(this, slot_count());
   }
   template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
   size_t HashMap< Key, T, HS1, HS2, EQ >::erase(const Key & k)
   {
-    Key current_key = k;
-
-    size_t h1 = HS1{}(current_key) % capacity_;
-    if (t1_[h1].second)
+    const size_t pos = find_slot(k);
+    if (pos == slot_count())
     {
-      Key old_key = t1_[h1].first.first;
-      if (EQ{}(current_key, old_key))
-      {
-        t1_[h1].second = false;
-        --size_;
-        return 1ull;
-      }
+      return 0ull;
     }
-
-    size_t h2 = HS2{}(current_key) % capacity_;
-    if (t2_[h2].second)
-    {
-      Key old_key = t2_[h2].first.first;
-      if (EQ{}(current_key, old_key))
-      {
-        t2_[h2].second = false;
-        --size_;
-        return 1ull;
-      }
-    }
-
-    return 0ull;
+    destroy(pos);
+    return 1ull;
   }
   template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
   typename HashMap< Key, T, HS1, HS2, EQ >::iterator HashMap< Key, T, HS1, HS2, EQ >::erase(const_iterator position)
   {
-    iterator it = find(position->first);
+    iterator it(position);
     if (it != end())
     {
-      if (it.first_)
-      {
-        t1_[it.pos_].second = false;
-      }
-      else
-      {
-        t2_[it.pos_].second = false;
-      }
-      --size_;
+      destroy(it.pos_);
       ++it;
     }
     return it;
@@ -385,15 +449,11 @@ namespace savintsev
   template< typename K, typename T, typename H, typename N, typename E >
   typename HashMap< K, T, H, N, E >::iterator HashMap< K, T, H, N, E >::erase(const_iterator fst, const_iterator last)
   {
-    if (fst == cend())
+    for (auto it = fst; it != last; ++it)
     {
-      return iterator(this, capacity_, false);
+      destroy(it.pos_);
     }
-    for (auto it = fst; it != last;)
-    {
-      it = erase(it);
-    }
-    return find(last->first);
+    return iterator(last);
   }
   template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
   template< class... Args >
@@ -404,7 +464,7 @@ namespace savintsev
   >
   HashMap< Key, T, HS1, HS2, EQ >::emplace(Args &&... args)
   {
-    std::pair< Key, T > temp(std::forward< Args >(args)...);
+    val_type temp(std::forward< Args >(args)...);
 
     auto it = find(temp.first);
     if (it != end())
@@ -412,13 +472,11 @@ namespace savintsev
       return {it, false};
     }
 
-    T & inserted = insert_data(temp.first);
-    inserted = std::move(temp.second);
-    return {find(temp.first), true};
+    return {iterator(this, place(std::move(temp))), true};
   }
   template< typename K, typename T, typename A, typename B, typename E >
   template< class... X >
-  typename HashMap< K, T, A, B, E >::iterator HashMap< K, T, A, B, E >::emplace_hint(const_iterator hint, X &&... args)
+  typename HashMap< K, T, A, B, E >::iterator HashMap< K, T, A, B, E >::emplace_hint(const_iterator, X &&... args)
   {
     return emplace(std::forward< X >(args)...).first;
   }
@@ -436,11 +494,10 @@ namespace savintsev
       return {it, false};
     }
 
-    insert_data(val.first) = val.second;
-    return {find(val.first), true};
+    return {iterator(this, place(val_type(val))), true};
   }
   template< typename K, typename T, typename A, typename B, typename E >
-  typename HashMap< K, T, A, B, E >::iterator HashMap< K, T, A, B, E >::insert(const_iterator hint, const val_type & v)
+  typename HashMap< K, T, A, B, E >::iterator HashMap< K, T, A, B, E >::insert(const_iterator, const val_type & v)
   {
     return insert(v).first;
   }
@@ -456,43 +513,17 @@ namespace savintsev
   template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
   typename HashMap< Key, T, HS1, HS2, EQ >::iterator HashMap< Key, T, HS1, HS2, EQ >::find(const Key & k)
   {
-    size_t h1 = HS1{}(k) % capacity_;
-    size_t h2 = HS2{}(k) % capacity_;
-
-    if (t1_[h1].second && EQ{}(t1_[h1].first.first, k))
-    {
-      return iterator(this, h1, true);
-    }
-
-    if (t2_[h2].second && EQ{}(t2_[h2].first.first, k))
-    {
-      return iterator(this, h2, false);
-    }
-
-    return iterator(this, capacity_, false);
+    return iterator(this, find_slot(k));
   }
   template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
   typename HashMap< Key, T, HS1, HS2, EQ >::const_iterator HashMap< Key, T, HS1, HS2, EQ >::find(const Key & k) const
   {
-    size_t h1 = HS1{}(k) % capacity_;
-    size_t h2 = HS2{}(k) % capacity_;
-
-    if (t1_[h1].second && EQ{}(t1_[h1].first.first, k))
-    {
-      return const_iterator(this, h1, true);
-    }
-
-    if (t2_[h2].second && EQ{}(t2_[h2].first.first, k))
-    {
-      return const_iterator(this, h2, false);
-    }
-
-    return const_iterator(this, capacity_, false);
+    return const_iterator(this, find_slot(k));
   }
   template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
   float HashMap< Key, T, HS1, HS2, EQ >::load_factor() const noexcept
   {
-    return static_cast< double >(size_) / capacity_;
+    return capacity() ? static_cast< double >(size_) / capacity() : 0.0;
   }
   template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
   float HashMap< Key, T, HS1, HS2, EQ >::max_load_factor() const noexcept
@@ -510,102 +541,177 @@ namespace savintsev
   template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
   void HashMap< Key, T, HS1, HS2, EQ >::rehash(size_t n)
   {
-    std::vector< std::pair< std::pair< Key, T >, bool > > new_t1(n);
-    std::vector< std::pair< std::pair< Key, T >, bool > > new_t2(n);
-
-    const size_t old_capacity = capacity_;
-    const size_t old_size = size_;
-
-    std::swap(t1_, new_t1);
-    std::swap(t2_, new_t2);
-
-    capacity_ = n;
-    size_ = 0;
+    HashMap temp(n < size_ ? size_ : n);
+    temp.max_load_factor_ = max_load_factor_;
+    for (size_t i = 0; i < slot_count(); ++i)
+    {
+      if (tags_[i])
+      {
+        temp.place(std::move_if_noexcept(value(i)));
+      }
+    }
+    swap(temp);
+  }
 
-    try
+  template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
+  typename HashMap< Key, T, HS1, HS2, EQ >::val_type & HashMap< Key, T, HS1, HS2, EQ >::value(size_t pos) noexcept
+  {
+    return *reinterpret_cast< val_type * >(slots_[pos].data);
+  }
+  template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
+  const typename HashMap< Key, T, HS1, HS2, EQ >::val_type & HashMap< Key, T, HS1, HS2, EQ >::value(size_t pos) const noexcept
+  {
+    return *reinterpret_cast< const val_type * >(slots_[pos].data);
+  }
+  template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
+  size_t HashMap< Key, T, HS1, HS2, EQ >::slot_count() const noexcept
+  {
+    return tags_.size();
+  }
+  template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
+  size_t HashMap< Key, T, HS1, HS2, EQ >::stash_begin() const noexcept
+  {
+    return capacity();
+  }
+  template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
+  size_t HashMap< Key, T, HS1, HS2, EQ >::bucket(size_t table, size_t hash) const noexcept
+  {
+    return (table * buckets_ + hash % buckets_) * BUCKET_SIZE;
+  }
+  template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
+  size_t HashMap< Key, T, HS1, HS2, EQ >::free_slot(size_t first, size_t last) const noexcept
+  {
+    for (size_t i = first; i < last; ++i)
     {
-      for (size_t i = 0; i < old_capacity; ++i)
+      if (!tags_[i])
       {
-        if (new_t1[i].second)
-        {
-          insert_data(new_t1[i].first.first) = new_t1[i].first.second;
-        }
-        if (new_t2[i].second)
-        {
-          insert_data(new_t2[i].first.first) = new_t2[i].first.second;
-        }
+        return i;
       }
     }
-    catch (...)
+    return slot_count();
+  }
+  template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
+  typename HashMap< Key, T, HS1, HS2, EQ >::Probe HashMap< Key, T, HS1, HS2, EQ >::probe(const Key & k) const
+  {
+    const size_t h1 = HS1{}(k);
+    const size_t h2 = HS2{}(k);
+    const unsigned char tag = static_cast< unsigned char >(h2 >> ((sizeof(size_t) - 1) * 8));
+    return {h1, h2, tag ? tag : static_cast< unsigned char >(1)};
+  }
+  template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
+  size_t HashMap< Key, T, HS1, HS2, EQ >::find_slot(const Key & k) const
+  {
+    if (size_ == 0)
     {
-      std::swap(t1_, new_t1);
-      std::swap(t2_, new_t2);
-      capacity_ = old_capacity;
-      size_ = old_size;
-      throw;
+      return slot_count();
+    }
+    const Probe p = probe(k);
+    const size_t b1 = bucket(0, p.first);
+    const size_t b2 = bucket(1, p.second);
+    for (size_t i = 0; i < BUCKET_SIZE; ++i)
+    {
+      if (tags_[b1 + i] == p.tag && EQ{}(value(b1 + i).first, k))
+      {
+        return b1 + i;
+      }
     }
+    for (size_t i = 0; i < BUCKET_SIZE; ++i)
+    {
+      if (tags_[b2 + i] == p.tag && EQ{}(value(b2 + i).first, k))
+      {
+        return b2 + i;
+      }
+    }
+    for (size_t i = stash_begin(); stashed_ != 0 && i < slot_count(); ++i)
+    {
+      if (tags_[i] == p.tag && EQ{}(value(i).first, k))
+      {
+        return i;
+      }
+    }
+    return slot_count();
   }
   template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
-  T & HashMap< Key, T, HS1, HS2, EQ >::insert_data(const Key & k)
+  size_t HashMap< Key, T, HS1, HS2, EQ >::place(val_type && val)
   {
-    Key original_key = k;
-
-    Key current_key = k;
-    T current_value = T{};
-    size_t attempts = 0;
-    bool is_inserted = false;
-
-    if (load_factor() > max_load_factor_)
+    if (size_ + 1 > max_load_factor_ * capacity())
     {
-      rehash(capacity_ * 2);
+      rehash(capacity() ? capacity() * 2 : 2 * BUCKET_SIZE);
     }
 
-    while (attempts < MAX_ITERATIONS)
+    val_type carried(std::move(val));
+    Probe p = probe(carried.first);
+    size_t home = slot_count();
+    size_t next = bucket(0, p.first);
+
+    for (size_t attempts = 0; attempts < MAX_ITERATIONS; ++attempts)
     {
-      size_t h1 = HS1{}(current_key) % capacity_;
-      if (!t1_[h1].second)
+      size_t pos = free_slot(bucket(0, p.first), bucket(0, p.first) + BUCKET_SIZE);
+      if (pos == slot_count())
       {
-        t1_[h1] = {{current_key, current_value}, true};
-        size_++;
-        is_inserted = true;
-        break;
+        pos = free_slot(bucket(1, p.second), bucket(1, p.second) + BUCKET_SIZE);
+      }
+      if (pos != slot_count())
+      {
+        new (slots_[pos].data) val_type(std::move(carried));
+        tags_[pos] = p.tag;
+        ++size_;
+        return home == slot_count() ? pos : home;
       }
 
-      auto displaced = t1_[h1];
-      t1_[h1] = {{current_key, current_value}, true};
-      current_key = displaced.first.first;
-      current_value = displaced.first.second;
-      attempts++;
-
-      size_t h2 = HS2{}(current_key) % capacity_;
-      if (!t2_[h2].second)
+      const size_t victim = next + attempts % BUCKET_SIZE;
+      std::swap(carried, value(victim));
+      std::swap(p.tag, tags_[victim]);
+      if (home == slot_count())
+      {
+        home = victim;
+      }
+      else if (home == victim)
       {
-        t2_[h2] = {{current_key, current_value}, true};
-        size_++;
-        is_inserted = true;
-        break;
+        home = slot_count();
       }
 
-      displaced = t2_[h2];
-      t2_[h2] = {{current_key, current_value}, true};
-      current_key = displaced.first.first;
-      current_value = displaced.first.second;
-      attempts++;
+      const bool in_first = victim < buckets_ * BUCKET_SIZE;
+      p = probe(carried.first);
+      next = in_first ? bucket(1, p.second) : bucket(0, p.first);
     }
 
-    if (!is_inserted)
+    size_t pos = free_slot(stash_begin(), slot_count());
+    if (pos != slot_count())
     {
-      rehash(capacity_ * 2);
-      insert_data(current_key) = current_value;
+      new (slots_[pos].data) val_type(std::move(carried));
+      tags_[pos] = p.tag;
+      ++stashed_;
+      ++size_;
+      return home == slot_count() ? pos : home;
     }
 
-    return find(original_key)->second;
+    const Key key = home == slot_count() ? carried.first : value(home).first;
+    rehash(capacity() * 2);
+    place(std::move(carried));
+    return find_slot(key);
+  }
+  template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
+  size_t HashMap< Key, T, HS1, HS2, EQ >::place(const val_type & val)
+  {
+    return place(val_type(val));
+  }
+  template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
+  void HashMap< Key, T, HS1, HS2, EQ >::destroy(size_t pos) noexcept
+  {
+    value(pos).~val_type();
+    tags_[pos] = 0;
+    --size_;
+    if (pos >= stash_begin())
+    {
+      --stashed_;
+    }
   }
 
   template< typename K, typename T, typename H1, typename H2, typename EQ >
   typename HashMap< K, T, H1, H2, EQ >::FwdIter::reference HashMap< K, T, H1, H2, EQ >::FwdIter::operator*()
   {
-    return first_ ? parent_->t1_[pos_].first : parent_->t2_[pos_].first;
+    return parent_->value(pos_);
   }
   template< typename K, typename T, typename H1, typename H2, typename EQ >
   typename HashMap< K, T, H1, H2, EQ >::FwdIter::pointer HashMap< K, T, H1, H2, EQ >::FwdIter::operator->()
@@ -615,7 +721,7 @@ namespace savintsev
   template< typename K, typename T, typename H1, typename H2, typename EQ >
   typename HashMap< K, T, H1, H2, EQ >::FwdIter::reference HashMap< K, T, H1, H2, EQ >::FwdIter::operator*() const
   {
-    return first_ ? parent_->t1_[pos_].first : parent_->t2_[pos_].first;
+    return parent_->value(pos_);
   }
   template< typename K, typename T, typename H1, typename H2, typename EQ >
   typename HashMap< K, T, H1, H2, EQ >::FwdIter::pointer HashMap< K, T, H1, H2, EQ >::FwdIter::operator->() const
@@ -644,31 +750,12 @@ namespace savintsev
   template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
   bool HashMap< Key, T, HS1, HS2, EQ >::FwdIter::operator==(const FwdIter & rhs) const
   {
-    if (parent_ != rhs.parent_)
-    {
-      return false;
-    }
-    bool c1 = parent_ && pos_ >= parent_->capacity_ && !first_;
-    bool c2 = rhs.parent_ && rhs.pos_ >= rhs.parent_->capacity_ && !rhs.first_;
-    if (c1 && c2)
-    {
-      return true;
-    }
-    return pos_ == rhs.pos_ && first_ == rhs.first_;
+    return parent_ == rhs.parent_ && pos_ == rhs.pos_;
   }
   template< typename K, typename T, typename H1, typename H2, typename EQ >
   void HashMap< K, T, H1, H2, EQ >::FwdIter::skip_empty()
   {
-    while (first_ && (pos_ < parent_->capacity_) && !parent_->t1_[pos_].second)
-    {
-      ++pos_;
-    }
-    if ((pos_ >= parent_->capacity_) && first_)
-    {
-      first_ = false;
-      pos_ = 0;
-    }
-    while (!first_ && (pos_ < parent_->capacity_) && (!parent_->t2_[pos_].second))
+    while (parent_ && pos_ < parent_->slot_count() && !parent_->tags_[pos_])
     {
       ++pos_;
     }
@@ -677,7 +764,7 @@ namespace savintsev
   template< typename K, typename T, typename A, typename B, typename E >
   typename HashMap< K, T, A, B, E >::FwdConstIter::reference HashMap< K, T, A, B, E >::FwdConstIter::operator*() const
   {
-    return first_ ? parent_->t1_[pos_].first : parent_->t2_[pos_].first;
+    return parent_->value(pos_);
   }
   template< typename K, typename T, typename A, typename B, typename E >
   typename HashMap< K, T, A, B, E >::FwdConstIter::pointer HashMap< K, T, A, B, E >::FwdConstIter::operator->() const
@@ -694,7 +781,7 @@ namespace savintsev
   template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
   typename HashMap< Key, T, HS1, HS2, EQ >::FwdConstIter HashMap< Key, T, HS1, HS2, EQ >::FwdConstIter::operator++(int)
   {
-    FwdIter result(*this);
+    FwdConstIter result(*this);
     ++(*this);
     return result;
   }
@@ -706,31 +793,12 @@ namespace savintsev
   template< typename Key, typename T, typename HS1, typename HS2, typename EQ >
   bool HashMap< Key, T, HS1, HS2, EQ >::FwdConstIter::operator==(const FwdConstIter & rhs) const
   {
-    if (parent_ != rhs.parent_)
-    {
-      return false;
-    }
-    bool c1 = parent_ && pos_ >= parent_->capacity_ && !first_;
-    bool c2 = rhs.parent_ && rhs.pos_ >= rhs.parent_->capacity_ && !rhs.first_;
-    if (c1 && c2)
-    {
-      return true;
-    }
-    return pos_ == rhs.pos_ && first_ == rhs.first_;
+    return parent_ == rhs.parent_ && pos_ == rhs.pos_;
   }
   template< typename K, typename T, typename H1, typename H2, typename EQ >
   void HashMap< K, T, H1, H2, EQ >::FwdConstIter::skip_empty()
   {
-    while (first_ && (pos_ < parent_->capacity_) && !parent_->t1_[pos_].second)
-    {
-      ++pos_;
-    }
-    if ((pos_ >= parent_->capacity_) && first_)
-    {
-      first_ = false;
-      pos_ = 0;
-    }
-    while (!first_ && (pos_ < parent_->capacity_) && (!parent_->t2_[pos_].second))
+    while (parent_ && pos_ < parent_->slot_count() && !parent_->tags_[pos_])
     {
       ++pos_;
     }
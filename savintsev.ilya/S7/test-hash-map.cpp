@@ -411,3 +411,129 @@ BOOST_AUTO_TEST_CASE(hm_emplace_insert_test)
   BOOST_TEST(res3.second);
   BOOST_TEST(hm["b"] == 2);
 }
+
+namespace
+{
+  struct ZeroHash
+  {
+    size_t operator()(int) const
+    {
+      return 0;
+    }
+  };
+
+  struct IdentityHash
+  {
+    size_t operator()(int k) const
+    {
+      return static_cast< size_t >(k);
+    }
+  };
+
+  struct ThrowingMove
+  {
+    std::string text;
+
+    ThrowingMove() = default;
+    explicit ThrowingMove(const std::string & s):
+      text(s)
+    {}
+    ThrowingMove(const ThrowingMove &) = default;
+    ThrowingMove(ThrowingMove && rhs) noexcept(false):
+      text(rhs.text)
+    {}
+    ThrowingMove & operator=(const ThrowingMove &) = default;
+    ThrowingMove & operator=(ThrowingMove &&) = default;
+  };
+}
+
+BOOST_AUTO_TEST_CASE(hm_displacement_chain)
+{
+  HashMap< int, int, ZeroHash, IdentityHash > hm(16);
+  hm.max_load_factor(1.0f);
+  for (int i = 0; i < 40; ++i)
+  {
+    hm[i] = i * 10;
+  }
+  BOOST_TEST(hm.size() == 40);
+  for (int i = 0; i < 40; ++i)
+  {
+    BOOST_TEST(hm.at(i) == i * 10);
+  }
+  for (int i = 0; i < 40; i += 2)
+  {
+    BOOST_TEST(hm.erase(i) == 1);
+  }
+  for (int i = 0; i < 40; ++i)
+  {
+    BOOST_TEST((hm.find(i) != hm.end()) == (i % 2 == 1));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(hm_stash_holds_overflow)
+{
+  HashMap< int, std::string, ZeroHash, ZeroHash > hm(64);
+  for (int i = 0; i < 16; ++i)
+  {
+    hm[i] = std::to_string(i);
+  }
+  BOOST_TEST(hm.size() == 16);
+  BOOST_TEST(hm.capacity() == 64);
+  for (int i = 0; i < 16; ++i)
+  {
+    BOOST_TEST(hm.at(i) == std::to_string(i));
+  }
+  for (int i = 12; i < 16; ++i)
+  {
+    BOOST_TEST(hm.erase(i) == 1);
+  }
+  for (int i = 16; i < 20; ++i)
+  {
+    hm[i] = std::to_string(i);
+  }
+  size_t count = 0;
+  for (auto it = hm.begin(); it != hm.end(); ++it)
+  {
+    ++count;
+  }
+  BOOST_TEST(count == 16);
+  for (int i = 0; i < 20; ++i)
+  {
+    BOOST_TEST((hm.find(i) != hm.end()) == (i < 12 || i >= 16));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(hm_growth_by_rehash)
+{
+  HashMap< int, int > hm(2);
+  const size_t initial = hm.capacity();
+  for (int i = 0; i < 1000; ++i)
+  {
+    hm[i] = -i;
+  }
+  BOOST_TEST(hm.capacity() > initial);
+  BOOST_TEST(hm.load_factor() <= hm.max_load_factor());
+  for (int i = 0; i < 1000; ++i)
+  {
+    BOOST_TEST(hm.at(i) == -i);
+  }
+  hm.rehash(4096);
+  BOOST_TEST(hm.capacity() >= 4096);
+  BOOST_TEST(hm.size() == 1000);
+  BOOST_TEST(hm.at(999) == -999);
+}
+
+BOOST_AUTO_TEST_CASE(hm_rehash_copies_throwing_move)
+{
+  HashMap< int, ThrowingMove > hm(2);
+  for (int i = 0; i < 100; ++i)
+  {
+    hm[i] = ThrowingMove(std::to_string(i));
+  }
+  hm.rehash(512);
+  BOOST_TEST(hm.size() == 100);
+  for (int i = 0; i < 100; ++i)
+  {
+    BOOST_TEST(hm.at(i).text == std::to_string(i));
+  }
+}